@@ -0,0 +1,565 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <poll.h>
+
+#include <sqlpp17/connection.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/reactor.h>
+#include <sqlpp17/result.h>
+#include <sqlpp17/statement.h>
+
+#include <sqlpp17/mysql/mysql.h>
+#include <sqlpp17/mysql/connection.h>
+#include <sqlpp17/mysql/context.h>
+#include <sqlpp17/mysql/direct_execution_result.h>
+#include <sqlpp17/mysql/execution_limits.h>
+
+#if defined(MARIADB_BASE_VERSION) or (defined(LIBMYSQL_VERSION_ID) and LIBMYSQL_VERSION_ID < 80016)
+#error "Asynchronous MySQL connections require the *_nonblocking functions of libmysqlclient 8.0.16 or later"
+#endif
+
+namespace sqlpp::mysql::detail
+{
+  // The client library does not tell whether a call that is not ready waits for reading or for writing.
+  // Without mysql_get_socket_descriptor (detected by CMake), the socket is read from the MYSQL struct, which is not
+  // part of the public API. This is unsupported for client libraries that change the layout of MYSQL::net.
+  inline auto socket_of(MYSQL* mysql) -> int
+  {
+#ifdef SQLPP17_MYSQL_HAS_GET_SOCKET_DESCRIPTOR
+    return static_cast<int>(mysql_get_socket_descriptor(mysql));
+#else
+    return mysql->net.fd;
+#endif
+  }
+
+  inline auto is_writable(int socket) -> bool
+  {
+    auto descriptor = ::pollfd{socket, POLLOUT, 0};
+    return ::poll(&descriptor, 1, 0) == 1 and (descriptor.revents & POLLOUT);
+  }
+
+  // Errors after which the connection cannot be used anymore
+  inline auto is_connection_error(unsigned int error) -> bool
+  {
+    switch (error)
+    {
+      case 2006:  // CR_SERVER_GONE_ERROR
+      case 2013:  // CR_SERVER_LOST
+      case 2055:  // CR_SERVER_LOST_EXTENDED
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  class async_query
+  {
+    std::string _sql_string;
+
+  public:
+    async_query(std::string sql_string) : _sql_string{std::move(sql_string)}
+    {
+    }
+    async_query(const async_query&) = delete;
+    async_query& operator=(const async_query&) = delete;
+    virtual ~async_query() = default;
+
+    auto& sql_string() const
+    {
+      return _sql_string;
+    }
+
+    // Called once the query has been executed, with its stored result set, if it has one
+    virtual auto complete(MYSQL* mysql, unique_result_ptr result) -> void = 0;
+    virtual auto fail(std::exception_ptr error) -> void = 0;
+  };
+
+  // What connection_t::operator() returns for statements of the given type
+  template <typename ResultType, typename ResultRow>
+  auto async_value_of(MYSQL* mysql, unique_result_ptr result)
+  {
+    if constexpr (std::is_same_v<ResultType, insert_result>)
+    {
+      return mysql_insert_id(mysql);
+    }
+    else if constexpr (std::is_same_v<ResultType, delete_result> or std::is_same_v<ResultType, update_result>)
+    {
+      return mysql_affected_rows(mysql);
+    }
+    else if constexpr (std::is_same_v<ResultType, select_result>)
+    {
+      return ::sqlpp::result_t<direct_execution_result_t<ResultRow>>{
+          direct_execution_result_t<ResultRow>{std::move(result)}};
+    }
+    else if constexpr (std::is_same_v<ResultType, execute_result>)
+    {
+      return;
+    }
+    else
+    {
+      static_assert(wrong<ResultType>, "Unknown statement result type");
+    }
+  }
+
+  template <typename ResultType, typename ResultRow>
+  using async_value_t = decltype(async_value_of<ResultType, ResultRow>(nullptr, unique_result_ptr{}));
+
+  template <typename ResultType, typename ResultRow, typename Handler>
+  class typed_async_query : public async_query
+  {
+    using _value_type = async_value_t<ResultType, ResultRow>;
+    Handler _handler;
+
+  public:
+    typed_async_query(std::string sql_string, Handler handler)
+        : async_query{std::move(sql_string)}, _handler{std::move(handler)}
+    {
+    }
+
+    auto complete(MYSQL* mysql, unique_result_ptr result) -> void override
+    {
+      if constexpr (std::is_void_v<_value_type>)
+      {
+        _handler(std::exception_ptr{});
+      }
+      else
+      {
+        _handler(std::exception_ptr{}, async_value_of<ResultType, ResultRow>(mysql, std::move(result)));
+      }
+    }
+
+    auto fail(std::exception_ptr error) -> void override
+    {
+      if constexpr (std::is_void_v<_value_type>)
+      {
+        _handler(std::move(error));
+      }
+      else
+      {
+        _handler(std::move(error), _value_type{});
+      }
+    }
+  };
+
+  // Owned by the reactor thread: All member functions except the constructor must be called on that thread.
+  template <::sqlpp::debug Debug>
+  class async_connection_state : public ::sqlpp::reactor_watcher, private ::sqlpp::debug_base<Debug>
+  {
+    using _debug_base = ::sqlpp::debug_base<Debug>;
+
+    enum class state
+    {
+      connecting,
+      idle,
+      querying,
+      storing,
+      broken,
+      closed,
+    };
+
+    ::sqlpp::reactor_t& _reactor;
+    connection_config_t _config;
+    unique_connection_ptr _handle;
+    int _socket = -1;
+    std::uint32_t _events = 0;
+    state _state = state::connecting;
+
+    std::deque<std::shared_ptr<async_query>> _queue;
+    std::shared_ptr<async_query> _current;
+
+    auto debug(const std::string& message) const -> void
+    {
+      if constexpr (Debug == ::sqlpp::debug::allowed)
+      {
+        if (this->_debug)
+          this->_debug(message);
+      }
+    }
+
+    auto interest(std::uint32_t events) -> void
+    {
+      if (const auto socket = socket_of(_handle.get()); socket != _socket)
+      {
+        if (_socket >= 0)
+          _reactor.unwatch(_socket);
+        _socket = socket;
+        _events = events;
+        _reactor.watch(_socket, _events, *this);
+        return;
+      }
+      if (events != _events)
+      {
+        _events = events;
+        _reactor.modify(_socket, _events);
+      }
+    }
+
+    // Idle connections are not watched: Unlike libpq, the client library has nothing to read while idle.
+    auto unwatch() -> void
+    {
+      if (_socket >= 0)
+      {
+        _reactor.unwatch(_socket);
+        _socket = -1;
+      }
+    }
+
+    // Calls the current step until it is done or has to wait for the socket
+    auto advance() -> void
+    {
+      auto retried = false;
+      while (true)
+      {
+        const auto status = step();
+        if (status != NET_ASYNC_NOT_READY)
+        {
+          if (_state == state::idle and not _queue.empty())
+          {
+            start_next();
+            retried = false;
+            continue;
+          }
+          if (_state == state::idle)
+            unwatch();
+          if (_state == state::idle or _state == state::broken or _state == state::closed)
+            return;
+          retried = false;
+          continue;
+        }
+
+        // A call that is not ready could not write or could not read. If the socket is writable, try once more:
+        // If the call had been waiting for writing, it makes progress now, otherwise it is waiting for reading.
+        if (not is_writable(socket_of(_handle.get())))
+        {
+          interest(::sqlpp::reactor_t::readable | ::sqlpp::reactor_t::writable);
+          return;
+        }
+        if (retried)
+        {
+          interest(::sqlpp::reactor_t::readable);
+          return;
+        }
+        retried = true;
+      }
+    }
+
+    auto step() -> net_async_status
+    {
+      auto* const mysql = _handle.get();
+      switch (_state)
+      {
+        case state::connecting:
+        {
+          const auto& config = _config;
+          const auto status = mysql_real_connect_nonblocking(
+              mysql, config.host.empty() ? nullptr : config.host.c_str(),
+              config.user.empty() ? nullptr : config.user.c_str(),
+              config.password.empty() ? nullptr : config.password.c_str(),
+              config.database.empty() ? nullptr : config.database.c_str(), config.port,
+              config.unix_socket.empty() ? nullptr : config.unix_socket.c_str(), config.client_flag);
+          if (status == NET_ASYNC_ERROR)
+          {
+            break_connection("MySQL: could not connect to server: " + std::string(mysql_error(mysql)));
+          }
+          else if (status == NET_ASYNC_COMPLETE)
+          {
+            if (_config.post_connect)
+              _config.post_connect(mysql);
+            debug("Connected asynchronously");
+            _state = state::idle;
+          }
+          return status;
+        }
+        case state::querying:
+        {
+          const auto& query = _current->sql_string();
+          const auto status = mysql_real_query_nonblocking(mysql, query.c_str(), query.size());
+          if (status == NET_ASYNC_ERROR)
+          {
+            fail_current("MySQL: Could not execute query: " + std::string(mysql_error(mysql)) + " (query was >>" +
+                         query + "<<)");
+          }
+          else if (status == NET_ASYNC_COMPLETE)
+          {
+            if (mysql_field_count(mysql))
+            {
+              _state = state::storing;
+            }
+            else
+            {
+              complete_current(nullptr);
+            }
+          }
+          return status;
+        }
+        case state::storing:
+        {
+          MYSQL_RES* result = nullptr;
+          const auto status = mysql_store_result_nonblocking(mysql, &result);
+          if (status == NET_ASYNC_ERROR or (status == NET_ASYNC_COMPLETE and not result))
+          {
+            fail_current("MySQL: Could not store result set: " + std::string(mysql_error(mysql)));
+            return NET_ASYNC_ERROR;
+          }
+          if (status == NET_ASYNC_COMPLETE)
+          {
+            complete_current(result);
+          }
+          return status;
+        }
+        default:
+          return NET_ASYNC_COMPLETE;
+      }
+    }
+
+    auto start_next() -> void
+    {
+      _current = std::move(_queue.front());
+      _queue.pop_front();
+      debug("Sending: '" + _current->sql_string() + "'");
+      _state = state::querying;
+    }
+
+    auto complete_current(MYSQL_RES* result) -> void
+    {
+      auto query = std::move(_current);
+      _state = state::idle;
+      query->complete(_handle.get(), unique_result_ptr(result, {}));
+    }
+
+    auto fail_current(const std::string& message) -> void
+    {
+      const auto error = mysql_errno(_handle.get());
+      auto query = std::move(_current);
+      _state = state::idle;
+      query->fail(std::make_exception_ptr(::sqlpp::exception(message, error_code_of(error))));
+      if (is_connection_error(error))
+      {
+        break_connection(message);
+      }
+    }
+
+    auto fail_all(const std::string& message) -> void
+    {
+      const auto error = std::make_exception_ptr(::sqlpp::exception(message));
+      if (_current)
+      {
+        std::exchange(_current, nullptr)->fail(error);
+      }
+      while (not _queue.empty())
+      {
+        auto query = std::move(_queue.front());
+        _queue.pop_front();
+        query->fail(error);
+      }
+    }
+
+    auto break_connection(const std::string& message) -> void
+    {
+      debug(message);
+      _state = state::broken;
+      unwatch();
+      fail_all(message);
+    }
+
+  public:
+    async_connection_state(::sqlpp::reactor_t& reactor, const connection_config_t& config)
+        : _debug_base{config.debug}, _reactor{reactor}, _config{config}, _handle(mysql_init(nullptr))
+    {
+      if (not _handle)
+      {
+        throw ::sqlpp::exception("MySQL: could not init mysql data structure");
+      }
+
+      if (config.pre_connect)
+      {
+        config.pre_connect(_handle.get());
+      }
+
+      if (config.ssl)
+      {
+        const auto& ssl = config.ssl.value();
+        mysql_ssl_set(_handle.get(), ssl.key.c_str(), ssl.cert.c_str(), ssl.ca.empty() ? nullptr : ssl.ca.c_str(),
+                      ssl.caPath.empty() ? nullptr : ssl.caPath.c_str(),
+                      ssl.cipher.empty() ? nullptr : ssl.cipher.c_str());
+      }
+
+      // mysql_set_character_set and mysql_select_db would block, the connect call takes care of both
+      mysql_options(_handle.get(), MYSQL_SET_CHARSET_NAME, config.charset.c_str());
+    }
+
+    auto start() -> void
+    {
+      detail::thread_init();
+      advance();
+    }
+
+    auto on_ready(std::uint32_t) -> void override
+    {
+      // Exceptions must not escape into the reactor, e.g. watching the socket fails if it has been closed
+      try
+      {
+        advance();
+      }
+      catch (const std::exception& e)
+      {
+        break_connection(std::string("MySQL: ") + e.what());
+      }
+    }
+
+    auto enqueue(std::shared_ptr<async_query> query) -> void
+    {
+      switch (_state)
+      {
+        case state::broken:
+          query->fail(std::make_exception_ptr(::sqlpp::exception("MySQL: connection is broken")));
+          return;
+        case state::closed:
+          query->fail(std::make_exception_ptr(::sqlpp::exception("MySQL: connection is closed")));
+          return;
+        case state::idle:
+          _queue.push_back(std::move(query));
+          advance();
+          return;
+        default:
+          _queue.push_back(std::move(query));
+      }
+    }
+
+    auto close() -> void
+    {
+      unwatch();
+      _state = state::closed;
+      fail_all("MySQL: connection closed before the query completed");
+      _handle.reset();
+    }
+  };
+}  // namespace sqlpp::mysql::detail
+
+namespace sqlpp::mysql
+{
+  // A connection driven by a reactor_t, using the non-blocking functions of libmysqlclient (8.0.16+). A single
+  // thread running the reactor can serve many connections. Each connection executes its statements one after the
+  // other, in the order they were submitted.
+  //
+  // Statements can be submitted from any thread. Handlers are called on the reactor's thread as
+  // handler(std::exception_ptr error, Value value), where Value is what connection_t::operator() would return for
+  // the statement (default constructed if there is an error). For statements returning nothing, handlers are called
+  // as handler(std::exception_ptr error). Handlers must not throw.
+  // The futures returned by the overload without handler must not be waited for on the reactor's thread.
+  //
+  // The reactor must outlive the connection. Destroying the connection fails its outstanding statements.
+  // The client library has no non-blocking prepared statement calls, so there are no asynchronous prepared
+  // statements. Execution limits and instrumentation are not supported (yet).
+  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed>
+  class async_connection_t
+  {
+    using _state_t = detail::async_connection_state<Debug>;
+
+    ::sqlpp::reactor_t* _reactor;
+    std::shared_ptr<_state_t> _state;
+
+  public:
+    async_connection_t(::sqlpp::reactor_t& reactor, const connection_config_t& config)
+        : _reactor{&reactor}, _state{std::make_shared<_state_t>(reactor, config)}
+    {
+      _reactor->post([state = _state] { state->start(); });
+    }
+    async_connection_t(const async_connection_t&) = delete;
+    async_connection_t(async_connection_t&&) = default;
+    async_connection_t& operator=(const async_connection_t&) = delete;
+    async_connection_t& operator=(async_connection_t&&) = delete;
+    ~async_connection_t()
+    {
+      if (_state)
+      {
+        _reactor->post([state = std::move(_state)] { state->close(); });
+      }
+    }
+
+    template <typename... Clauses, typename Handler>
+    auto operator()(const ::sqlpp::statement<Clauses...>& statement, Handler handler)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_executable<connection_t<Debug>>(type_v<Statement>); _check)
+      {
+        using _query_t = detail::typed_async_query<result_type_of_t<Statement>, result_row_of_t<Statement>, Handler>;
+        auto query = std::make_shared<_query_t>(to_sql_string_c(context_t{}, statement), std::move(handler));
+        _reactor->post([state = _state, query = std::move(query)]() mutable { state->enqueue(std::move(query)); });
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+
+    template <typename... Clauses>
+    auto operator()(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_executable<connection_t<Debug>>(type_v<Statement>); _check)
+      {
+        using _value_type = detail::async_value_t<result_type_of_t<Statement>, result_row_of_t<Statement>>;
+        auto promise = std::make_shared<std::promise<_value_type>>();
+        auto future = promise->get_future();
+        if constexpr (std::is_void_v<_value_type>)
+        {
+          (*this)(statement, [promise](std::exception_ptr error) {
+            if (error)
+              promise->set_exception(std::move(error));
+            else
+              promise->set_value();
+          });
+        }
+        else
+        {
+          (*this)(statement, [promise](std::exception_ptr error, _value_type value) {
+            if (error)
+              promise->set_exception(std::move(error));
+            else
+              promise->set_value(std::move(value));
+          });
+        }
+        return future;
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+  };
+}  // namespace sqlpp::mysql
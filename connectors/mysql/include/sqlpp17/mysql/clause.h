@@ -26,6 +26,9 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <sqlpp17/mysql/clause/bulk_update.h>
 #include <sqlpp17/mysql/clause/create_table.h>
 #include <sqlpp17/mysql/clause/insert_values.h>
+#include <sqlpp17/mysql/clause/on_conflict.h>
+#include <sqlpp17/mysql/clause/returning.h>
 
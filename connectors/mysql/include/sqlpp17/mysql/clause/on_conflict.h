@@ -0,0 +1,62 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+
+#include <sqlpp17/clause/on_conflict.h>
+#include <sqlpp17/excluded.h>
+#include <sqlpp17/wrong.h>
+
+#include <sqlpp17/mysql/context.h>
+
+namespace sqlpp
+{
+  template <typename Target, typename Statement>
+  [[nodiscard]] auto to_sql_string(mysql::context_t& context,
+                                   const clause_base<on_conflict_do_nothing_t<Target>, Statement>& t) -> std::string
+  {
+    static_assert(wrong<Statement>, "MySQL does not support ON CONFLICT, use on_duplicate_key_update() instead");
+    return {};
+  }
+
+  template <typename Target, typename... Assignments, typename Statement>
+  [[nodiscard]] auto to_sql_string(mysql::context_t& context,
+                                   const clause_base<on_conflict_do_update_t<Target, Assignments...>, Statement>& t)
+      -> std::string
+  {
+    static_assert(wrong<Statement>, "MySQL does not support ON CONFLICT, use on_duplicate_key_update() instead");
+    return {};
+  }
+
+  // VALUES(col) is deprecated since MySQL 8.0.20 in favor of row aliases, but works with all versions
+  template <typename Column>
+  [[nodiscard]] auto to_sql_string(mysql::context_t& context, const excluded_t<Column>&) -> std::string
+  {
+    return "VALUES(" + to_sql_string(context, free_column_t<Column>{}) + ")";
+  }
+}  // namespace sqlpp
@@ -27,27 +27,34 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <functional>
+#include <memory>
 #include <type_traits>
 
+#include <sqlpp17/cancellation.h>
 #include <sqlpp17/connection.h>
+#include <sqlpp17/literal_parameters.h>
 #include <sqlpp17/result.h>
 #include <sqlpp17/statement.h>
+#include <sqlpp17/transaction.h>
 
 #include <sqlpp17/mysql/mysql.h>
 #include <sqlpp17/mysql/clause.h>
 #include <sqlpp17/mysql/connection_config.h>
 #include <sqlpp17/mysql/context.h>
 #include <sqlpp17/mysql/direct_execution_result.h>
+#include <sqlpp17/mysql/execution_limits.h>
+#include <sqlpp17/mysql/explain.h>
 #include <sqlpp17/mysql/prepared_statement.h>
 #include <sqlpp17/mysql/prepared_statement_result.h>
+#include <sqlpp17/mysql/to_sql_string.h>
 
 namespace sqlpp::mysql
 {
-  template <typename Pool, ::sqlpp::debug Debug>
+  template <typename Pool, ::sqlpp::debug Debug, typename Instrumentation = ::sqlpp::no_instrumentation>
   class base_connection;
 
-  template<::sqlpp::debug Debug = ::sqlpp::debug::allowed>
-  using connection_t = base_connection<no_pool, Debug>;
+  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed, typename Instrumentation = ::sqlpp::no_instrumentation>
+  using connection_t = base_connection<no_pool, Debug, Instrumentation>;
 
 };  // namespace sqlpp::mysql
 
@@ -63,18 +70,90 @@ namespace sqlpp::mysql::detail
   };
   using unique_connection_ptr = std::unique_ptr<MYSQL, detail::connection_cleanup_t>;
 
-  template <typename Pool, ::sqlpp::debug Debug>
-  inline auto execute_query(const base_connection<Pool, Debug>& connection, const std::string& query) -> void
+  inline auto isolation_level_of(::sqlpp::isolation_level isolation) -> std::string
+  {
+    switch (isolation)
+    {
+      case ::sqlpp::isolation_level::serializable:
+        return "SERIALIZABLE";
+      case ::sqlpp::isolation_level::repeatable_read:
+        return "REPEATABLE READ";
+      case ::sqlpp::isolation_level::read_committed:
+        return "READ COMMITTED";
+      case ::sqlpp::isolation_level::read_uncommitted:
+        return "READ UNCOMMITTED";
+      default:
+        return {};
+    }
+  }
+
+  inline auto begin_statement_of(const ::sqlpp::transaction_options& options) -> std::string
+  {
+    if (options.access == ::sqlpp::access_mode::read_only)
+    {
+      // Repeatable reads see the snapshot taken by the first read. Taking it right away is not more expensive.
+      return options.isolation == ::sqlpp::isolation_level::repeatable_read
+                 ? "START TRANSACTION READ ONLY, WITH CONSISTENT SNAPSHOT"
+                 : "START TRANSACTION READ ONLY";
+    }
+    return "START TRANSACTION";
+  }
+
+  template <typename Pool, ::sqlpp::debug Debug, typename Instrumentation>
+  inline auto execute_query(const base_connection<Pool, Debug, Instrumentation>& connection,
+                            const std::string& query,
+                            ::sqlpp::execution_limits* limits,
+                            [[maybe_unused]] std::uint32_t statement_hash,
+                            [[maybe_unused]] ::sqlpp::instrumentation_clock::time_point serialization_start)
+      -> limits_guard
   {
     detail::thread_init();
 
-    if constexpr (base_connection<Pool, Debug>::is_debug_allowed())
+    if (connection.is_debug_active())
       connection.debug("Executing: '" + query + "'");
 
+    if constexpr (::sqlpp::instrumentation_base<Instrumentation>::is_instrumented())
+    {
+      const auto now = ::sqlpp::instrumentation_clock::now();
+      connection.instrument(::sqlpp::execute_start_event{statement_hash, query, now - serialization_start, now});
+    }
+
+    // The guard has to outlive storing the result, if there is one
+    auto guard = limits_guard{limits, connection.query_killer()};
     if (mysql_real_query(connection.get(), query.c_str(), query.size()))
     {
-      throw sqlpp::exception("MySQL: Could not execute query: " + std::string(mysql_error(connection.get())) +
-                             " (query was >>" + query + "<<\n");
+      if constexpr (::sqlpp::instrumentation_base<Instrumentation>::is_instrumented())
+        connection.instrument(::sqlpp::error_event{statement_hash, mysql_error(connection.get()),
+                                                   ::sqlpp::instrumentation_clock::now()});
+      guard.throw_error(mysql_errno(connection.get()), "MySQL: Could not execute query: " +
+                                                           std::string(mysql_error(connection.get())) +
+                                                           " (query was >>" + query + "<<\n");
+    }
+
+    if constexpr (::sqlpp::instrumentation_base<Instrumentation>::is_instrumented())
+    {
+      // Rows of a result set are only known after storing or fetching them
+      const auto rows = mysql_field_count(connection.get())
+                            ? std::nullopt
+                            : std::optional<std::size_t>{mysql_affected_rows(connection.get())};
+      connection.instrument(::sqlpp::execute_end_event{statement_hash, rows, ::sqlpp::instrumentation_clock::now()});
+    }
+
+    return guard;
+  }
+
+  template <typename Pool, ::sqlpp::debug Debug, typename Instrumentation>
+  inline auto execute_query(const base_connection<Pool, Debug, Instrumentation>& connection,
+                            const std::string& query,
+                            ::sqlpp::execution_limits* limits) -> void
+  {
+    if constexpr (::sqlpp::instrumentation_base<Instrumentation>::is_instrumented())
+    {
+      execute_query(connection, query, limits, djb2_hash(query), ::sqlpp::instrumentation_clock::now());
+    }
+    else
+    {
+      execute_query(connection, query, limits, 0, {});
     }
   }
 
@@ -87,16 +166,22 @@ namespace sqlpp::mysql
     static const auto global_init_and_end = detail::scoped_library_initializer_t(argc, argv, groups);
   }
 
-  template<typename Pool, ::sqlpp::debug Debug>
+  template<typename Pool, ::sqlpp::debug Debug, typename Instrumentation>
   class base_connection : public ::sqlpp::connection,
                           private ::sqlpp::pool_base<Pool>,
-                          private ::sqlpp::debug_base<Debug>
+                          private ::sqlpp::debug_base<Debug>,
+                          private ::sqlpp::instrumentation_base<Instrumentation>,
+                          private ::sqlpp::execution_limits_base
   {
     using _pool_base = ::sqlpp::pool_base<Pool>;
     using _debug_base = ::sqlpp::debug_base<Debug>;
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
 
     detail::unique_connection_ptr _handle;
-    bool _transaction_active = false;
+    std::shared_ptr<const detail::kill_query_t> _query_killer;
+    // Directly executed statements with parameterized literals, see connection_config_t::parameterize_literals
+    std::shared_ptr<detail::statement_cache> _statement_cache;
+    std::size_t _transaction_depth = 0;
 
     template <typename... Clauses>
     friend class ::sqlpp::statement;
@@ -108,19 +193,34 @@ namespace sqlpp::mysql
 
     base_connection(const connection_config_t& config,
                  detail::unique_connection_ptr&& handle,
-                 Pool* connection_pool)
-        : _pool_base{connection_pool}, _debug_base{config.debug}, _handle{std::move(handle)}
+                 Pool* connection_pool,
+                 Instrumentation instrumentation)
+        : _pool_base{connection_pool},
+          _debug_base{config.debug},
+          _instrumentation_base{std::move(instrumentation)},
+          _handle{std::move(handle)},
+          _query_killer{std::make_shared<const detail::kill_query_t>(
+              detail::kill_query_t{config, mysql_thread_id(_handle.get())})},
+          _statement_cache{make_statement_cache(config)}
     {
+      this->attach_connection(_handle.get());
     }
 
-    base_connection(const connection_config_t& config, Pool* connection_pool) : base_connection{config}
+    base_connection(const connection_config_t& config, Pool* connection_pool, Instrumentation instrumentation)
+        : base_connection{config, std::move(instrumentation)}
     {
       this->_connection_pool = connection_pool;
     }
 
   public:
+    using instrumentation_type = Instrumentation;
+
     base_connection() = delete;
-    base_connection(const connection_config_t& config) : _debug_base{config.debug}, _handle(mysql_init(nullptr))
+    base_connection(const connection_config_t& config, Instrumentation instrumentation = {})
+        : _debug_base{config.debug},
+          _instrumentation_base{std::move(instrumentation)},
+          _handle(mysql_init(nullptr)),
+          _statement_cache{make_statement_cache(config)}
     {
       if (not _handle)
       {
@@ -162,6 +262,10 @@ namespace sqlpp::mysql
       {
         config.post_connect(_handle.get());
       }
+
+      _query_killer = std::make_shared<const detail::kill_query_t>(
+          detail::kill_query_t{config, mysql_thread_id(_handle.get())});
+      this->attach_connection(_handle.get());
     }
 
     base_connection(const base_connection&) = delete;
@@ -173,7 +277,11 @@ namespace sqlpp::mysql
       if constexpr (not std::is_same_v<Pool, no_pool>)
       {
         if (this->_connection_pool)
+        {
+          // Cached statements belong to this connection object, not to the pooled handle
+          _statement_cache.reset();
           this->_connection_pool->put(std::move(_handle));
+        }
       }
     }
 
@@ -229,37 +337,82 @@ namespace sqlpp::mysql
       }
     }
 
-    auto start_transaction() -> void
+    // See ::sqlpp::explain. Note that explain_mode::analyze executes the statement (MySQL 8.0.18+).
+    template <typename... Clauses>
+    auto explain(const ::sqlpp::statement<Clauses...>& statement, ::sqlpp::explain_mode mode)
     {
-      if (_transaction_active)
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_preparable<base_connection>(type_v<Statement>); _check)
       {
-        throw sqlpp::exception("MySQL: Cannot have more than one open transaction per connection");
+        return detail::explain(get(), to_sql_string_c(context_t{}, statement), mode);
       }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
 
-      detail::execute_query(*this, "START TRANSACTION");
-      _transaction_active = true;
+    // Transactions started while another one is open use savepoints, see ::sqlpp::transaction_t
+    auto start_transaction(const ::sqlpp::transaction_options& options = {}) -> void
+    {
+      if (_transaction_depth == 0)
+      {
+        // SET TRANSACTION applies to the next transaction only
+        if (const auto isolation = detail::isolation_level_of(options.isolation); not isolation.empty())
+        {
+          detail::execute_query(*this, "SET TRANSACTION ISOLATION LEVEL " + isolation, limits());
+        }
+        detail::execute_query(*this, detail::begin_statement_of(options), limits());
+      }
+      else
+      {
+        detail::execute_query(*this, "SAVEPOINT " + ::sqlpp::detail::savepoint_name(_transaction_depth), limits());
+      }
+      ++_transaction_depth;
     }
 
     auto commit() -> void
     {
-      if (not _transaction_active)
+      if (_transaction_depth == 0)
       {
         throw sqlpp::exception("MySQL: Cannot commit without active transaction");
       }
 
-      _transaction_active = false;
-      detail::execute_query(*this, "COMMIT");
+      // The depth only changes once the control statement succeeded, so that a failed commit can still be rolled back
+      if (_transaction_depth > 1)
+      {
+        detail::execute_query(*this, "RELEASE SAVEPOINT " + ::sqlpp::detail::savepoint_name(_transaction_depth - 1),
+                              limits());
+        --_transaction_depth;
+        return;
+      }
+      detail::execute_query(*this, "COMMIT", limits());
+      _transaction_depth = 0;
     }
 
     auto rollback() -> void
     {
-      if (not _transaction_active)
+      if (_transaction_depth == 0)
       {
         throw sqlpp::exception("MySQL: Cannot rollback without active transaction");
       }
 
-      _transaction_active = false;
-      detail::execute_query(*this, "ROLLBACK");
+      // Rolling back must work even after the deadline passed
+      if (_transaction_depth > 1)
+      {
+        const auto name = ::sqlpp::detail::savepoint_name(_transaction_depth - 1);
+        detail::execute_query(*this, "ROLLBACK TO SAVEPOINT " + name, nullptr);
+        detail::execute_query(*this, "RELEASE SAVEPOINT " + name, nullptr);
+        --_transaction_depth;
+        return;
+      }
+      detail::execute_query(*this, "ROLLBACK", nullptr);
+      _transaction_depth = 0;
+    }
+
+    [[nodiscard]] auto transaction_depth() const -> std::size_t
+    {
+      return _transaction_depth;
     }
 
     auto destroy_transaction() noexcept -> void
@@ -292,6 +445,36 @@ namespace sqlpp::mysql
       }
     }
 
+    // Use this to avoid formatting debug messages that nobody is going to see
+    auto is_debug_active() const -> bool
+    {
+      if constexpr (is_debug_allowed())
+      {
+        return static_cast<bool>(this->_debug);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    using _instrumentation_base::instrument;
+    using _instrumentation_base::instrumentation;
+    using _instrumentation_base::is_instrumented;
+
+    using execution_limits_base::clear_cancellation_token;
+    using execution_limits_base::clear_deadline;
+    using execution_limits_base::clear_statement_timeout;
+    using execution_limits_base::limits;
+    using execution_limits_base::set_cancellation_token;
+    using execution_limits_base::set_deadline;
+    using execution_limits_base::set_statement_timeout;
+
+    // Interrupts the running statement from other threads, see execution_limits
+    auto query_killer() const -> const std::shared_ptr<const detail::kill_query_t>&
+    {
+      return _query_killer;
+    }
 
     auto get() const -> MYSQL*
     {
@@ -303,16 +486,85 @@ namespace sqlpp::mysql
       return mysql_ping(_handle.get()) == 0;
     }
 
+    // Prepared statements have at most 65535 placeholders
+    [[nodiscard]] auto max_statement_parameters() const -> std::size_t
+    {
+      return 65535;
+    }
+
   private:
+    static auto make_statement_cache(const connection_config_t& config) -> std::shared_ptr<detail::statement_cache>
+    {
+      return config.parameterize_literals ? std::make_shared<detail::statement_cache>(config.statement_cache_size)
+                                          : nullptr;
+    }
+
+    // Prepares statements with parameterized literals as server-side statements, reusing cached ones
+    template <typename Statement>
+    auto prepare_parameterized(const Statement& statement)
+    {
+      using _prepared_statement_t = prepared_statement_t<result_type_of_t<Statement>, parameters_of_t<Statement>,
+                                                         result_row_of_t<Statement>, Instrumentation>;
+      [[maybe_unused]] const auto serialization_start =
+          ::sqlpp::instrumentation_now<_instrumentation_base::is_instrumented()>();
+      auto parameterized = ::sqlpp::parameterize<context_t>(statement);
+      auto prepared_statement = [&]() {
+        if (auto* handle = _statement_cache->take(parameterized.sql))
+        {
+          return _prepared_statement_t{*this, detail::unique_prepared_statement_ptr{handle, {_statement_cache}},
+                                       type_hash<Statement>()};
+        }
+        auto prepared = _prepared_statement_t{*this, parameterized.sql, type_hash<Statement>(), serialization_start};
+        prepared.cache_in(_statement_cache, parameterized.sql);
+        return prepared;
+      }();
+      prepared_statement.bind_literals(std::move(parameterized.literals));
+      return prepared_statement;
+    }
+
+    template <typename... Clauses>
+    auto execute(const ::sqlpp::statement<Clauses...>& statement) -> void
+    {
+      execute_limited(statement);
+    }
+
     template <typename... Clauses>
-    auto execute(const ::sqlpp::statement<Clauses...>& statement)
+    [[nodiscard]] auto execute_limited(const ::sqlpp::statement<Clauses...>& statement) -> detail::limits_guard
     {
-      return detail::execute_query(*this, to_sql_string_c(context_t{}, statement));
+      if constexpr (is_instrumented())
+      {
+        const auto serialization_start = ::sqlpp::instrumentation_clock::now();
+        return detail::execute_query(*this, to_sql_string_c(context_t{}, statement), limits(),
+                                     type_hash<::sqlpp::statement<Clauses...>>(), serialization_start);
+      }
+      else
+      {
+        return detail::execute_query(*this, to_sql_string_c(context_t{}, statement), limits(), 0, {});
+      }
+    }
+
+    template <typename Statement>
+    static constexpr auto _hash_of() -> std::uint32_t
+    {
+      if constexpr (is_instrumented())
+      {
+        return type_hash<Statement>();
+      }
+      else
+      {
+        return 0;
+      }
     }
 
     template <typename Statement>
     auto insert(const Statement& statement)
     {
+      if (_statement_cache)
+      {
+        auto prepared_statement = prepare_parameterized(statement);
+        return prepared_statement.execute();
+      }
+
       this->execute(statement);
 
       return mysql_insert_id(this->get());
@@ -321,6 +573,12 @@ namespace sqlpp::mysql
     template <typename Statement>
     auto update(const Statement& statement)
     {
+      if (_statement_cache)
+      {
+        auto prepared_statement = prepare_parameterized(statement);
+        return prepared_statement.execute();
+      }
+
       this->execute(statement);
       return mysql_affected_rows(this->get());
     }
@@ -328,6 +586,12 @@ namespace sqlpp::mysql
     template <typename Statement>
     auto delete_from(const Statement& statement)
     {
+      if (_statement_cache)
+      {
+        auto prepared_statement = prepare_parameterized(statement);
+        return prepared_statement.execute();
+      }
+
       this->execute(statement);
       return mysql_affected_rows(this->get());
     }
@@ -335,15 +599,18 @@ namespace sqlpp::mysql
     template <typename Statement>
     [[nodiscard]] auto select(const Statement& statement)
     {
-      this->execute(statement);
+      const auto guard = this->execute_limited(statement);
       auto result_handle = detail::unique_result_ptr(mysql_store_result(this->get()), {});
       if (!result_handle)
       {
-        throw sqlpp::exception("MySQL: Could not store result set: " + std::string(mysql_error(this->get())));
+        guard.throw_error(mysql_errno(this->get()),
+                          "MySQL: Could not store result set: " + std::string(mysql_error(this->get())));
       }
 
       using _result_type = direct_execution_result_t<result_row_of_t<Statement>>;
-      return ::sqlpp::result_t<_result_type>{_result_type{std::move(result_handle)}};
+      auto handle = ::sqlpp::make_result_handle<Instrumentation>(_result_type{std::move(result_handle)}, *this,
+                                                                  _hash_of<Statement>());
+      return ::sqlpp::result_t<decltype(handle)>{std::move(handle)};
     }
 
   };
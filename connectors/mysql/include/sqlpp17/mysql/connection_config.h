@@ -56,6 +56,12 @@ namespace sqlpp::mysql
     std::string charset = "utf8";
     std::function<void(std::string_view)> debug;
 
+    // Inserts, updates and deletes bind their literal values as parameters of server-side prepared statements,
+    // reusing statements with the same SQL text, see ::sqlpp::parameterize. Selects keep using the text protocol.
+    // Up to statement_cache_size statements are kept per connection.
+    bool parameterize_literals = false;
+    std::size_t statement_cache_size = 64;
+
     connection_config_t() = default;
     connection_config_t(const connection_config_t&) = default;
     connection_config_t(connection_config_t&& rhs) = default;
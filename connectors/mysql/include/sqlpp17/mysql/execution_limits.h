@@ -0,0 +1,124 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <memory>
+#include <string>
+
+#include <sqlpp17/cancellation.h>
+
+#include <sqlpp17/mysql/connection_config.h>
+#include <sqlpp17/mysql/mysql.h>
+
+namespace sqlpp::mysql::detail
+{
+  // MySQL error codes of interrupted queries
+  constexpr auto query_interrupted_error = 1317u;  // ER_QUERY_INTERRUPTED, e.g. after KILL QUERY
+  constexpr auto query_timeout_error = 3024u;      // ER_QUERY_TIMEOUT, max_execution_time exceeded
+
+  inline auto error_code_of(unsigned int error) -> ::sqlpp::error_code
+  {
+    switch (error)
+    {
+      case 1213:  // ER_LOCK_DEADLOCK
+        return ::sqlpp::error_code::deadlock;
+      case 1205:  // ER_LOCK_WAIT_TIMEOUT
+        return ::sqlpp::error_code::lock_timeout;
+      default:
+        return ::sqlpp::error_code::unspecified;
+    }
+  }
+
+  // Interrupts the query running on a connection via KILL QUERY, sent through a second connection.
+  // This is best effort: Errors cannot be reported to anyone.
+  struct kill_query_t
+  {
+    connection_config_t config;
+    unsigned long thread_id = 0;
+
+    auto operator()() const -> void
+    {
+      thread_init();
+      const auto handle = std::unique_ptr<MYSQL, void (*)(MYSQL*)>(mysql_init(nullptr), &mysql_close);
+      if (not handle)
+      {
+        return;
+      }
+
+      if (config.ssl)
+      {
+        const auto& ssl = config.ssl.value();
+        mysql_ssl_set(handle.get(), ssl.key.c_str(), ssl.cert.c_str(), ssl.ca.empty() ? nullptr : ssl.ca.c_str(),
+                      ssl.caPath.empty() ? nullptr : ssl.caPath.c_str(),
+                      ssl.cipher.empty() ? nullptr : ssl.cipher.c_str());
+      }
+
+      if (mysql_real_connect(handle.get(), config.host.empty() ? nullptr : config.host.c_str(),
+                             config.user.empty() ? nullptr : config.user.c_str(),
+                             config.password.empty() ? nullptr : config.password.c_str(), nullptr, config.port,
+                             config.unix_socket.empty() ? nullptr : config.unix_socket.c_str(), config.client_flag))
+      {
+        const auto query = "KILL QUERY " + std::to_string(thread_id);
+        mysql_real_query(handle.get(), query.c_str(), query.size());
+      }
+    }
+  };
+
+  // Guards executing a statement and storing its results
+  class limits_guard
+  {
+    std::unique_ptr<::sqlpp::detail::interrupt_guard> _guard;
+
+  public:
+    limits_guard() = default;
+    limits_guard(::sqlpp::execution_limits* limits, const std::shared_ptr<const kill_query_t>& kill_query)
+    {
+      if (limits and kill_query and limits->begin_statement())
+      {
+        _guard = std::make_unique<::sqlpp::detail::interrupt_guard>(*limits, [kill_query] { (*kill_query)(); });
+      }
+    }
+
+    [[noreturn]] auto throw_error(unsigned int error, const std::string& message) const -> void
+    {
+      auto reason = _guard ? _guard->reason() : ::sqlpp::interrupt_reason::none;
+      if (reason == ::sqlpp::interrupt_reason::none)
+      {
+        if (error == query_interrupted_error)
+          reason = ::sqlpp::interrupt_reason::cancelled;
+        else if (error == query_timeout_error)
+          reason = ::sqlpp::interrupt_reason::deadline;
+      }
+
+      if (reason != ::sqlpp::interrupt_reason::none)
+      {
+        ::sqlpp::detail::throw_interrupted(reason, message);
+      }
+      throw ::sqlpp::exception(message, error_code_of(error));
+    }
+  };
+}  // namespace sqlpp::mysql::detail
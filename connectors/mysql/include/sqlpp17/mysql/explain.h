@@ -0,0 +1,162 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sqlpp17/exception.h>
+#include <sqlpp17/explain.h>
+
+#include <sqlpp17/mysql/direct_execution_result.h>
+#include <sqlpp17/mysql/mysql.h>
+
+namespace sqlpp::mysql::detail
+{
+  // Reads the number after the key, e.g. "cost=" in "(cost=0.35 rows=1)". Of ranges like "0.02..0.03", the
+  // last value is used.
+  inline auto plan_number(std::string_view group, std::string_view key) -> std::optional<double>
+  {
+    auto pos = group.find(key);
+    if (pos == group.npos)
+    {
+      return std::nullopt;
+    }
+    pos += key.size();
+    if (const auto range = group.find("..", pos); range != group.npos and range < group.find(' ', pos))
+    {
+      pos = range + 2;
+    }
+    return std::strtod(std::string(group.substr(pos, group.find_first_of(" )", pos) - pos)).c_str(), nullptr);
+  }
+
+  // The word that follows the marker, e.g. the table in "Table scan on tab_person"
+  inline auto plan_word_after(std::string_view description, std::string_view marker) -> std::string
+  {
+    const auto pos = description.find(marker);
+    if (pos == description.npos)
+    {
+      return {};
+    }
+    const auto word = description.substr(pos + marker.size());
+    return std::string(word.substr(0, word.find(' ')));
+  }
+
+  inline auto make_plan_node(std::string_view line) -> ::sqlpp::plan_node
+  {
+    auto node = ::sqlpp::plan_node{};
+
+    const auto cost_pos = line.find("(cost=");
+    const auto actual_pos = line.find("(actual time=");
+    const auto description = line.substr(0, std::min(cost_pos, actual_pos));
+    node.operation = std::string(description.substr(0, description.find_last_not_of(' ') + 1));
+    node.relation = plan_word_after(description, " on ");
+    node.index = plan_word_after(description, " using ");
+    node.full_scan = description.substr(0, 14).compare("Table scan on ") == 0;
+
+    if (cost_pos != line.npos)
+    {
+      const auto group = line.substr(cost_pos, line.find(')', cost_pos) - cost_pos);
+      node.estimated_cost = plan_number(group, "cost=");
+      node.estimated_rows = plan_number(group, "rows=");
+    }
+    if (actual_pos != line.npos)
+    {
+      const auto group = line.substr(actual_pos, line.find(')', actual_pos) - actual_pos);
+      node.actual_time_ms = plan_number(group, "time=");
+      node.actual_rows = plan_number(group, "rows=");
+    }
+    return node;
+  }
+
+  // Parses the tree format of EXPLAIN FORMAT=TREE and EXPLAIN ANALYZE, e.g.
+  //   -> Nested loop inner join  (cost=0.70 rows=1)
+  //       -> Table scan on p  (cost=0.35 rows=1)
+  //       -> Single-row index lookup on d using PRIMARY (id=p.department)  (cost=0.35 rows=1)
+  inline auto parse_plan_tree(std::string_view text) -> std::vector<::sqlpp::plan_node>
+  {
+    auto roots = std::vector<::sqlpp::plan_node>{};
+    auto path = std::vector<std::pair<std::size_t, ::sqlpp::plan_node*>>{};  // indentation and node
+
+    while (not text.empty())
+    {
+      const auto line = text.substr(0, text.find('\n'));
+      text.remove_prefix(std::min(text.size(), line.size() + 1));
+
+      const auto indentation = line.find_first_not_of(' ');
+      if (indentation == line.npos or line.substr(indentation, 3).compare("-> ") != 0)
+      {
+        continue;
+      }
+
+      while (not path.empty() and path.back().first >= indentation)
+      {
+        path.pop_back();
+      }
+      auto& siblings = path.empty() ? roots : path.back().second->children;
+      siblings.push_back(make_plan_node(line.substr(indentation + 3)));
+      path.emplace_back(indentation, &siblings.back());
+    }
+
+    return roots;
+  }
+
+  inline auto explain(MYSQL* connection, const std::string& sql_string, ::sqlpp::explain_mode mode)
+      -> ::sqlpp::query_plan
+  {
+    detail::thread_init();
+
+    const auto explain_string =
+        std::string(mode == ::sqlpp::explain_mode::analyze ? "EXPLAIN ANALYZE " : "EXPLAIN FORMAT=TREE ") + sql_string;
+    if (mysql_real_query(connection, explain_string.c_str(), explain_string.size()))
+    {
+      throw sqlpp::exception("MySQL: Could not explain statement: " + std::string(mysql_error(connection)) +
+                             " (statement was >>" + sql_string + "<<\n");
+    }
+
+    const auto result = detail::unique_result_ptr(mysql_store_result(connection), {});
+    if (not result)
+    {
+      throw sqlpp::exception("MySQL: Could not store explain result: " + std::string(mysql_error(connection)));
+    }
+
+    auto plan = ::sqlpp::query_plan{};
+    plan.sql = sql_string;
+    while (const auto row = mysql_fetch_row(result.get()))
+    {
+      const auto* lengths = mysql_fetch_lengths(result.get());
+      plan.raw.append(row[0], lengths[0]);
+    }
+    plan.nodes = parse_plan_tree(plan.raw);
+    return plan;
+  }
+}  // namespace sqlpp::mysql::detail
@@ -31,24 +31,54 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <optional>
 #include <string>
 #include <array>
+#include <variant>
+#include <vector>
 
+#include <sqlpp17/cancellation.h>
 #include <sqlpp17/exception.h>
+#include <sqlpp17/instrumentation.h>
+#include <sqlpp17/literal_parameters.h>
 #include <sqlpp17/prepared_statement_parameters.h>
 #include <sqlpp17/result.h>
 #include <sqlpp17/result_row.h>
+#include <sqlpp17/type_hash.h>
+#include <sqlpp17/detail/statement_cache.h>
 
+#include <sqlpp17/mysql/execution_limits.h>
 #include <sqlpp17/mysql/mysql.h>
 #include <sqlpp17/mysql/prepared_statement_result.h>
 
 namespace sqlpp::mysql::detail
 {
+  struct statement_cache_traits
+  {
+    static auto reset(MYSQL_STMT* handle) -> void
+    {
+      mysql_stmt_free_result(handle);
+    }
+
+    static auto finalize(MYSQL_STMT* handle) -> void
+    {
+      mysql_stmt_close(handle);
+    }
+  };
+  using statement_cache = ::sqlpp::detail::statement_cache<MYSQL_STMT, statement_cache_traits>;
+
   struct prepared_statement_cleanup_t
   {
   public:
+    std::weak_ptr<statement_cache> _cache = {};  // cached statements are handed back instead of being closed
+
     auto operator()(MYSQL_STMT* handle) -> void
     {
       if (handle)
+      {
+        if (const auto cache = _cache.lock(); cache and cache->release(handle))
+        {
+          return;
+        }
         mysql_stmt_close(handle);
+      }
     }
   };
   using unique_prepared_statement_ptr = std::unique_ptr<MYSQL_STMT, detail::prepared_statement_cleanup_t>;
@@ -180,13 +210,25 @@ namespace sqlpp::mysql
              ++index));
   }
 
-  template<typename ResultType, typename ParameterVector, typename ResultRow>
-  class prepared_statement_t
+  template <typename ResultType,
+            typename ParameterVector,
+            typename ResultRow,
+            typename Instrumentation = ::sqlpp::no_instrumentation>
+  class prepared_statement_t : private ::sqlpp::instrumentation_base<Instrumentation>
   {
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
+
     detail::unique_prepared_statement_ptr _handle;
+    ::sqlpp::execution_limits* _limits = nullptr;
+    std::shared_ptr<const detail::kill_query_t> _query_killer;
+    std::uint32_t _statement_hash = 0;
 #warning: This should be a tuple of correct types
     std::array<bind_meta_data_t, ParameterVector::size()> _parameter_bind_meta_data = {};
     std::array<MYSQL_BIND, ParameterVector::size()> _parameter_bind_data = {};
+    // Literals of directly executed statements, bound instead of the parameters, see ::sqlpp::parameterize
+    std::vector<::sqlpp::literal_value> _literals;
+    std::vector<bind_meta_data_t> _literal_bind_meta_data;
+    std::vector<MYSQL_BIND> _literal_bind_data;
 
   public:
     ::sqlpp::prepared_statement_parameters<ParameterVector> parameters = {};
@@ -194,13 +236,41 @@ namespace sqlpp::mysql
     prepared_statement_t() = default;
     template<typename Connection, typename Statement>
     prepared_statement_t(const Connection& connection, const Statement& statement)
+        : prepared_statement_t{connection, statement,
+                               ::sqlpp::instrumentation_now<_instrumentation_base::is_instrumented()>()}
+    {
+    }
+
+    template <typename Connection, typename Statement>
+    prepared_statement_t(const Connection& connection,
+                         const Statement& statement,
+                         ::sqlpp::instrumentation_clock::time_point serialization_start)
+        : prepared_statement_t{connection, to_sql_string_c(context_t{}, statement), type_hash<Statement>(),
+                               serialization_start}
+    {
+    }
+
+    template <typename Connection>
+    prepared_statement_t(const Connection& connection,
+                         const std::string& sql_string,
+                         std::uint32_t statement_hash,
+                         [[maybe_unused]] ::sqlpp::instrumentation_clock::time_point serialization_start)
+        : _instrumentation_base{connection.instrumentation()},
+          _limits(connection.limits()),
+          _query_killer(connection.query_killer())
     {
       detail::thread_init();
-      const auto sql_string = to_sql_string_c(context_t{}, statement);
 
-      if constexpr (Connection::is_debug_allowed())
+      if (connection.is_debug_active())
         connection.debug("Preparing: '" + sql_string + "'");
 
+      if constexpr (_instrumentation_base::is_instrumented())
+      {
+        _statement_hash = statement_hash;
+        const auto now = ::sqlpp::instrumentation_clock::now();
+        this->instrument(::sqlpp::prepare_start_event{_statement_hash, sql_string, now - serialization_start, now});
+      }
+
       _handle = detail::unique_prepared_statement_ptr(mysql_stmt_init(connection.get()), {});
       if (not _handle)
       {
@@ -208,10 +278,31 @@ namespace sqlpp::mysql
       }
       if (mysql_stmt_prepare(_handle.get(), sql_string.data(), sql_string.size()))
       {
+        if constexpr (_instrumentation_base::is_instrumented())
+          this->instrument(::sqlpp::error_event{_statement_hash, mysql_error(connection.get()),
+                                                ::sqlpp::instrumentation_clock::now()});
         throw sqlpp::exception("MySQL: Could not prepare statement: " + std::string(mysql_error(connection.get())) +
                                " (statement was >>" + sql_string + "<<\n");
       }
+
+      if constexpr (_instrumentation_base::is_instrumented())
+        this->instrument(::sqlpp::prepare_end_event{_statement_hash, ::sqlpp::instrumentation_clock::now()});
+    }
+
+    // Takes a statement that was prepared before, e.g. from a statement cache
+    template <typename Connection>
+    prepared_statement_t(const Connection& connection,
+                         detail::unique_prepared_statement_ptr handle,
+                         [[maybe_unused]] std::uint32_t statement_hash)
+        : _instrumentation_base{connection.instrumentation()},
+          _handle(std::move(handle)),
+          _limits(connection.limits()),
+          _query_killer(connection.query_killer())
+    {
+      if constexpr (_instrumentation_base::is_instrumented())
+        _statement_hash = statement_hash;
     }
+
     prepared_statement_t(const prepared_statement_t&) = delete;
     prepared_statement_t(prepared_statement_t&& rhs) = default;
     prepared_statement_t& operator=(const prepared_statement_t&) = delete;
@@ -222,18 +313,42 @@ namespace sqlpp::mysql
     {
       detail::thread_init();
 
-      ::sqlpp::mysql::bind_parameters(_parameter_bind_meta_data, _parameter_bind_data, parameters);
+      if constexpr (_instrumentation_base::is_instrumented())
+        this->instrument(::sqlpp::execute_start_event{_statement_hash, {}, {}, ::sqlpp::instrumentation_clock::now()});
+
+      auto* bind_data = _parameter_bind_data.data();
+      if (_literals.empty())
+      {
+        ::sqlpp::mysql::bind_parameters(_parameter_bind_meta_data, _parameter_bind_data, parameters);
+      }
+      else
+      {
+        bind_data = _literal_bind_data.data();
+      }
 
-      if (mysql_stmt_bind_param(_handle.get(), _parameter_bind_data.data()))
+      if (mysql_stmt_bind_param(_handle.get(), bind_data))
       {
         throw sqlpp::exception(std::string("MySQL: Could not bind parameters to statement") +
                                mysql_stmt_error(_handle.get()));
       }
 
+      const auto guard = detail::limits_guard{_limits, _query_killer};
       if (mysql_stmt_execute(_handle.get()))
       {
-        throw sqlpp::exception(std::string("MySQL: Could not execute prepared statement: ") +
-                               mysql_stmt_error(_handle.get()));
+        if constexpr (_instrumentation_base::is_instrumented())
+          this->instrument(::sqlpp::error_event{_statement_hash, mysql_stmt_error(_handle.get()),
+                                                ::sqlpp::instrumentation_clock::now()});
+        guard.throw_error(mysql_stmt_errno(_handle.get()), std::string("MySQL: Could not execute prepared statement: ") +
+                                                               mysql_stmt_error(_handle.get()));
+      }
+
+      if constexpr (_instrumentation_base::is_instrumented())
+      {
+        // Rows of a select are only known after storing or fetching them
+        const auto rows = std::is_same_v<ResultType, select_result>
+                              ? std::nullopt
+                              : std::optional<std::size_t>{mysql_stmt_affected_rows(_handle.get())};
+        this->instrument(::sqlpp::execute_end_event{_statement_hash, rows, ::sqlpp::instrumentation_clock::now()});
       }
 
       if constexpr (std::is_same_v<ResultType, insert_result>)
@@ -250,9 +365,17 @@ namespace sqlpp::mysql
       }
       else if constexpr (std::is_same_v<ResultType, select_result>)
       {
-        mysql_stmt_store_result(this->get());
-
-        return ::sqlpp::result_t<prepared_statement_result_t<ResultRow>>{{detail::unique_prepared_result_ptr{_handle.get(), {}}, column_count_v<ResultRow>}};
+        if (mysql_stmt_store_result(this->get()))
+        {
+          guard.throw_error(mysql_stmt_errno(this->get()),
+                            std::string("MySQL: Could not store result set: ") + mysql_stmt_error(this->get()));
+        }
+
+        auto handle = ::sqlpp::make_result_handle<Instrumentation>(
+            prepared_statement_result_t<ResultRow>{detail::unique_prepared_result_ptr{_handle.get(), {}},
+                                                   column_count_v<ResultRow>},
+            *this, _statement_hash);
+        return ::sqlpp::result_t<decltype(handle)>{std::move(handle)};
       }
       else if constexpr (std::is_same_v<ResultType, execute_result>)
       {
@@ -264,6 +387,31 @@ namespace sqlpp::mysql
       }
     }
 
+    // The bind data points into the literals, which therefore are kept by the statement
+    auto bind_literals(std::vector<::sqlpp::literal_value> literals) -> void
+    {
+      _literals = std::move(literals);
+      _literal_bind_meta_data.assign(_literals.size(), bind_meta_data_t{});
+      _literal_bind_data.assign(_literals.size(), MYSQL_BIND{});
+      for (std::size_t index = 0; index < _literals.size(); ++index)
+      {
+        std::visit(
+            [this, index](auto& value) {
+              bind_parameter(_literal_bind_meta_data[index], _literal_bind_data[index], value);
+            },
+            _literals[index]);
+      }
+    }
+
+    // Hands the statement to the cache once done with it, instead of closing it (if the cache has room)
+    auto cache_in(const std::shared_ptr<detail::statement_cache>& cache, const std::string& sql_string) -> void
+    {
+      if (cache->adopt(sql_string, _handle.get()))
+      {
+        _handle.get_deleter()._cache = cache;
+      }
+    }
+
     auto get() const -> MYSQL_STMT*
     {
       return _handle.get();
@@ -271,10 +419,14 @@ namespace sqlpp::mysql
   };
 
   template <typename Connection, typename Statement>
-  prepared_statement_t(const Connection&, const Statement&)->prepared_statement_t<result_type_of_t<Statement>, parameters_of_t<Statement>, result_row_of_t<Statement>>;
-
-  template<typename ResultType, typename ParameterVector, typename ResultRow>
-  auto execute(prepared_statement_t<ResultType, ParameterVector, ResultRow>& statement)
+  prepared_statement_t(const Connection&, const Statement&)
+      ->prepared_statement_t<result_type_of_t<Statement>,
+                             parameters_of_t<Statement>,
+                             result_row_of_t<Statement>,
+                             typename Connection::instrumentation_type>;
+
+  template <typename ResultType, typename ParameterVector, typename ResultRow, typename Instrumentation>
+  auto execute(prepared_statement_t<ResultType, ParameterVector, ResultRow, Instrumentation>& statement)
   {
     return statement.execute();
   }
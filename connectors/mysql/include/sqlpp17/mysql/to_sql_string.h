@@ -0,0 +1,71 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sqlpp17/to_sql_string.h>
+
+#include <sqlpp17/mysql/context.h>
+
+namespace sqlpp
+{
+  // Unless NO_BACKSLASH_ESCAPES is set, MySQL interprets backslashes in string literals.
+  // Escape the same characters as mysql_real_escape_string does.
+  [[nodiscard]] inline auto to_sql_string(::sqlpp::mysql::context_t& context, const std::string_view& s) -> std::string
+  {
+    if (detail::collects_literals(context))
+    {
+      return detail::add_literal(context, std::string(s));
+    }
+
+    auto ret = std::string{};
+    ret.reserve(s.size() + 2);
+    ret.push_back('\'');
+    detail::append_escaped<'\0', '\n', '\r', '\\', '\'', '"', '\x1a'>(ret, s, [](std::string& target, char c) {
+      target.push_back('\\');
+      switch (c)
+      {
+        case '\0':
+          target.push_back('0');
+          break;
+        case '\n':
+          target.push_back('n');
+          break;
+        case '\r':
+          target.push_back('r');
+          break;
+        case '\x1a':
+          target.push_back('Z');
+          break;
+        default:
+          target.push_back(c);
+      }
+    });
+    ret.push_back('\'');
+    return ret;
+  }
+
+}  // namespace sqlpp
@@ -0,0 +1,85 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <serialize/assert_equality.h>
+#include <sqlpp17/clause/bulk_update.h>
+#include <sqlpp17/mysql/clause.h>
+#include <sqlpp17/mysql/context.h>
+#include <sqlpp17/mysql/to_sql_string.h>
+
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::mysql::context_t;
+using ::sqlpp::test::assert_equality;
+using ::test::tabPerson;
+
+int main()
+{
+  try
+  {
+    const auto bulk = bulk_update(tabPerson, tabPerson.id, tabPerson.name, tabPerson.address)
+                          .rows(std::vector{std::tuple{1, std::string("Ada"), std::optional<std::string>{}},
+                                            std::tuple{2, std::string("Bjarne"), std::optional<std::string>{"Aarhus"}},
+                                            std::tuple{3, std::string("Herb"), std::optional<std::string>{}}});
+
+    // All rows in one statement, the NULL in the first row carries the column name
+    assert_equality(
+        "UPDATE tab_person INNER JOIN (SELECT 1 AS id, 'Ada' AS name, NULL AS address UNION ALL SELECT 2, 'Bjarne', "
+        "'Aarhus' UNION ALL SELECT 3, 'Herb', NULL) AS bulk_update_values ON tab_person.id = bulk_update_values.id SET "
+        "tab_person.name = bulk_update_values.name, tab_person.address = bulk_update_values.address",
+        to_sql_string_c(context_t{}, bulk));
+
+    // Multi-row chunk followed by the remainder
+    const auto chunks = bulk.chunks(2);
+    assert_equality("2", std::to_string(chunks.size()));
+    assert_equality(
+        "UPDATE tab_person INNER JOIN (SELECT 1 AS id, 'Ada' AS name, NULL AS address UNION ALL SELECT 2, 'Bjarne', "
+        "'Aarhus') AS bulk_update_values ON tab_person.id = bulk_update_values.id SET tab_person.name = "
+        "bulk_update_values.name, tab_person.address = bulk_update_values.address",
+        to_sql_string_c(context_t{}, chunks.front()));
+    assert_equality(
+        "UPDATE tab_person INNER JOIN (SELECT 3 AS id, 'Herb' AS name, NULL AS address) AS bulk_update_values ON "
+        "tab_person.id = bulk_update_values.id SET tab_person.name = bulk_update_values.name, tab_person.address = "
+        "bulk_update_values.address",
+        to_sql_string_c(context_t{}, chunks.back()));
+
+    // Without rows, the statement must still be valid and must not change anything
+    assert_equality("UPDATE tab_person SET id = id WHERE 1 = 0",
+                    to_sql_string_c(context_t{}, bulk_update(tabPerson, tabPerson.id, tabPerson.isManager)
+                                                         .rows(std::vector<std::tuple<int, bool>>{})));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+}
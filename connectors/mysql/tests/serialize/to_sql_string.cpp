@@ -0,0 +1,131 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <string>
+#include <string_view>
+
+#include <serialize/assert_equality.h>
+#include <sqlpp17/mysql/context.h>
+#include <sqlpp17/mysql/to_sql_string.h>
+
+using ::sqlpp::mysql::context_t;
+using ::sqlpp::test::assert_equality;
+
+namespace
+{
+  // One character at a time, as mysql_real_escape_string does it
+  auto escape_naively(const std::string_view s) -> std::string
+  {
+    auto ret = std::string{"'"};
+    for (const auto c : s)
+    {
+      switch (c)
+      {
+        case '\0':
+          ret += "\\0";
+          break;
+        case '\n':
+          ret += "\\n";
+          break;
+        case '\r':
+          ret += "\\r";
+          break;
+        case '\\':
+          ret += "\\\\";
+          break;
+        case '\'':
+          ret += "\\'";
+          break;
+        case '"':
+          ret += "\\\"";
+          break;
+        case '\x1a':
+          ret += "\\Z";
+          break;
+        default:
+          ret.push_back(c);
+      }
+    }
+    return ret + "'";
+  }
+
+  auto to_sql_string(const std::string_view s) -> std::string
+  {
+    auto context = context_t{};
+    return ::sqlpp::to_sql_string(context, s);
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    assert_equality("''", to_sql_string(""));
+    assert_equality("'hello'", to_sql_string("hello"));
+
+    // Each escaped byte, alone and surrounded
+    assert_equality(R"('\0')", to_sql_string(std::string_view("\0", 1)));
+    assert_equality(R"('\n')", to_sql_string("\n"));
+    assert_equality(R"('\r')", to_sql_string("\r"));
+    assert_equality(R"('\\')", to_sql_string("\\"));
+    assert_equality(R"('\'')", to_sql_string("'"));
+    assert_equality(R"('\"')", to_sql_string("\""));
+    assert_equality(R"('\Z')", to_sql_string("\x1a"));
+    assert_equality(R"('a\0b\nc\rd\\e\'f\"g\Zh')", to_sql_string(std::string_view("a\0b\nc\rd\\e'f\"g\x1ah", 15)));
+    assert_equality(R"('it\'s ok\\')", to_sql_string("it's ok\\"));
+
+    // Long values are scanned in blocks of 16 or 32 bytes, special characters must be found at any offset,
+    // including the first and last byte of a block and the tail that is shorter than a block
+    const auto specials = std::string_view("\0\n\r\\'\"\x1a", 7);
+    auto clean = std::string(4096, 'x');
+    assert_equality("'" + clean + "'", to_sql_string(clean));
+    for (const auto offset : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 1000, 4079, 4080, 4094, 4095})
+    {
+      for (const auto special : specials)
+      {
+        auto value = clean;
+        value[static_cast<std::size_t>(offset)] = special;
+        value[static_cast<std::size_t>(4095 - offset)] = special;
+        assert_equality(escape_naively(value), to_sql_string(value));
+      }
+    }
+
+    // Many special characters in a row
+    auto mixed = std::string{};
+    for (auto i = 0; i < 1024; ++i)
+    {
+      const auto index = static_cast<std::size_t>(i);
+      mixed.push_back(i % 3 == 0 ? specials[index % specials.size()] : static_cast<char>('a' + i % 26));
+    }
+    assert_equality(escape_naively(mixed), to_sql_string(mixed));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <future>
+#include <iostream>
+#include <thread>
+
+#include <sqlpp17/clause/command.h>
+#include <sqlpp17/clause/create_table.h>
+#include <sqlpp17/clause/drop_table.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/reactor.h>
+
+#include <sqlpp17/mysql/async_connection.h>
+#include <sqlpp17/mysql/connection.h>
+#include <sqlpp17/mysql_test/get_config.h>
+
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+
+namespace mysql = sqlpp::mysql;
+using ::test::tabDepartment;
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    mysql::global_library_init();
+
+    const auto config = mysql::test::get_config();
+    {
+      auto db = mysql::connection_t<sqlpp::debug::allowed>{config};
+      db(drop_table(tabDepartment));
+      db(create_table(tabDepartment));
+    }
+
+    auto reactor = ::sqlpp::reactor_t{};
+    auto io_thread = std::thread{[&reactor] { reactor.run(); }};
+
+    {
+      // Several connections are driven by the same thread
+      auto connections = std::vector<mysql::async_connection_t<sqlpp::debug::allowed>>{};
+      for (int i = 0; i < 4; ++i)
+      {
+        connections.emplace_back(reactor, config);
+      }
+
+      auto inserts = std::vector<std::future<my_ulonglong>>{};
+      for (int i = 0; i < 20; ++i)
+      {
+        inserts.push_back(connections[i % connections.size()](insert_into(tabDepartment).default_values()));
+      }
+      for (std::size_t i = 0; i < inserts.size(); ++i)
+      {
+        inserts[i].get();
+      }
+
+      auto rows = connections[0](select(tabDepartment.id).from(tabDepartment).unconditionally()).get();
+      auto count = 0;
+      for ([[maybe_unused]] const auto& row : rows)
+      {
+        ++count;
+      }
+      assert_true(count == 20, "selected rows");
+
+      // Errors are reported to the handler, the connection stays usable
+      auto failed = std::promise<bool>{};
+      connections[1](sqlpp::command("SELECT * FROM no_such_table"),
+                     [&failed](std::exception_ptr error) { failed.set_value(static_cast<bool>(error)); });
+      assert_true(failed.get_future().get(), "error reported");
+      connections[1](sqlpp::command("DO 1")).get();
+    }
+
+    reactor.stop();
+    io_thread.join();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+
+#include <sqlpp17/exception.h>
+#include <sqlpp17/mysql/explain.h>
+#include <sqlpp17_test/assert_true.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  // EXPLAIN ANALYZE SELECT ... FROM tab_person JOIN tab_department ... ORDER BY tab_person.name
+  constexpr auto analyzed_plan =
+      "-> Sort: tab_person.`name`  (cost=1.20 rows=2) (actual time=0.061..0.062 rows=2 loops=1)\n"
+      "    -> Nested loop inner join  (cost=1.10 rows=2) (actual time=0.032..0.045 rows=2 loops=1)\n"
+      "        -> Table scan on tab_person  (cost=0.45 rows=2) (actual time=0.021..0.026 rows=2 loops=1)\n"
+      "        -> Single-row index lookup on tab_department using PRIMARY (id=tab_person.department)  "
+      "(cost=0.30 rows=1) (actual time=0.008..0.008 rows=1 loops=2)\n"
+      "-> Select #2 (subquery in condition; run only once)\n";
+}  // namespace
+
+int main()
+{
+  try
+  {
+    const auto nodes = ::sqlpp::mysql::detail::parse_plan_tree(analyzed_plan);
+    assert_true(nodes.size() == 2, "roots");
+
+    const auto& sort = nodes.front();
+    assert_true(sort.operation.compare("Sort: tab_person.`name`") == 0, "sort operation");
+    assert_true(sort.estimated_cost == 1.2 and sort.estimated_rows == 2.0, "sort estimates");
+    assert_true(sort.actual_time_ms == 0.062 and sort.actual_rows == 2.0, "sort actuals");
+    assert_true(sort.children.size() == 1 and sort.children.front().children.size() == 2, "tree");
+
+    const auto& table_scan = sort.children.front().children[0];
+    assert_true(table_scan.full_scan and table_scan.relation.compare("tab_person") == 0, "table scan");
+
+    const auto& lookup = sort.children.front().children[1];
+    assert_true(not lookup.full_scan and lookup.relation.compare("tab_department") == 0, "lookup relation");
+    assert_true(lookup.index.compare("PRIMARY") == 0, "lookup index");
+
+    assert_true(not nodes.back().estimated_cost and nodes.back().children.empty(), "subquery");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
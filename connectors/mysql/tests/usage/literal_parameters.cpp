@@ -0,0 +1,81 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <future>
+#include <iostream>
+#include <string_view>
+
+#include <sqlpp17/clause/create_table.h>
+#include <sqlpp17/clause/delete_from.h>
+#include <sqlpp17/clause/drop_table.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/mysql/connection.h>
+#include <sqlpp17/mysql_test/get_config.h>
+
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+
+namespace mysql = sqlpp::mysql;
+using ::test::tabDepartment;
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    mysql::global_library_init();
+
+    auto config = mysql::test::get_config();
+    config.parameterize_literals = true;
+    auto db = mysql::connection_t<sqlpp::debug::allowed>{config};
+
+    db(drop_table(tabDepartment));
+    db(create_table(tabDepartment));
+
+    // Inserts differing in their values only share one server-side statement
+    auto last_id = my_ulonglong{0};
+    for (const auto* name : {"one", "it's", "back\\slash"})
+    {
+      const auto id = db(insert_into(tabDepartment).set(tabDepartment.name = name));
+      assert_true(id > last_id, "insert id");
+      last_id = id;
+    }
+
+    assert_true(db(update(tabDepartment).set(tabDepartment.name = "two").where(tabDepartment.id >= 2.5)) == 1,
+                "update");
+    assert_true(db(delete_from(tabDepartment).where(tabDepartment.name == "it's")) == 0, "delete updated row");
+    assert_true(db(delete_from(tabDepartment).where(tabDepartment.name == "one")) == 1, "delete");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
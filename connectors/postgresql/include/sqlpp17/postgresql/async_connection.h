@@ -0,0 +1,486 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <libpq-fe.h>
+
+#include <sqlpp17/connection.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/instrumentation.h>
+#include <sqlpp17/reactor.h>
+#include <sqlpp17/statement.h>
+
+#include <sqlpp17/postgresql/char_result.h>
+#include <sqlpp17/postgresql/connection.h>
+#include <sqlpp17/postgresql/context.h>
+#include <sqlpp17/postgresql/execution_limits.h>
+#include <sqlpp17/postgresql/prepared_statement.h>
+
+namespace sqlpp::postgresql::detail
+{
+  class async_query
+  {
+    std::string _sql_string;
+
+  public:
+    async_query(std::string sql_string) : _sql_string{std::move(sql_string)}
+    {
+    }
+    async_query(const async_query&) = delete;
+    async_query& operator=(const async_query&) = delete;
+    virtual ~async_query() = default;
+
+    auto& sql_string() const
+    {
+      return _sql_string;
+    }
+
+    virtual auto complete(unique_result_ptr result) -> void = 0;
+    virtual auto fail(std::exception_ptr error) -> void = 0;
+  };
+
+  template <typename ResultType, typename ResultRow>
+  using async_value_t = decltype(statement_result<ResultType, ResultRow>(
+      std::declval<unique_result_ptr>(),
+      std::declval<const ::sqlpp::instrumentation_base<::sqlpp::no_instrumentation>&>(),
+      std::uint32_t{}));
+
+  template <typename ResultType, typename ResultRow, typename Handler>
+  class typed_async_query : public async_query
+  {
+    using _value_type = async_value_t<ResultType, ResultRow>;
+    Handler _handler;
+
+  public:
+    typed_async_query(std::string sql_string, Handler handler)
+        : async_query{std::move(sql_string)}, _handler{std::move(handler)}
+    {
+    }
+
+    auto complete(unique_result_ptr result) -> void override
+    {
+      switch (PQresultStatus(result.get()))
+      {
+        case PGRES_COMMAND_OK:
+          [[fallthrough]];
+        case PGRES_TUPLES_OK:
+          break;
+        default:
+          try
+          {
+            throw_execution_error(result.get(), ::sqlpp::interrupt_reason::none,
+                                  "Postgresql: Error during query execution (query was >>" + sql_string() + "<<): ");
+          }
+          catch (...)
+          {
+            fail(std::current_exception());
+          }
+          return;
+      }
+      _handler(std::exception_ptr{}, statement_result<ResultType, ResultRow>(
+                                         std::move(result), ::sqlpp::instrumentation_base<::sqlpp::no_instrumentation>{}, 0));
+    }
+
+    auto fail(std::exception_ptr error) -> void override
+    {
+      _handler(std::move(error), _value_type{});
+    }
+  };
+
+  // Owned by the reactor thread: All member functions except the constructor must be called on that thread.
+  template <::sqlpp::debug Debug>
+  class async_connection_state : public ::sqlpp::reactor_watcher,
+                                 public std::enable_shared_from_this<async_connection_state<Debug>>,
+                                 private ::sqlpp::debug_base<Debug>
+  {
+    using _debug_base = ::sqlpp::debug_base<Debug>;
+
+    enum class state
+    {
+      connecting,
+      idle,
+      busy,
+      broken,
+      closed,
+    };
+
+    ::sqlpp::reactor_t& _reactor;
+    std::function<void(PGconn*)> _post_connect;
+    unique_connection_ptr _handle;
+    int _socket = -1;
+    std::uint32_t _events = 0;
+    state _state = state::connecting;
+
+    std::deque<std::shared_ptr<async_query>> _queue;
+    std::shared_ptr<async_query> _current;
+    unique_result_ptr _result;
+
+    auto debug(const std::string& message) const -> void
+    {
+      if constexpr (Debug == ::sqlpp::debug::allowed)
+      {
+        if (this->_debug)
+          this->_debug(message);
+      }
+    }
+
+    auto interest(std::uint32_t events) -> void
+    {
+      // The socket can change while connecting, e.g. when trying the next of several hosts
+      if (const auto socket = PQsocket(_handle.get()); socket != _socket)
+      {
+        if (_socket >= 0)
+          _reactor.unwatch(_socket);
+        _socket = socket;
+        _events = events;
+        _reactor.watch(_socket, _events, *this);
+        return;
+      }
+      if (events != _events)
+      {
+        _events = events;
+        _reactor.modify(_socket, _events);
+      }
+    }
+
+    auto poll_connect() -> void
+    {
+      switch (PQconnectPoll(_handle.get()))
+      {
+        case PGRES_POLLING_READING:
+          interest(::sqlpp::reactor_t::readable);
+          return;
+        case PGRES_POLLING_WRITING:
+          interest(::sqlpp::reactor_t::writable);
+          return;
+        case PGRES_POLLING_OK:
+          if (_post_connect)
+            _post_connect(_handle.get());
+          debug("Connected asynchronously");
+          _state = state::idle;
+          interest(::sqlpp::reactor_t::readable);
+          start_next();
+          return;
+        default:
+          break_connection("Postgresql: could not connect to server: " + std::string(PQerrorMessage(_handle.get())));
+      }
+    }
+
+    auto start_next() -> void
+    {
+      while (_state == state::idle and not _queue.empty())
+      {
+        auto query = std::move(_queue.front());
+        _queue.pop_front();
+        debug("Sending: '" + query->sql_string() + "'");
+
+        // PQsendQuery is not allowed in pipeline mode, the other sending functions do not care
+        if (PQsendQueryParams(_handle.get(), query->sql_string().c_str(), 0, nullptr, nullptr, nullptr, nullptr, 0) !=
+            1)
+        {
+          query->fail(std::make_exception_ptr(::sqlpp::exception("Postgresql: could not send query: " +
+                                                                 std::string(PQerrorMessage(_handle.get())))));
+          if (PQstatus(_handle.get()) != CONNECTION_OK)
+          {
+            break_connection("Postgresql: connection lost: " + std::string(PQerrorMessage(_handle.get())));
+          }
+          continue;
+        }
+        _current = std::move(query);
+        _state = state::busy;
+        flush();
+      }
+    }
+
+    auto flush() -> void
+    {
+      switch (PQflush(_handle.get()))
+      {
+        case 0:
+          interest(::sqlpp::reactor_t::readable);
+          return;
+        case 1:
+          interest(::sqlpp::reactor_t::readable | ::sqlpp::reactor_t::writable);
+          return;
+        default:
+          break_connection("Postgresql: could not send query: " + std::string(PQerrorMessage(_handle.get())));
+      }
+    }
+
+    auto receive() -> void
+    {
+      if (PQconsumeInput(_handle.get()) != 1)
+      {
+        break_connection("Postgresql: connection lost: " + std::string(PQerrorMessage(_handle.get())));
+        return;
+      }
+
+      while (_state == state::busy and PQisBusy(_handle.get()) == 0)
+      {
+        auto result = unique_result_ptr(PQgetResult(_handle.get()), {});
+        if (result)
+        {
+          // A single statement has a single result, anything after that is ignored
+          if (not _result)
+            _result = std::move(result);
+          continue;
+        }
+
+        // nullptr: The query is done
+        auto query = std::move(_current);
+        auto query_result = std::move(_result);
+        _state = state::idle;
+        if (query_result)
+        {
+          query->complete(std::move(query_result));
+        }
+        else
+        {
+          query->fail(std::make_exception_ptr(::sqlpp::exception("Postgresql: query without result (query was >>" +
+                                                                 query->sql_string() + "<<)")));
+        }
+      }
+      start_next();
+    }
+
+    auto fail_all(const std::string& message) -> void
+    {
+      const auto error = std::make_exception_ptr(::sqlpp::exception(message));
+      _result.reset();
+      if (_current)
+      {
+        std::exchange(_current, nullptr)->fail(error);
+      }
+      while (not _queue.empty())
+      {
+        auto query = std::move(_queue.front());
+        _queue.pop_front();
+        query->fail(error);
+      }
+    }
+
+    auto break_connection(const std::string& message) -> void
+    {
+      debug(message);
+      _state = state::broken;
+      if (_socket >= 0)
+      {
+        _reactor.unwatch(_socket);
+        _socket = -1;
+      }
+      fail_all(message);
+    }
+
+  public:
+    async_connection_state(::sqlpp::reactor_t& reactor, const connection_config_t& config)
+        : _debug_base{config.debug}, _reactor{reactor}, _post_connect{config.post_connect}
+    {
+      if (config.pre_connect)
+      {
+        config.pre_connect(nullptr);
+      }
+
+      // Note that host names are resolved synchronously, use hostaddr to avoid that
+      _handle.reset(PQconnectStart(conninfo_of(config).c_str()));
+      if (not _handle)
+      {
+        throw ::sqlpp::exception("Postgresql: out of memory while connecting");
+      }
+      if (PQstatus(_handle.get()) == CONNECTION_BAD)
+      {
+        throw ::sqlpp::exception("Postgresql: could not connect to server: " +
+                                 std::string(PQerrorMessage(_handle.get())));
+      }
+      if (PQsetnonblocking(_handle.get(), 1) != 0)
+      {
+        throw ::sqlpp::exception("Postgresql: could not make connection non-blocking: " +
+                                 std::string(PQerrorMessage(_handle.get())));
+      }
+    }
+
+    auto start() -> void
+    {
+      // Polling a new connection starts as if PQconnectPoll had returned PGRES_POLLING_WRITING
+      interest(::sqlpp::reactor_t::writable);
+    }
+
+    auto on_ready(std::uint32_t events) -> void override
+    {
+      // Exceptions must not escape into the reactor, e.g. watching the socket fails if PQsocket() returns -1
+      try
+      {
+        switch (_state)
+        {
+          case state::connecting:
+            poll_connect();
+            return;
+          case state::idle:
+            [[fallthrough]];
+          case state::busy:
+            if (events & ::sqlpp::reactor_t::writable)
+            {
+              flush();
+            }
+            if (_state != state::broken and (events & ~::sqlpp::reactor_t::writable))
+            {
+              receive();
+            }
+            return;
+          case state::broken:
+            [[fallthrough]];
+          case state::closed:
+            return;
+        }
+      }
+      catch (const std::exception& e)
+      {
+        break_connection(std::string("Postgresql: ") + e.what());
+      }
+    }
+
+    auto enqueue(std::shared_ptr<async_query> query) -> void
+    {
+      switch (_state)
+      {
+        case state::broken:
+          query->fail(std::make_exception_ptr(::sqlpp::exception("Postgresql: connection is broken")));
+          return;
+        case state::closed:
+          query->fail(std::make_exception_ptr(::sqlpp::exception("Postgresql: connection is closed")));
+          return;
+        default:
+          _queue.push_back(std::move(query));
+          start_next();
+      }
+    }
+
+    auto close() -> void
+    {
+      if (_socket >= 0)
+      {
+        _reactor.unwatch(_socket);
+        _socket = -1;
+      }
+      _state = state::closed;
+      fail_all("Postgresql: connection closed before the query completed");
+      _handle.reset();
+    }
+
+    [[nodiscard]] auto queued() const -> std::size_t
+    {
+      return _queue.size() + (_current ? 1 : 0);
+    }
+  };
+}  // namespace sqlpp::postgresql::detail
+
+namespace sqlpp::postgresql
+{
+  // A connection driven by a reactor_t: Statements are sent and their results received without blocking any
+  // thread, so that a single thread running the reactor can serve many connections. Each connection executes its
+  // statements one after the other, in the order they were submitted.
+  //
+  // Statements can be submitted from any thread. Handlers are called on the reactor's thread as
+  // handler(std::exception_ptr error, Value value), where Value is what connection_t::operator() would return for
+  // the statement (default constructed if there is an error). Handlers must not throw.
+  // The futures returned by the overload without handler must not be waited for on the reactor's thread.
+  //
+  // The reactor must outlive the connection. Destroying the connection fails its outstanding statements.
+  // Execution limits, instrumentation and prepared statements are not supported (yet).
+  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed>
+  class async_connection_t
+  {
+    using _state_t = detail::async_connection_state<Debug>;
+
+    ::sqlpp::reactor_t* _reactor;
+    std::shared_ptr<_state_t> _state;
+
+  public:
+    async_connection_t(::sqlpp::reactor_t& reactor, const connection_config_t& config)
+        : _reactor{&reactor}, _state{std::make_shared<_state_t>(reactor, config)}
+    {
+      _reactor->post([state = _state] { state->start(); });
+    }
+    async_connection_t(const async_connection_t&) = delete;
+    async_connection_t(async_connection_t&&) = default;
+    async_connection_t& operator=(const async_connection_t&) = delete;
+    async_connection_t& operator=(async_connection_t&&) = delete;
+    ~async_connection_t()
+    {
+      if (_state)
+      {
+        _reactor->post([state = std::move(_state)] { state->close(); });
+      }
+    }
+
+    template <typename... Clauses, typename Handler>
+    auto operator()(const ::sqlpp::statement<Clauses...>& statement, Handler handler)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_executable<connection_t<Debug>>(type_v<Statement>); _check)
+      {
+        using _query_t = detail::typed_async_query<result_type_of_t<Statement>, result_row_of_t<Statement>, Handler>;
+        auto query = std::make_shared<_query_t>(to_sql_string_c(context_t{}, statement), std::move(handler));
+        _reactor->post([state = _state, query = std::move(query)]() mutable { state->enqueue(std::move(query)); });
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+
+    template <typename... Clauses>
+    auto operator()(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_executable<connection_t<Debug>>(type_v<Statement>); _check)
+      {
+        using _value_type = detail::async_value_t<result_type_of_t<Statement>, result_row_of_t<Statement>>;
+        auto promise = std::make_shared<std::promise<_value_type>>();
+        auto future = promise->get_future();
+        (*this)(statement, [promise](std::exception_ptr error, _value_type value) {
+          if (error)
+            promise->set_exception(std::move(error));
+          else
+            promise->set_value(std::move(value));
+        });
+        return future;
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+  };
+}  // namespace sqlpp::postgresql
@@ -37,6 +37,10 @@ namespace sqlpp
   [[nodiscard]] auto to_sql_string(postgresql::context_t& context, const T& b)
       -> std::enable_if_t<std::is_same_v<T, bool>, std::string>
   {
+    if (detail::collects_literals(context))
+    {
+      return detail::add_literal(context, b);
+    }
     return b ? std::string("TRUE") : std::string("FALSE");
   }
 
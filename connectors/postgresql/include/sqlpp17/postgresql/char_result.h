@@ -26,6 +26,7 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -46,6 +47,22 @@ namespace sqlpp::postgresql::detail
     }
   };
   using unique_result_ptr = std::unique_ptr<PGresult, detail::result_cleanup_t>;
+
+  // Rows returned by a query or affected by a command, if known
+  inline auto affected_rows(PGresult* result) -> std::optional<std::size_t>
+  {
+    if (PQresultStatus(result) == PGRES_TUPLES_OK)
+    {
+      return static_cast<std::size_t>(PQntuples(result));
+    }
+
+    const char* const rows = PQcmdTuples(result);
+    if (rows[0] == '\0')
+    {
+      return std::nullopt;
+    }
+    return static_cast<std::size_t>(std::strtoull(rows, nullptr, 10));
+  }
 }  // namespace sqlpp::postgresql::detail
 
 namespace sqlpp::postgresql
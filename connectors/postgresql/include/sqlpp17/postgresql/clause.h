@@ -26,5 +26,7 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <sqlpp17/postgresql/clause/bulk_update.h>
 #include <sqlpp17/postgresql/clause/create_table.h>
+#include <sqlpp17/postgresql/clause/on_conflict.h>
 
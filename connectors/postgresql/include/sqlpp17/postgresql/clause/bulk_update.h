@@ -0,0 +1,118 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <sqlpp17/clause/bulk_update.h>
+#include <sqlpp17/free_column.h>
+
+#include <sqlpp17/postgresql/clause/create_table.h>
+#include <sqlpp17/postgresql/context.h>
+
+namespace sqlpp::postgresql::detail
+{
+  // Values of the first row are cast to the column types, the types of VALUES columns are inferred from them
+  template <typename Column, typename Value>
+  [[nodiscard]] auto bulk_update_value_to_sql_string(postgresql::context_t& context, const Value& value, bool cast)
+      -> std::string
+  {
+    if (not cast)
+    {
+      return to_sql_string(context, value);
+    }
+    auto ret = std::string{"CAST("};
+    ret += to_sql_string(context, value);
+    ret += " AS";
+    return ret + value_type_to_sql_string(column_type<value_type_of_t<Column>>{}) + ")";
+  }
+
+  template <typename... Columns, typename Row, std::size_t... Is>
+  [[nodiscard]] auto bulk_update_row_to_sql_string(postgresql::context_t& context, const Row& row, bool cast,
+                                                   std::index_sequence<Is...>)
+  {
+    auto ret = std::string{"("};
+    ((ret += (Is ? ", " : "") + bulk_update_value_to_sql_string<Columns>(context, std::get<Is>(row), cast)), ...);
+    return ret + ")";
+  }
+
+  template <typename... Columns, std::size_t... Is>
+  [[nodiscard]] auto bulk_update_names_to_sql_string(postgresql::context_t& context, std::index_sequence<Is...>)
+  {
+    auto ret = std::string{};
+    ((ret += (Is ? ", " : "") + to_sql_string(context, free_column_t<Columns>{})), ...);
+    return ret;
+  }
+
+  template <typename... Columns, std::size_t... Is>
+  [[nodiscard]] auto bulk_update_assignments_to_sql_string(postgresql::context_t& context,
+                                                           std::index_sequence<Is...>)
+  {
+    auto ret = std::string{};
+    ((ret += (Is ? ", " : "") + to_sql_string(context, free_column_t<Columns>{}) + " = bulk_update_values." +
+             to_sql_string(context, free_column_t<Columns>{})),
+     ...);
+    return ret;
+  }
+}  // namespace sqlpp::postgresql::detail
+
+namespace sqlpp
+{
+  // UPDATE t SET c = bulk_update_values.c FROM (VALUES (1, 'a'), (2, 'b')) AS bulk_update_values (k, c)
+  // WHERE t.k = bulk_update_values.k
+  template <typename Table, typename Key, typename Row, typename... Columns, typename Statement>
+  [[nodiscard]] auto to_sql_string(postgresql::context_t& context,
+                                   const clause_base<bulk_update_t<Table, Key, Row, Columns...>, Statement>& t)
+      -> std::string
+  {
+    if (t._rows.empty())
+    {
+      return detail::empty_bulk_update_to_sql_string(context, t);
+    }
+
+    auto ret = "UPDATE " + to_sql_string(context, t._table);
+    ret += " SET ";
+    ret += postgresql::detail::bulk_update_assignments_to_sql_string<Columns...>(
+        context, std::index_sequence_for<Columns...>{});
+    ret += " FROM (VALUES ";
+    for (std::size_t i = 0; i < t._rows.size(); ++i)
+    {
+      if (i)
+        ret += ", ";
+      ret += postgresql::detail::bulk_update_row_to_sql_string<Key, Columns...>(
+          context, t._rows[i], i == 0, std::index_sequence_for<Key, Columns...>{});
+    }
+    ret += ") AS bulk_update_values (";
+    ret += postgresql::detail::bulk_update_names_to_sql_string<Key, Columns...>(
+        context, std::index_sequence_for<Key, Columns...>{});
+    ret += ") WHERE ";
+    ret += to_sql_string(context, Key{});
+    return ret + " = bulk_update_values." + to_sql_string(context, free_column_t<Key>{});
+  }
+}  // namespace sqlpp
@@ -135,24 +135,10 @@ namespace sqlpp::postgresql::detail
   [[nodiscard]] auto to_sql_create_columns_string(postgresql::context_t& context,
                                                   const std::tuple<column_t<TableSpec, ColumnSpecs>...>& t)
   {
-    struct
-    {
-      bool first = true;
-      [[nodiscard]] auto to_string() -> std::string
-      {
-        if (first)
-        {
-          first = false;
-          return "";
-        }
-        else
-        {
-          return ", ";
-        }
-      }
-    } separator;
-
-    return (std ::string{} + ... + (separator.to_string() + to_sql_column_spec_string(context, ColumnSpecs{})));
+    // The comma operator serializes the columns from left to right, operands of + have no such order
+    auto ret = std::string{};
+    ((ret += (ret.empty() ? "" : ", ") + to_sql_column_spec_string(context, ColumnSpecs{})), ...);
+    return ret;
   }
 
   template <typename TableSpec>
@@ -27,30 +27,44 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <functional>
+#include <string>
 #include <type_traits>
+#include <variant>
+#include <vector>
 
+#include <libpq-fe.h>
+
+#include <sqlpp17/cancellation.h>
 #include <sqlpp17/clause/command.h>
 #include <sqlpp17/connection.h>
+#include <sqlpp17/literal_parameters.h>
 #include <sqlpp17/result.h>
 #include <sqlpp17/statement.h>
+#include <sqlpp17/transaction.h>
 
 #include <sqlpp17/postgresql/bool.h>
 #include <sqlpp17/postgresql/char_result.h>
 #include <sqlpp17/postgresql/clause.h>
 #include <sqlpp17/postgresql/connection_config.h>
 #include <sqlpp17/postgresql/context.h>
+#include <sqlpp17/postgresql/execution_limits.h>
+#include <sqlpp17/postgresql/explain.h>
 #include <sqlpp17/postgresql/operator.h>
 #include <sqlpp17/postgresql/parameter.h>
+#ifdef LIBPQ_HAS_PIPELINING
+#include <sqlpp17/postgresql/pipeline.h>
+#endif
 #include <sqlpp17/postgresql/prepared_statement.h>
 #include <sqlpp17/postgresql/to_sql_string.h>
+#include <sqlpp17/postgresql/value_list.h>
 
 namespace sqlpp::postgresql
 {
-  template <typename Pool, ::sqlpp::debug Debug>
+  template <typename Pool, ::sqlpp::debug Debug, typename Instrumentation = ::sqlpp::no_instrumentation>
   class base_connection;
 
-  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed>
-  using connection_t = base_connection<no_pool, Debug>;
+  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed, typename Instrumentation = ::sqlpp::no_instrumentation>
+  using connection_t = base_connection<no_pool, Debug, Instrumentation>;
 };  // namespace sqlpp::postgresql
 
 namespace sqlpp::postgresql::detail
@@ -66,16 +80,87 @@ namespace sqlpp::postgresql::detail
   };
   using unique_connection_ptr = std::unique_ptr<PGconn, detail::connection_cleanup_t>;
 
-  template<typename Connection, typename Statement>
-  auto execute(const Connection& connection, const Statement& statement) -> detail::unique_result_ptr
+  // Literal values in text format. Numbers and booleans are typed, text is left for the server to infer.
+  class literal_parameters_t
   {
-    const auto sql_string =  to_sql_string_c(context_t{}, statement);
+    std::vector<std::string> _values;
+    std::vector<Oid> _types;
+    std::vector<const char*> _pointers;
 
-    if (Connection::is_debug_allowed())
+  public:
+    literal_parameters_t(const std::vector<::sqlpp::literal_value>& literals)
+    {
+      _values.reserve(literals.size());
+      _types.reserve(literals.size());
+      for (const auto& literal : literals)
+      {
+        std::visit(
+            [this](const auto& value) {
+              using T = std::decay_t<decltype(value)>;
+              if constexpr (std::is_same_v<T, bool>)
+              {
+                _values.emplace_back(value ? "t" : "f");
+                _types.push_back(16);  // bool
+              }
+              else if constexpr (std::is_same_v<T, std::int64_t>)
+              {
+                _values.push_back(std::to_string(value));
+                _types.push_back(20);  // int8
+              }
+              else if constexpr (std::is_same_v<T, double>)
+              {
+                _values.push_back(::sqlpp::detail::float_to_chars(value));
+                _types.push_back(701);  // float8
+              }
+              else
+              {
+                _values.push_back(value);
+                _types.push_back(0);
+              }
+            },
+            literal);
+      }
+      for (const auto& value : _values)
+      {
+        _pointers.push_back(value.c_str());
+      }
+    }
+
+    [[nodiscard]] auto size() const -> int
+    {
+      return static_cast<int>(_values.size());
+    }
+
+    [[nodiscard]] auto types() const -> const Oid*
+    {
+      return _types.data();
+    }
+
+    [[nodiscard]] auto values() const -> const char* const*
+    {
+      return _pointers.data();
+    }
+  };
+
+  template <typename Connection, typename Call>
+  auto execute_sql(const Connection& connection,
+                   const std::string& sql_string,
+                   ::sqlpp::execution_limits* limits,
+                   [[maybe_unused]] std::uint32_t statement_hash,
+                   [[maybe_unused]] ::sqlpp::instrumentation_clock::time_point serialization_start,
+                   Call call) -> detail::unique_result_ptr
+  {
+    if (connection.is_debug_active())
       connection.debug("Executing: '" + sql_string + "'");
 
-    // If one day we switch to binary format, then we could use PQexecParams with resultFormat=1
-    auto result = detail::unique_result_ptr(PQexec(connection.get(), sql_string.c_str()), {});
+    if constexpr (Connection::is_instrumented())
+    {
+      const auto now = ::sqlpp::instrumentation_clock::now();
+      connection.instrument(::sqlpp::execute_start_event{statement_hash, sql_string, now - serialization_start, now});
+    }
+
+    auto reason = ::sqlpp::interrupt_reason::none;
+    auto result = detail::call_with_limits(connection.get(), limits, reason, call);
 
     if (not result)
     {
@@ -87,13 +172,88 @@ namespace sqlpp::postgresql::detail
       case PGRES_COMMAND_OK:
         [[fallthrough]];
       case PGRES_TUPLES_OK:
+        if constexpr (Connection::is_instrumented())
+          connection.instrument(::sqlpp::execute_end_event{statement_hash, affected_rows(result.get()),
+                                                           ::sqlpp::instrumentation_clock::now()});
         return result;
       default:
-        throw sqlpp::exception(std::string("Postgresql: Error during query execution: ") +
-                               PQresultErrorMessage(result.get()) + " (query was >>" + sql_string + "<<\n");
+        if constexpr (Connection::is_instrumented())
+          connection.instrument(::sqlpp::error_event{statement_hash, PQresultErrorMessage(result.get()),
+                                                     ::sqlpp::instrumentation_clock::now()});
+        detail::throw_execution_error(result.get(), reason,
+                                      "Postgresql: Error during query execution (query was >>" + sql_string + "<<): ");
     }
   }
 
+  template<typename Connection, typename Statement>
+  auto execute(const Connection& connection, const Statement& statement, ::sqlpp::execution_limits* limits)
+      -> detail::unique_result_ptr
+  {
+    const auto serialization_start = ::sqlpp::instrumentation_now<Connection::is_instrumented()>();
+
+    // Literals are sent separately, so that the server can reuse plans, see connection_config_t.
+    // Statements without literals keep using PQexec, which allows for several commands in one string.
+    if (::sqlpp::is_literal_parameterizable_v<Statement> and connection.parameterizes_literals())
+    {
+      const auto parameterized = ::sqlpp::parameterize<context_t>(statement);
+      if (parameterized.literals.empty())
+      {
+        return execute_sql(connection, parameterized.sql, limits, type_hash<Statement>(), serialization_start,
+                           [&] { return PQexec(connection.get(), parameterized.sql.c_str()); });
+      }
+      const auto parameters = literal_parameters_t{parameterized.literals};
+      return execute_sql(connection, parameterized.sql, limits, type_hash<Statement>(), serialization_start, [&] {
+        return PQexecParams(connection.get(), parameterized.sql.c_str(), parameters.size(), parameters.types(),
+                            parameters.values(), nullptr, nullptr, 0);
+      });
+    }
+
+    // If one day we switch to binary format, then we could use PQexecParams with resultFormat=1
+    const auto sql_string = to_sql_string_c(context_t{}, statement);
+    return execute_sql(connection, sql_string, limits, type_hash<Statement>(), serialization_start,
+                       [&] { return PQexec(connection.get(), sql_string.c_str()); });
+  }
+
+  template <typename Connection, typename Statement>
+  auto execute(const Connection& connection, const Statement& statement) -> detail::unique_result_ptr
+  {
+    return execute(connection, statement, connection.limits());
+  }
+
+  inline auto begin_statement_of(const ::sqlpp::transaction_options& options) -> std::string
+  {
+    auto modes = std::string{};
+    const auto add_mode = [&modes](const char* mode) { modes += (modes.empty() ? " " : ", ") + std::string(mode); };
+    switch (options.isolation)
+    {
+      case ::sqlpp::isolation_level::serializable:
+        add_mode("ISOLATION LEVEL SERIALIZABLE");
+        break;
+      case ::sqlpp::isolation_level::repeatable_read:
+        add_mode("ISOLATION LEVEL REPEATABLE READ");
+        break;
+      case ::sqlpp::isolation_level::read_committed:
+        add_mode("ISOLATION LEVEL READ COMMITTED");
+        break;
+      case ::sqlpp::isolation_level::read_uncommitted:
+        add_mode("ISOLATION LEVEL READ UNCOMMITTED");
+        break;
+      case ::sqlpp::isolation_level::current:
+        break;
+    }
+    if (options.access == ::sqlpp::access_mode::read_only)
+      add_mode("READ ONLY");
+    // Read only serializable deferrable transactions wait for a safe snapshot once, and then run without
+    // serialization checks and without risk of serialization failures
+    if (options.deferrable.value_or(options.access == ::sqlpp::access_mode::read_only and
+                                    options.isolation == ::sqlpp::isolation_level::serializable))
+      add_mode("DEFERRABLE");
+    else if (options.deferrable)
+      add_mode("NOT DEFERRABLE");
+
+    return "START TRANSACTION" + modes;
+  }
+
   // direct execution
   inline auto config_field_to_string(std::string_view name, const std::optional<std::string>& value) -> std::string
   {
@@ -110,19 +270,56 @@ namespace sqlpp::postgresql::detail
     return value ? std::string(name) + "=" + std::to_string(*value) + " " : "";
   }
 
+  inline auto conninfo_of(const connection_config_t& config) -> std::string
+  {
+    auto conninfo = std::string{};
+    conninfo += detail::config_field_to_string("host", config.host);
+    conninfo += detail::config_field_to_string("hostaddr", config.hostaddr);
+    conninfo += detail::config_field_to_string("port", config.port);
+    conninfo += detail::config_field_to_string("dbname", config.dbname);
+    conninfo += detail::config_field_to_string("user", config.user);
+    conninfo += detail::config_field_to_string("password", config.password);
+    conninfo += detail::config_field_to_string("passfile", config.passfile);
+    conninfo += detail::config_field_to_string("connect_timeout", config.connect_timeout);
+    conninfo += detail::config_field_to_string("client_encoding", config.client_encoding);
+    conninfo += detail::config_field_to_string("options", config.options);
+    conninfo += detail::config_field_to_string("application_name", config.application_name);
+    conninfo += detail::config_field_to_string("fallback_application_name", config.fallback_application_name);
+    conninfo += detail::config_field_to_string("keepalives", config.keepalives);
+    conninfo += detail::config_field_to_string("keepalives_idle", config.keepalives_idle);
+    conninfo += detail::config_field_to_string("keepalives_interval", config.keepalives_interval);
+    conninfo += detail::config_field_to_string("keepalives_count", config.keepalives_count);
+    conninfo += detail::config_field_to_string("sslmode", config.sslmode);
+    conninfo += detail::config_field_to_string("sslcompression", config.sslcompression);
+    conninfo += detail::config_field_to_string("sslcert", config.sslcert);
+    conninfo += detail::config_field_to_string("sslkey", config.sslkey);
+    conninfo += detail::config_field_to_string("sslrootcert", config.sslrootcert);
+    conninfo += detail::config_field_to_string("sslcrl", config.sslcrl);
+    conninfo += detail::config_field_to_string("requirepeer", config.requirepeer);
+    conninfo += detail::config_field_to_string("krbsrvname", config.krbsrvname);
+    conninfo += detail::config_field_to_string("gsslib", config.gsslib);
+    conninfo += detail::config_field_to_string("service", config.service);
+    conninfo += detail::config_field_to_string("target_session_attrs", config.target_session_attrs);
+    return conninfo;
+  }
+
 }  // namespace sqlpp::postgresql::detail
 
 namespace sqlpp::postgresql
 {
-  template <typename Pool, ::sqlpp::debug Debug>
+  template <typename Pool, ::sqlpp::debug Debug, typename Instrumentation>
   class base_connection : public ::sqlpp::connection,
                           private ::sqlpp::pool_base<Pool>,
-                          private ::sqlpp::debug_base<Debug>
+                          private ::sqlpp::debug_base<Debug>,
+                          private ::sqlpp::instrumentation_base<Instrumentation>,
+                          private ::sqlpp::execution_limits_base
   {
     using _pool_base = ::sqlpp::pool_base<Pool>;
     using _debug_base = ::sqlpp::debug_base<Debug>;
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
     detail::unique_connection_ptr _handle;
-    bool _transaction_active = false;
+    std::size_t _transaction_depth = 0;
+    bool _parameterize_literals = false;
 
     mutable std::size_t _statement_index = 0;
 
@@ -136,55 +333,39 @@ namespace sqlpp::postgresql
 
     base_connection(const connection_config_t& config,
                  detail::unique_connection_ptr&& handle,
-                 Pool* connection_pool)
-        : _pool_base{connection_pool}, _debug_base{config.debug}, _handle{std::move(handle)}
+                 Pool* connection_pool,
+                 Instrumentation instrumentation)
+        : _pool_base{connection_pool},
+          _debug_base{config.debug},
+          _instrumentation_base{std::move(instrumentation)},
+          _handle{std::move(handle)},
+          _parameterize_literals{config.parameterize_literals}
     {
+      this->attach_connection(_handle.get());
     }
 
-    base_connection(const connection_config_t& config, Pool* connection_pool) : base_connection{config}
+    base_connection(const connection_config_t& config, Pool* connection_pool, Instrumentation instrumentation)
+        : base_connection{config, std::move(instrumentation)}
     {
       this->_connection_pool = connection_pool;
     }
 
   public:
+    using instrumentation_type = Instrumentation;
+
     base_connection() = delete;
-    base_connection(const connection_config_t& config) : _debug_base{config.debug}, _handle{nullptr, {}}
+    base_connection(const connection_config_t& config, Instrumentation instrumentation = {})
+        : _debug_base{config.debug},
+          _instrumentation_base{std::move(instrumentation)},
+          _handle{nullptr, {}},
+          _parameterize_literals{config.parameterize_literals}
     {
       if (config.pre_connect)
       {
         config.pre_connect(get());
       }
 
-      auto conninfo = std::string{};
-      conninfo += detail::config_field_to_string("host", config.host);
-      conninfo += detail::config_field_to_string("hostaddr", config.hostaddr);
-      conninfo += detail::config_field_to_string("port", config.port);
-      conninfo += detail::config_field_to_string("dbname", config.dbname);
-      conninfo += detail::config_field_to_string("user", config.user);
-      conninfo += detail::config_field_to_string("password", config.password);
-      conninfo += detail::config_field_to_string("passfile", config.passfile);
-      conninfo += detail::config_field_to_string("connect_timeout", config.connect_timeout);
-      conninfo += detail::config_field_to_string("client_encoding", config.client_encoding);
-      conninfo += detail::config_field_to_string("options", config.options);
-      conninfo += detail::config_field_to_string("application_name", config.application_name);
-      conninfo += detail::config_field_to_string("fallback_application_name", config.fallback_application_name);
-      conninfo += detail::config_field_to_string("keepalives", config.keepalives);
-      conninfo += detail::config_field_to_string("keepalives_idle", config.keepalives_idle);
-      conninfo += detail::config_field_to_string("keepalives_interval", config.keepalives_interval);
-      conninfo += detail::config_field_to_string("keepalives_count", config.keepalives_count);
-      conninfo += detail::config_field_to_string("sslmode", config.sslmode);
-      conninfo += detail::config_field_to_string("sslcompression", config.sslcompression);
-      conninfo += detail::config_field_to_string("sslcert", config.sslcert);
-      conninfo += detail::config_field_to_string("sslkey", config.sslkey);
-      conninfo += detail::config_field_to_string("sslrootcert", config.sslrootcert);
-      conninfo += detail::config_field_to_string("sslcrl", config.sslcrl);
-      conninfo += detail::config_field_to_string("requirepeer", config.requirepeer);
-      conninfo += detail::config_field_to_string("krbsrvname", config.krbsrvname);
-      conninfo += detail::config_field_to_string("gsslib", config.gsslib);
-      conninfo += detail::config_field_to_string("service", config.service);
-      conninfo += detail::config_field_to_string("target_session_attrs", config.target_session_attrs);
-
-      _handle.reset(PQconnectdb(conninfo.c_str()));
+      _handle.reset(PQconnectdb(detail::conninfo_of(config).c_str()));
 
       if (PQstatus(_handle.get()) != CONNECTION_OK)
       {
@@ -196,6 +377,8 @@ namespace sqlpp::postgresql
       {
         config.post_connect(_handle.get());
       }
+
+      this->attach_connection(_handle.get());
     }
     base_connection(const base_connection&) = delete;
     base_connection(base_connection&&) = default;
@@ -234,7 +417,9 @@ namespace sqlpp::postgresql
           auto result = detail::execute(*this, statement);
 
           using _result_type = char_result_t<result_row_of_t<Statement>>;
-          return ::sqlpp::result_t<_result_type>{_result_type{std::move(result)}};
+          auto handle = ::sqlpp::make_result_handle<Instrumentation>(_result_type{std::move(result)}, *this,
+                                                                      _hash_of<Statement>());
+          return ::sqlpp::result_t<decltype(handle)>{std::move(handle)};
         }
         else if constexpr (std::is_same_v<ResultType, execute_result>)
         {
@@ -265,37 +450,85 @@ namespace sqlpp::postgresql
       }
     }
 
-    auto start_transaction() -> void
+#ifdef LIBPQ_HAS_PIPELINING
+    // Statements sent through the pipeline do not wait for each other, see pipeline_t (requires libpq 14 or later)
+    [[nodiscard]] auto pipeline(const pipeline_config_t& config = {}) -> pipeline_t<base_connection>
     {
-      if (_transaction_active)
+      return pipeline_t<base_connection>{*this, config};
+    }
+#endif
+
+    // See ::sqlpp::explain. Note that explain_mode::analyze executes the statement.
+    template <typename... Clauses>
+    auto explain(const ::sqlpp::statement<Clauses...>& statement, ::sqlpp::explain_mode mode)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_preparable<base_connection>(type_v<Statement>); _check)
       {
-        throw sqlpp::exception("Postgresql: Cannot have more than one open transaction per connection");
+        return detail::explain(get(), to_sql_string_c(context_t{}, statement), mode);
       }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
 
-      detail::execute(*this, sqlpp::command("START TRANSACTION"));
-      _transaction_active = true;
+    // Transactions started while another one is open use savepoints, see ::sqlpp::transaction_t
+    auto start_transaction(const ::sqlpp::transaction_options& options = {}) -> void
+    {
+      if (_transaction_depth == 0)
+      {
+        detail::execute(*this, sqlpp::command(detail::begin_statement_of(options)));
+      }
+      else
+      {
+        detail::execute(*this, sqlpp::command("SAVEPOINT " + ::sqlpp::detail::savepoint_name(_transaction_depth)));
+      }
+      ++_transaction_depth;
     }
 
     auto commit() -> void
     {
-      if (not _transaction_active)
+      if (_transaction_depth == 0)
       {
         throw sqlpp::exception("Postgresql: Cannot commit without active transaction");
       }
 
-      _transaction_active = false;
+      // The depth only changes once the control statement succeeded, so that a failed commit can still be rolled back
+      if (_transaction_depth > 1)
+      {
+        detail::execute(*this,
+                        sqlpp::command("RELEASE SAVEPOINT " + ::sqlpp::detail::savepoint_name(_transaction_depth - 1)));
+        --_transaction_depth;
+        return;
+      }
       detail::execute(*this, sqlpp::command("COMMIT"));
+      _transaction_depth = 0;
     }
 
     auto rollback() -> void
     {
-      if (not _transaction_active)
+      if (_transaction_depth == 0)
       {
         throw sqlpp::exception("Postgresql: Cannot rollback without active transaction");
       }
 
-      _transaction_active = false;
-      detail::execute(*this, sqlpp::command("ROLLBACK"));
+      // Rolling back must work even after the deadline passed
+      if (_transaction_depth > 1)
+      {
+        const auto name = ::sqlpp::detail::savepoint_name(_transaction_depth - 1);
+        detail::execute(*this, sqlpp::command("ROLLBACK TO SAVEPOINT " + name), nullptr);
+        detail::execute(*this, sqlpp::command("RELEASE SAVEPOINT " + name), nullptr);
+        --_transaction_depth;
+        return;
+      }
+      detail::execute(*this, sqlpp::command("ROLLBACK"), nullptr);
+      _transaction_depth = 0;
+    }
+
+    [[nodiscard]] auto transaction_depth() const -> std::size_t
+    {
+      return _transaction_depth;
     }
 
     auto destroy_transaction() noexcept -> void
@@ -328,6 +561,36 @@ namespace sqlpp::postgresql
       }
     }
 
+    [[nodiscard]] auto parameterizes_literals() const -> bool
+    {
+      return _parameterize_literals;
+    }
+
+    // Use this to avoid formatting debug messages that nobody is going to see
+    auto is_debug_active() const -> bool
+    {
+      if constexpr (is_debug_allowed())
+      {
+        return static_cast<bool>(this->_debug);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    using _instrumentation_base::instrument;
+    using _instrumentation_base::instrumentation;
+    using _instrumentation_base::is_instrumented;
+
+    using execution_limits_base::clear_cancellation_token;
+    using execution_limits_base::clear_deadline;
+    using execution_limits_base::clear_statement_timeout;
+    using execution_limits_base::limits;
+    using execution_limits_base::set_cancellation_token;
+    using execution_limits_base::set_deadline;
+    using execution_limits_base::set_statement_timeout;
+
     auto* get() const
     {
       return _handle.get();
@@ -338,10 +601,30 @@ namespace sqlpp::postgresql
       return PQstatus(_handle.get()) == CONNECTION_OK;
     }
 
+    // The protocol counts the parameters of a statement in 16 bits
+    [[nodiscard]] auto max_statement_parameters() const -> std::size_t
+    {
+      return 65535;
+    }
+
     auto get_statement_index() const
     {
       return ++_statement_index;
     }
+
+  private:
+    template <typename Statement>
+    static constexpr auto _hash_of() -> std::uint32_t
+    {
+      if constexpr (is_instrumented())
+      {
+        return type_hash<Statement>();
+      }
+      else
+      {
+        return 0;
+      }
+    }
   };
 
 }  // namespace sqlpp::postgresql
@@ -68,6 +68,10 @@ namespace sqlpp::postgresql
 
     std::function<void(std::string_view)> debug;
 
+    // Directly executed statements send their literal values as parameters (via PQexecParams), so that the SQL
+    // text depends on the shape of the statement only, see ::sqlpp::parameterize
+    bool parameterize_literals = false;
+
     connection_config_t() = default;
     connection_config_t(const connection_config_t&) = default;
     connection_config_t(connection_config_t&& rhs) = default;
@@ -89,20 +89,25 @@ namespace sqlpp::postgresql::detail
 
 namespace sqlpp::postgresql
 {
-  template<::sqlpp::debug Debug>
+  template <::sqlpp::debug Debug, typename Instrumentation = ::sqlpp::no_instrumentation>
   class connection_pool_t
   {
     connection_config_t _connection_config;
     detail::circular_connection_buffer_t _handles;
     std::mutex _mutex;
+    Instrumentation _instrumentation;
 
-    using _connection_t = ::sqlpp::postgresql::base_connection<connection_pool_t, Debug>;
+    using _connection_t = ::sqlpp::postgresql::base_connection<connection_pool_t, Debug, Instrumentation>;
     friend _connection_t;
 
   public:
     connection_pool_t() = delete;
-    connection_pool_t(std::size_t capacity, connection_config_t connection_config)
-        : _connection_config(std::move(connection_config)), _handles(capacity)
+    connection_pool_t(std::size_t capacity,
+                      connection_config_t connection_config,
+                      Instrumentation instrumentation = {})
+        : _connection_config(std::move(connection_config)),
+          _handles(capacity),
+          _instrumentation(std::move(instrumentation))
     {
     }
     connection_pool_t(const connection_pool_t&) = delete;
@@ -124,8 +129,8 @@ namespace sqlpp::postgresql
         handle.reset();
       }
 
-      return handle ? _connection_t{_connection_config, std::move(handle), this}
-                    : _connection_t{_connection_config, this};
+      return handle ? _connection_t{_connection_config, std::move(handle), this, _instrumentation}
+                    : _connection_t{_connection_config, this, _instrumentation};
     }
 
   private:
@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <libpq-fe.h>
+
+#include <sqlpp17/cancellation.h>
+
+#include <sqlpp17/postgresql/char_result.h>
+
+namespace sqlpp::postgresql::detail
+{
+  struct cancel_cleanup_t
+  {
+    auto operator()(PGcancel* cancel) -> void
+    {
+      if (cancel)
+        PQfreeCancel(cancel);
+    }
+  };
+  using unique_cancel_ptr = std::unique_ptr<PGcancel, cancel_cleanup_t>;
+
+  // Runs blocking libpq calls. If the deadline of the statement passes or its cancellation token is cancelled
+  // meanwhile, the running query is cancelled via PQcancel and the server reports an error for it.
+  template <typename Call>
+  auto run_with_limits(PGconn* connection, ::sqlpp::execution_limits* limits, ::sqlpp::interrupt_reason& reason,
+                       Call&& call)
+  {
+    if (not limits or not limits->begin_statement())
+    {
+      return call();
+    }
+
+    // PQgetCancel must be called by the thread using the connection, PQcancel is thread-safe
+    const auto cancel = unique_cancel_ptr(PQgetCancel(connection));
+    const auto guard = ::sqlpp::detail::interrupt_guard{*limits, [handle = cancel.get()] {
+                                                          char message[256];
+                                                          PQcancel(handle, message, sizeof(message));
+                                                        }};
+    auto result = call();
+    reason = guard.reason();
+    return result;
+  }
+
+  template <typename Call>
+  auto call_with_limits(PGconn* connection, ::sqlpp::execution_limits* limits, ::sqlpp::interrupt_reason& reason,
+                        Call&& call) -> unique_result_ptr
+  {
+    return run_with_limits(connection, limits, reason, [&call] { return unique_result_ptr(call(), {}); });
+  }
+
+  // Queries cancelled by other means (e.g. the server's statement_timeout) report SQLSTATE 57014
+  inline auto interruption_of(const PGresult* result, ::sqlpp::interrupt_reason reason) -> ::sqlpp::interrupt_reason
+  {
+    if (reason != ::sqlpp::interrupt_reason::none)
+    {
+      return reason;
+    }
+
+    const auto* sql_state = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    return (sql_state and std::strcmp(sql_state, "57014") == 0) ? ::sqlpp::interrupt_reason::cancelled
+                                                                 : ::sqlpp::interrupt_reason::none;
+  }
+
+  inline auto error_code_of(const PGresult* result) -> ::sqlpp::error_code
+  {
+    const auto* sql_state = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+    if (not sql_state)
+      return ::sqlpp::error_code::unspecified;
+    if (std::strcmp(sql_state, "40001") == 0)
+      return ::sqlpp::error_code::serialization_failure;
+    if (std::strcmp(sql_state, "40P01") == 0)
+      return ::sqlpp::error_code::deadlock;
+    if (std::strcmp(sql_state, "55P03") == 0)
+      return ::sqlpp::error_code::lock_timeout;
+    return ::sqlpp::error_code::unspecified;
+  }
+
+  [[noreturn]] inline auto throw_execution_error(const PGresult* result,
+                                                 ::sqlpp::interrupt_reason reason,
+                                                 const std::string& message) -> void
+  {
+    if (const auto interruption = interruption_of(result, reason); interruption != ::sqlpp::interrupt_reason::none)
+    {
+      ::sqlpp::detail::throw_interrupted(interruption, message + PQresultErrorMessage(result));
+    }
+    throw ::sqlpp::exception(message + PQresultErrorMessage(result), error_code_of(result));
+  }
+}  // namespace sqlpp::postgresql::detail
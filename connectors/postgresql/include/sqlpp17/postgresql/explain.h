@@ -0,0 +1,296 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sqlpp17/exception.h>
+#include <sqlpp17/explain.h>
+
+#include <sqlpp17/postgresql/char_result.h>
+
+#include <libpq-fe.h>
+
+namespace sqlpp::postgresql::detail
+{
+  // Just enough JSON for the output of EXPLAIN (FORMAT JSON)
+  struct json_value
+  {
+    enum class kind
+    {
+      null,
+      boolean,
+      number,
+      string,
+      array,
+      object
+    };
+
+    kind type = kind::null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<json_value> elements;  // array elements or object values
+    std::vector<std::string> keys;     // object keys
+
+    [[nodiscard]] auto find(std::string_view key) const -> const json_value*
+    {
+      for (auto index = std::size_t{0}; index < keys.size(); ++index)
+      {
+        if (keys[index].compare(key) == 0)
+          return &elements[index];
+      }
+      return nullptr;
+    }
+  };
+
+  class json_parser
+  {
+    std::string_view _text;
+    std::size_t _pos = 0;
+
+    [[noreturn]] auto fail() const -> void
+    {
+      throw sqlpp::exception("Postgresql: Could not parse JSON plan at position " + std::to_string(_pos));
+    }
+
+    auto skip_whitespace() -> void
+    {
+      while (_pos < _text.size() and (_text[_pos] == ' ' or _text[_pos] == '\n' or _text[_pos] == '\r' or
+                                      _text[_pos] == '\t'))
+        ++_pos;
+    }
+
+    auto expect(char c) -> void
+    {
+      skip_whitespace();
+      if (_pos >= _text.size() or _text[_pos] != c)
+        fail();
+      ++_pos;
+    }
+
+    auto accept(char c) -> bool
+    {
+      skip_whitespace();
+      if (_pos < _text.size() and _text[_pos] == c)
+      {
+        ++_pos;
+        return true;
+      }
+      return false;
+    }
+
+    auto accept(std::string_view word) -> bool
+    {
+      if (_text.substr(_pos, word.size()).compare(word) == 0)
+      {
+        _pos += word.size();
+        return true;
+      }
+      return false;
+    }
+
+    auto parse_string() -> std::string
+    {
+      expect('"');
+      auto ret = std::string{};
+      while (_pos < _text.size() and _text[_pos] != '"')
+      {
+        if (_text[_pos] == '\\' and _pos + 1 < _text.size())
+        {
+          ++_pos;
+          switch (_text[_pos])
+          {
+            case 'n': ret += '\n'; break;
+            case 't': ret += '\t'; break;
+            case 'r': ret += '\r'; break;
+            case 'b': ret += '\b'; break;
+            case 'f': ret += '\f'; break;
+            case 'u':
+              // Plans are reported in the client encoding, escaped characters are control characters only
+              ret += '?';
+              _pos += 4;
+              break;
+            default: ret += _text[_pos];
+          }
+        }
+        else
+        {
+          ret += _text[_pos];
+        }
+        ++_pos;
+      }
+      expect('"');
+      return ret;
+    }
+
+  public:
+    json_parser(std::string_view text) : _text(text)
+    {
+    }
+
+    auto parse_value() -> json_value
+    {
+      auto value = json_value{};
+      skip_whitespace();
+      if (_pos >= _text.size())
+      {
+        fail();
+      }
+
+      switch (_text[_pos])
+      {
+        case '{':
+          value.type = json_value::kind::object;
+          expect('{');
+          if (accept('}'))
+            break;
+          do
+          {
+            value.keys.push_back(parse_string());
+            expect(':');
+            value.elements.push_back(parse_value());
+          } while (accept(','));
+          expect('}');
+          break;
+        case '[':
+          value.type = json_value::kind::array;
+          expect('[');
+          if (accept(']'))
+            break;
+          do
+          {
+            value.elements.push_back(parse_value());
+          } while (accept(','));
+          expect(']');
+          break;
+        case '"':
+          value.type = json_value::kind::string;
+          value.string = parse_string();
+          break;
+        default:
+          if (accept("true"))
+          {
+            value.type = json_value::kind::boolean;
+            value.boolean = true;
+          }
+          else if (accept("false"))
+          {
+            value.type = json_value::kind::boolean;
+          }
+          else if (accept("null"))
+          {
+            value.type = json_value::kind::null;
+          }
+          else
+          {
+            const auto* begin = _text.data() + _pos;
+            char* end = nullptr;
+            value.type = json_value::kind::number;
+            value.number = std::strtod(begin, &end);
+            if (end == begin)
+              fail();
+            _pos += static_cast<std::size_t>(end - begin);
+          }
+      }
+      return value;
+    }
+  };
+
+  inline auto make_plan_node(const json_value& plan) -> ::sqlpp::plan_node
+  {
+    auto node = ::sqlpp::plan_node{};
+    const auto string_of = [&plan](std::string_view key) {
+      const auto* value = plan.find(key);
+      return value ? value->string : std::string{};
+    };
+    const auto number_of = [&plan](std::string_view key) {
+      const auto* value = plan.find(key);
+      return value and value->type == json_value::kind::number ? std::optional<double>{value->number} : std::nullopt;
+    };
+
+    node.operation = string_of("Node Type");
+    node.relation = string_of("Relation Name");
+    node.index = string_of("Index Name");
+    node.full_scan = node.operation.compare("Seq Scan") == 0;
+    node.estimated_cost = number_of("Total Cost");
+    node.estimated_rows = number_of("Plan Rows");
+    node.actual_rows = number_of("Actual Rows");
+    node.actual_time_ms = number_of("Actual Total Time");
+    if (const auto* children = plan.find("Plans"))
+    {
+      for (const auto& child : children->elements)
+      {
+        node.children.push_back(make_plan_node(child));
+      }
+    }
+    return node;
+  }
+
+  // The output is an array with one object per statement, e.g.
+  //   [{"Plan": {"Node Type": "Seq Scan", "Relation Name": "tab_person", "Total Cost": 22.7, "Plan Rows": 1270}}]
+  inline auto parse_explain_json(std::string_view text) -> std::vector<::sqlpp::plan_node>
+  {
+    auto nodes = std::vector<::sqlpp::plan_node>{};
+    const auto json = json_parser{text}.parse_value();
+    for (const auto& statement : json.elements)
+    {
+      if (const auto* root = statement.find("Plan"))
+      {
+        nodes.push_back(make_plan_node(*root));
+      }
+    }
+    return nodes;
+  }
+
+  inline auto explain(PGconn* connection, const std::string& sql_string, ::sqlpp::explain_mode mode)
+      -> ::sqlpp::query_plan
+  {
+    const auto explain_string =
+        std::string(mode == ::sqlpp::explain_mode::analyze ? "EXPLAIN (ANALYZE, FORMAT JSON) " : "EXPLAIN (FORMAT JSON) ") +
+        sql_string;
+    const auto result = detail::unique_result_ptr(PQexec(connection, explain_string.c_str()), {});
+    if (not result or PQresultStatus(result.get()) != PGRES_TUPLES_OK)
+    {
+      throw sqlpp::exception(std::string("Postgresql: Could not explain statement: ") +
+                             (result ? PQresultErrorMessage(result.get()) : "out of memory") + " (statement was >>" +
+                             sql_string + "<<\n");
+    }
+
+    auto plan = ::sqlpp::query_plan{};
+    plan.sql = sql_string;
+    for (auto row = 0; row < PQntuples(result.get()); ++row)
+    {
+      plan.raw += PQgetvalue(result.get(), row, 0);
+    }
+    plan.nodes = parse_explain_json(plan.raw);
+    return plan;
+  }
+}  // namespace sqlpp::postgresql::detail
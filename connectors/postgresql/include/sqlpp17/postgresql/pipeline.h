@@ -0,0 +1,515 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <libpq-fe.h>
+
+#ifndef LIBPQ_HAS_PIPELINING
+#error "sqlpp17/postgresql/pipeline.h requires libpq 14 or later"
+#endif
+
+#include <sqlpp17/cancellation.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/instrumentation.h>
+#include <sqlpp17/result.h>
+#include <sqlpp17/statement.h>
+#include <sqlpp17/type_hash.h>
+
+#include <sqlpp17/postgresql/char_result.h>
+#include <sqlpp17/postgresql/context.h>
+#include <sqlpp17/postgresql/execution_limits.h>
+#include <sqlpp17/postgresql/prepared_statement.h>
+
+namespace sqlpp::postgresql
+{
+  // Reported by the statements of a pipeline batch that did not fail themselves, but were aborted or rolled back
+  // because another statement of the batch failed. The error code is the one of the failing statement.
+  class pipeline_aborted_exception : public ::sqlpp::exception
+  {
+  public:
+    using ::sqlpp::exception::exception;
+  };
+
+  struct pipeline_config_t
+  {
+    // Statements are synced automatically once that many are queued. Keeps the server from blocking on results
+    // that nobody reads while the client is still sending.
+    std::size_t max_batch_size = 256;
+  };
+}  // namespace sqlpp::postgresql
+
+namespace sqlpp::postgresql::detail
+{
+  class pipeline_base
+  {
+  public:
+    virtual ~pipeline_base() = default;
+    virtual auto sync() -> void = 0;
+  };
+
+  class pipeline_entry
+  {
+    std::uint32_t _statement_hash;
+    std::string _description;
+
+  public:
+    pipeline_entry(std::uint32_t statement_hash, std::string description)
+        : _statement_hash{statement_hash}, _description{std::move(description)}
+    {
+    }
+    pipeline_entry(const pipeline_entry&) = delete;
+    pipeline_entry& operator=(const pipeline_entry&) = delete;
+    virtual ~pipeline_entry() = default;
+
+    auto statement_hash() const
+    {
+      return _statement_hash;
+    }
+
+    auto& description() const
+    {
+      return _description;
+    }
+
+    virtual auto complete(unique_result_ptr result) -> void = 0;
+    virtual auto fail(std::exception_ptr error) -> void = 0;
+    virtual auto is_done() const -> bool = 0;
+  };
+
+  // Cancels what is left of a batch that is not going to be read (e.g. because its deadline passed before it was
+  // synced) and skips its results, so that the connection can leave pipeline mode.
+  inline auto abandon_pipeline_batch(PGconn* connection) -> void
+  {
+    if (PQstatus(connection) != CONNECTION_OK)
+    {
+      return;
+    }
+
+    if (const auto cancel = unique_cancel_ptr(PQgetCancel(connection)))
+    {
+      char message[256];
+      PQcancel(cancel.get(), message, sizeof(message));
+    }
+
+    // Results of statements are separated by nullptr, two in a row mean that there is nothing left to read
+    auto previous_was_null = false;
+    while (PQstatus(connection) == CONNECTION_OK)
+    {
+      const auto result = unique_result_ptr(PQgetResult(connection), {});
+      if (not result)
+      {
+        if (previous_was_null)
+          return;
+        previous_was_null = true;
+        continue;
+      }
+      previous_was_null = false;
+      if (PQresultStatus(result.get()) == PGRES_PIPELINE_SYNC)
+      {
+        return;
+      }
+    }
+  }
+
+  template <typename ResultType, typename ResultRow, typename Instrumentation>
+  class typed_pipeline_entry : public pipeline_entry, private ::sqlpp::instrumentation_base<Instrumentation>
+  {
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
+
+  public:
+    using value_type = decltype(statement_result<ResultType, ResultRow>(
+        std::declval<unique_result_ptr>(), std::declval<const _instrumentation_base&>(), std::uint32_t{}));
+
+  private:
+    std::optional<value_type> _value;
+    std::exception_ptr _error;
+
+  public:
+    typed_pipeline_entry(Instrumentation instrumentation, std::uint32_t statement_hash, std::string description)
+        : pipeline_entry{statement_hash, std::move(description)}, _instrumentation_base{std::move(instrumentation)}
+    {
+    }
+
+    auto complete(unique_result_ptr result) -> void override
+    {
+      _value.emplace(statement_result<ResultType, ResultRow>(std::move(result), *this, statement_hash()));
+    }
+
+    auto fail(std::exception_ptr error) -> void override
+    {
+      _error = std::move(error);
+    }
+
+    auto is_done() const -> bool override
+    {
+      return _value.has_value() or static_cast<bool>(_error);
+    }
+
+    auto take() -> value_type
+    {
+      if (_error)
+      {
+        std::rethrow_exception(_error);
+      }
+      auto value = std::move(*_value);
+      _value.reset();
+      return value;
+    }
+  };
+}  // namespace sqlpp::postgresql::detail
+
+namespace sqlpp::postgresql
+{
+  // The outcome of a statement sent through a pipeline. get() syncs the pipeline if the statement is still
+  // queued, and then returns what executing the statement directly would have returned, or throws its error.
+  // get() can be called once.
+  template <typename Entry>
+  class pipeline_result_t
+  {
+    std::shared_ptr<Entry> _entry;
+    detail::pipeline_base* _pipeline = nullptr;
+
+  public:
+    using value_type = typename Entry::value_type;
+
+    pipeline_result_t() = default;
+    pipeline_result_t(std::shared_ptr<Entry> entry, detail::pipeline_base& pipeline)
+        : _entry{std::move(entry)}, _pipeline{&pipeline}
+    {
+    }
+
+    [[nodiscard]] auto is_ready() const -> bool
+    {
+      return _entry and _entry->is_done();
+    }
+
+    [[nodiscard]] auto get() -> value_type
+    {
+      if (not _entry)
+      {
+        throw ::sqlpp::exception("Postgresql: pipeline result has already been retrieved");
+      }
+      if (not _entry->is_done())
+      {
+        _pipeline->sync();
+      }
+      const auto entry = std::move(_entry);
+      return entry->take();
+    }
+  };
+
+  // Sends statements to the server without waiting for the results of the previous ones, using libpq's pipeline
+  // mode. Results are read in order when the pipeline is synced, so that a whole batch of statements costs a
+  // single network round trip.
+  //
+  // Each batch (the statements between two syncs) is all or nothing: If one of its statements fails, that
+  // statement reports its error, and all other statements of the batch report a pipeline_aborted_exception.
+  // Outside of a transaction, the server rolls back the whole batch in that case. Inside a transaction, the
+  // transaction is aborted and has to be rolled back.
+  //
+  // While the pipeline exists, the connection must not be used for anything else. The destructor syncs
+  // statements that are still queued, without reporting their errors.
+  template <typename Connection>
+  class pipeline_t : public detail::pipeline_base,
+                     private ::sqlpp::instrumentation_base<typename Connection::instrumentation_type>
+  {
+    using Instrumentation = typename Connection::instrumentation_type;
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
+
+    Connection& _connection;
+    pipeline_config_t _config;
+    std::vector<std::shared_ptr<detail::pipeline_entry>> _queued;
+
+    template <typename ResultType, typename ResultRow>
+    using _entry_t = detail::typed_pipeline_entry<ResultType, ResultRow, Instrumentation>;
+
+    template <typename Entry, typename Send>
+    auto enqueue(std::shared_ptr<Entry> entry, Send&& send) -> pipeline_result_t<Entry>
+    {
+      if (not send())
+      {
+        throw ::sqlpp::exception("Postgresql: could not send pipelined statement " + entry->description() + ": " +
+                                 PQerrorMessage(_connection.get()));
+      }
+      _queued.push_back(entry);
+
+      auto result = pipeline_result_t<Entry>{std::move(entry), *this};
+      if (_queued.size() >= _config.max_batch_size)
+      {
+        sync();
+      }
+      return result;
+    }
+
+    auto fail_queued(const std::exception_ptr& error) -> void
+    {
+      for (std::size_t i = 0; i < _queued.size(); ++i)
+      {
+        _queued[i]->fail(error);
+      }
+      _queued.clear();
+    }
+
+    auto read_batch() -> std::vector<detail::unique_result_ptr>
+    {
+      auto* const connection = _connection.get();
+      auto results = std::vector<detail::unique_result_ptr>{};
+      results.reserve(_queued.size());
+      for (std::size_t i = 0; i < _queued.size(); ++i)
+      {
+        auto result = detail::unique_result_ptr(PQgetResult(connection), {});
+        if (not result)
+        {
+          throw ::sqlpp::exception("Postgresql: missing pipeline result: " + std::string(PQerrorMessage(connection)));
+        }
+        // Each statement's result is followed by a nullptr
+        while (auto extra = detail::unique_result_ptr(PQgetResult(connection), {}))
+        {
+        }
+        results.push_back(std::move(result));
+      }
+
+      const auto sync_result = detail::unique_result_ptr(PQgetResult(connection), {});
+      if (not sync_result or PQresultStatus(sync_result.get()) != PGRES_PIPELINE_SYNC)
+      {
+        throw ::sqlpp::exception("Postgresql: missing pipeline sync: " + std::string(PQerrorMessage(connection)));
+      }
+      return results;
+    }
+
+    auto report_end([[maybe_unused]] const detail::pipeline_entry& entry, [[maybe_unused]] PGresult* result) const
+        -> void
+    {
+      if constexpr (_instrumentation_base::is_instrumented())
+      {
+        this->instrument(::sqlpp::execute_end_event{entry.statement_hash(), detail::affected_rows(result),
+                                                    ::sqlpp::instrumentation_clock::now()});
+      }
+    }
+
+  public:
+    pipeline_t(Connection& connection, const pipeline_config_t& config = {})
+        : _instrumentation_base{connection.instrumentation()}, _connection{connection}, _config{config}
+    {
+      if (_config.max_batch_size == 0)
+      {
+        throw ::sqlpp::exception("Postgresql: pipeline max_batch_size must be positive");
+      }
+      if (PQenterPipelineMode(_connection.get()) != 1)
+      {
+        throw ::sqlpp::exception("Postgresql: could not enter pipeline mode: " +
+                                 std::string(PQerrorMessage(_connection.get())));
+      }
+      if (_connection.is_debug_active())
+        _connection.debug("Entered pipeline mode");
+    }
+    pipeline_t(const pipeline_t&) = delete;
+    pipeline_t(pipeline_t&&) = delete;
+    pipeline_t& operator=(const pipeline_t&) = delete;
+    pipeline_t& operator=(pipeline_t&&) = delete;
+    ~pipeline_t() override
+    {
+      try
+      {
+        sync();
+      }
+      catch (...)
+      {
+        // We must not throw in the destructor
+      }
+      PQexitPipelineMode(_connection.get());
+      if (_connection.is_debug_active())
+        _connection.debug("Exited pipeline mode");
+    }
+
+    // Queues a statement, see connection::operator()
+    template <typename... Clauses>
+    auto operator()(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_executable<Connection>(type_v<Statement>); _check)
+      {
+        [[maybe_unused]] const auto serialization_start =
+            ::sqlpp::instrumentation_now<_instrumentation_base::is_instrumented()>();
+        const auto sql_string = to_sql_string_c(context_t{}, statement);
+        const auto statement_hash = _instrumentation_base::is_instrumented() ? type_hash<Statement>() : 0;
+
+        if (_connection.is_debug_active())
+          _connection.debug("Pipelining: '" + sql_string + "'");
+
+        if constexpr (_instrumentation_base::is_instrumented())
+        {
+          const auto now = ::sqlpp::instrumentation_clock::now();
+          this->instrument(::sqlpp::execute_start_event{statement_hash, sql_string, now - serialization_start, now});
+        }
+
+        using _entry = _entry_t<result_type_of_t<Statement>, result_row_of_t<Statement>>;
+        // PQsendQuery is not allowed in pipeline mode
+        return enqueue(std::make_shared<_entry>(this->instrumentation(), statement_hash, ">>" + sql_string + "<<"),
+                       [&] {
+                         return PQsendQueryParams(_connection.get(), sql_string.c_str(), 0, nullptr, nullptr,
+                                                  nullptr, nullptr, 0);
+                       });
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+
+    // Queues the execution of a prepared statement with its current parameters, see prepared_statement_t::execute
+    template <typename ResultType, typename ParameterVector, typename ResultRow>
+    auto operator()(prepared_statement_t<ResultType, ParameterVector, ResultRow, Instrumentation>& statement)
+    {
+      if (statement.get_connection() != _connection.get())
+      {
+        throw ::sqlpp::exception("Postgresql: prepared statement " + statement.get_name() +
+                                 " belongs to another connection than the pipeline");
+      }
+
+      if (_connection.is_debug_active())
+        _connection.debug("Pipelining prepared statement " + statement.get_name());
+
+      if constexpr (_instrumentation_base::is_instrumented())
+        this->instrument(::sqlpp::execute_start_event{statement.get_statement_hash(), {}, {},
+                                                      ::sqlpp::instrumentation_clock::now()});
+
+      ::sqlpp::postgresql::bind_parameters(statement.get_parameter_strings(), statement.get_parameter_pointers(),
+                                           statement.parameters);
+      using _entry = _entry_t<ResultType, ResultRow>;
+      // The parameters are copied into libpq's buffer right away, so they can be changed for the next execution
+      return enqueue(std::make_shared<_entry>(this->instrumentation(), statement.get_statement_hash(),
+                                              "(statement name " + statement.get_name() + ")"),
+                     [&] {
+                       const auto& pointers = statement.get_parameter_pointers();
+                       return PQsendQueryPrepared(_connection.get(), statement.get_name().c_str(), pointers.size(),
+                                                  pointers.data(), nullptr, nullptr, 0);
+                     });
+    }
+
+    [[nodiscard]] auto queued() const -> std::size_t
+    {
+      return _queued.size();
+    }
+
+    // Ends the current batch and waits for the results of its statements.
+    // Errors of statements are reported by their results. Throws if the connection fails, or if the deadline or
+    // cancellation token of the connection interrupts reading the results (all statements of the batch fail then).
+    auto sync() -> void override
+    {
+      if (_queued.empty())
+      {
+        return;
+      }
+
+      auto* const connection = _connection.get();
+      if (PQpipelineSync(connection) != 1)
+      {
+        fail_queued(std::make_exception_ptr(::sqlpp::exception("Postgresql: could not sync pipeline: " +
+                                                               std::string(PQerrorMessage(connection)))));
+        throw ::sqlpp::exception("Postgresql: could not sync pipeline: " + std::string(PQerrorMessage(connection)));
+      }
+
+      auto reason = ::sqlpp::interrupt_reason::none;
+      auto results = std::vector<detail::unique_result_ptr>{};
+      try
+      {
+        results = detail::run_with_limits(connection, _connection.limits(), reason, [&] { return read_batch(); });
+      }
+      catch (...)
+      {
+        fail_queued(std::current_exception());
+        detail::abandon_pipeline_batch(connection);
+        throw;
+      }
+
+      auto failed = std::optional<std::size_t>{};
+      for (std::size_t i = 0; i < results.size() and not failed; ++i)
+      {
+        const auto status = PQresultStatus(results[i].get());
+        if (status != PGRES_COMMAND_OK and status != PGRES_TUPLES_OK)
+        {
+          failed = i;
+        }
+      }
+
+      if (not failed)
+      {
+        for (std::size_t i = 0; i < _queued.size(); ++i)
+        {
+          report_end(*_queued[i], results[i].get());
+          _queued[i]->complete(std::move(results[i]));
+        }
+        _queued.clear();
+        return;
+      }
+
+      const auto& failing = *_queued[*failed];
+      const auto* failed_result = results[*failed].get();
+      if constexpr (_instrumentation_base::is_instrumented())
+        this->instrument(::sqlpp::error_event{failing.statement_hash(), PQresultErrorMessage(failed_result),
+                                              ::sqlpp::instrumentation_clock::now()});
+
+      const auto aborted = std::make_exception_ptr(pipeline_aborted_exception(
+          "Postgresql: pipeline batch aborted by the failure of " + failing.description() + ": " +
+              PQresultErrorMessage(failed_result),
+          detail::error_code_of(failed_result)));
+      for (std::size_t i = 0; i < _queued.size(); ++i)
+      {
+        if (i != *failed)
+        {
+          _queued[i]->fail(aborted);
+          continue;
+        }
+        try
+        {
+          detail::throw_execution_error(
+              failed_result, reason,
+              "Postgresql: Error during pipelined execution of " + failing.description() + ": ");
+        }
+        catch (...)
+        {
+          _queued[i]->fail(std::current_exception());
+        }
+      }
+      _queued.clear();
+    }
+  };
+
+  template <typename Connection>
+  pipeline_t(Connection&, const pipeline_config_t&)->pipeline_t<Connection>;
+
+  template <typename Connection>
+  pipeline_t(Connection&)->pipeline_t<Connection>;
+}  // namespace sqlpp::postgresql
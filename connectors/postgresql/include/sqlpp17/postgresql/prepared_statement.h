@@ -34,7 +34,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <libpq-fe.h>
 
+#include <sqlpp17/cancellation.h>
+#include <sqlpp17/instrumentation.h>
 #include <sqlpp17/prepared_statement_parameters.h>
+#include <sqlpp17/type_hash.h>
+
+#include <sqlpp17/postgresql/execution_limits.h>
 
 namespace sqlpp::postgresql
 {
@@ -113,6 +118,43 @@ namespace sqlpp::postgresql
            ++index));
   }
 
+  namespace detail
+  {
+    // Turns the result of a successfully executed statement into what executing it returns
+    template <typename ResultType, typename ResultRow, typename Instrumentation>
+    auto statement_result(unique_result_ptr result,
+                          const ::sqlpp::instrumentation_base<Instrumentation>& instrumented,
+                          std::uint32_t statement_hash)
+    {
+      if constexpr (std::is_same_v<ResultType, insert_result>)
+      {
+        return PQoidValue(result.get());
+      }
+      else if constexpr (std::is_same_v<ResultType, delete_result>)
+      {
+        return std::strtoll(PQcmdTuples(result.get()), nullptr, 10);
+      }
+      else if constexpr (std::is_same_v<ResultType, update_result>)
+      {
+        return std::strtoll(PQcmdTuples(result.get()), nullptr, 10);
+      }
+      else if constexpr (std::is_same_v<ResultType, select_result>)
+      {
+        auto handle = ::sqlpp::make_result_handle<Instrumentation>(char_result_t<ResultRow>{std::move(result)},
+                                                                    instrumented, statement_hash);
+        return ::sqlpp::result_t<decltype(handle)>{std::move(handle)};
+      }
+      else if constexpr (std::is_same_v<ResultType, execute_result>)
+      {
+        return std::strtoll(PQcmdTuples(result.get()), nullptr, 10);
+      }
+      else
+      {
+        static_assert(wrong<ResultType>, "Unknown statement result type");
+      }
+    }
+  }  // namespace detail
+
   /* PGprepare CAN be informed about the nature of parameters using OIDs from pg_type.h
      e.g. TEXTOID or INT4OID
      However, it seems easier to pass type information in the query via $1:bigint for
@@ -120,11 +162,18 @@ namespace sqlpp::postgresql
      Caveat: We need to store all parameters as strings. And postgresql then has to
              parse those strings.
   */
-  template<typename ResultType, typename ParameterVector, typename ResultRow>
-  class prepared_statement_t
+  template <typename ResultType,
+            typename ParameterVector,
+            typename ResultRow,
+            typename Instrumentation = ::sqlpp::no_instrumentation>
+  class prepared_statement_t : private ::sqlpp::instrumentation_base<Instrumentation>
   {
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
+
     std::string _name;
     unique_prepared_statement_ptr _connection;
+    ::sqlpp::execution_limits* _limits = nullptr;
+    std::uint32_t _statement_hash = 0;
 
     std::array<std::string, ParameterVector::size()> _parameter_strings;
     std::array<char*, ParameterVector::size()> _parameter_pointers;
@@ -135,14 +184,25 @@ namespace sqlpp::postgresql
     prepared_statement_t() = default;
     template <typename Connection, typename Statement>
     prepared_statement_t(const Connection& connection, const Statement& statement)
-        : _name(std::to_string(connection.get_statement_index()) + "at" + std::to_string(::time(nullptr))),
-          _connection(connection.get(), {_name})
+        : _instrumentation_base{connection.instrumentation()},
+          _name(std::to_string(connection.get_statement_index()) + "at" + std::to_string(::time(nullptr))),
+          _connection(connection.get(), {_name}),
+          _limits(connection.limits())
     {
+      [[maybe_unused]] const auto serialization_start =
+          ::sqlpp::instrumentation_now<_instrumentation_base::is_instrumented()>();
       const auto sql_string = to_sql_string_c(context_t{}, statement);
 
-      if constexpr (Connection::is_debug_allowed())
+      if (connection.is_debug_active())
         connection.debug("Preparing " + _name + ": '" + sql_string + "'");
 
+      if constexpr (_instrumentation_base::is_instrumented())
+      {
+        _statement_hash = type_hash<Statement>();
+        const auto now = ::sqlpp::instrumentation_clock::now();
+        this->instrument(::sqlpp::prepare_start_event{_statement_hash, sql_string, now - serialization_start, now});
+      }
+
       auto result = detail::unique_result_ptr(
           PQprepare(connection.get(), _name.c_str(), sql_string.c_str(), ParameterVector::size(), nullptr), {});
 
@@ -156,8 +216,13 @@ namespace sqlpp::postgresql
         case PGRES_COMMAND_OK:
           [[fallthrough]];
         case PGRES_TUPLES_OK:
+          if constexpr (_instrumentation_base::is_instrumented())
+            this->instrument(::sqlpp::prepare_end_event{_statement_hash, ::sqlpp::instrumentation_clock::now()});
           break;
         default:
+          if constexpr (_instrumentation_base::is_instrumented())
+            this->instrument(::sqlpp::error_event{_statement_hash, PQresultErrorMessage(result.get()),
+                                                  ::sqlpp::instrumentation_clock::now()});
           throw sqlpp::exception(std::string("Postgresql: Error during query preparation: ") +
                                  PQresultErrorMessage(result.get()) + " (query was >>" + sql_string + "<<\n");
       }
@@ -170,12 +235,15 @@ namespace sqlpp::postgresql
 
     auto execute()
     {
+      if constexpr (_instrumentation_base::is_instrumented())
+        this->instrument(::sqlpp::execute_start_event{_statement_hash, {}, {}, ::sqlpp::instrumentation_clock::now()});
+
       ::sqlpp::postgresql::bind_parameters(_parameter_strings, _parameter_pointers, parameters);
-      auto result = detail::unique_result_ptr(
-          PQexecPrepared(_connection.get(), _name.c_str(),
-                         _parameter_pointers.size(),
-                         _parameter_pointers.data(), nullptr, nullptr, 0),
-          {});
+      auto reason = ::sqlpp::interrupt_reason::none;
+      auto result = detail::call_with_limits(_connection.get(), _limits, reason, [&] {
+        return PQexecPrepared(_connection.get(), _name.c_str(), _parameter_pointers.size(),
+                              _parameter_pointers.data(), nullptr, nullptr, 0);
+      });
 
       if (not result)
       {
@@ -187,37 +255,20 @@ namespace sqlpp::postgresql
         case PGRES_COMMAND_OK:
           [[fallthrough]];
         case PGRES_TUPLES_OK:
+          if constexpr (_instrumentation_base::is_instrumented())
+            this->instrument(::sqlpp::execute_end_event{_statement_hash, detail::affected_rows(result.get()),
+                                                        ::sqlpp::instrumentation_clock::now()});
           break;
         default:
-          throw sqlpp::exception(std::string("Postgresql: Error during prepared statement execution: ") +
-                                 PQresultErrorMessage(result.get()) + " (statement name " +
-                                 _name + ")\n");
+          if constexpr (_instrumentation_base::is_instrumented())
+            this->instrument(::sqlpp::error_event{_statement_hash, PQresultErrorMessage(result.get()),
+                                                  ::sqlpp::instrumentation_clock::now()});
+          detail::throw_execution_error(
+              result.get(), reason,
+              "Postgresql: Error during prepared statement execution (statement name " + _name + "): ");
       }
 
-      if constexpr (std::is_same_v<ResultType, insert_result>)
-      {
-        return PQoidValue(result.get());
-      }
-      else if constexpr (std::is_same_v<ResultType, delete_result>)
-      {
-        return std::strtoll(PQcmdTuples(result.get()), nullptr, 10);
-      }
-      else if constexpr (std::is_same_v<ResultType, update_result>)
-      {
-        return std::strtoll(PQcmdTuples(result.get()), nullptr, 10);
-      }
-      else if constexpr (std::is_same_v<ResultType, select_result>)
-      {
-        return ::sqlpp::result_t<char_result_t<ResultRow>>{std::move(result)};
-      }
-      else if constexpr (std::is_same_v<ResultType, execute_result>)
-      {
-        return std::strtoll(PQcmdTuples(result.get()), nullptr, 10);
-      }
-      else
-      {
-        static_assert(wrong<ResultType>, "Unknown statement result type");
-      }
+      return detail::statement_result<ResultType, ResultRow>(std::move(result), *this, _statement_hash);
     }
 
     auto* get_connection() const
@@ -230,6 +281,11 @@ namespace sqlpp::postgresql
       return _name;
     }
 
+    auto get_statement_hash() const
+    {
+      return _statement_hash;
+    }
+
     auto get_number_of_parameters() const
     {
       return _parameter_pointers.size();
@@ -253,10 +309,13 @@ namespace sqlpp::postgresql
 
   template <typename Connection, typename Statement>
   prepared_statement_t(const Connection&, const Statement&)
-      ->prepared_statement_t<result_type_of_t<Statement>, parameters_of_t<Statement>, result_row_of_t<Statement>>;
+      ->prepared_statement_t<result_type_of_t<Statement>,
+                             parameters_of_t<Statement>,
+                             result_row_of_t<Statement>,
+                             typename Connection::instrumentation_type>;
 
-  template <typename ResultType, typename ParameterVector, typename ResultRow>
-  auto execute(prepared_statement_t<ResultType, ParameterVector, ResultRow>& statement)
+  template <typename ResultType, typename ParameterVector, typename ResultRow, typename Instrumentation>
+  auto execute(prepared_statement_t<ResultType, ParameterVector, ResultRow, Instrumentation>& statement)
   {
     return statement.execute();
   }
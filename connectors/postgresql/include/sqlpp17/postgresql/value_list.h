@@ -0,0 +1,137 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sqlpp17/embrace.h>
+#include <sqlpp17/operator/in.h>
+#include <sqlpp17/operator/not_in.h>
+#include <sqlpp17/to_sql_string.h>
+#include <sqlpp17/type_traits.h>
+#include <sqlpp17/value_list.h>
+
+#include <sqlpp17/postgresql/context.h>
+
+namespace sqlpp::postgresql::detail
+{
+  // Lists of other types are expanded, see ::sqlpp::detail::value_list_to_sql_string
+  template <typename T>
+  [[nodiscard]] constexpr auto array_type_of() -> const char*
+  {
+    if constexpr (std::is_same_v<T, bool>)
+      return "BOOLEAN[]";
+    else if constexpr (::sqlpp::is_integral_v<T>)
+      return "BIGINT[]";
+    else if constexpr (::sqlpp::is_text_v<T> and not std::is_same_v<T, char>)
+      return "TEXT[]";
+    else
+      return nullptr;
+  }
+
+  // The text representation of an array, e.g. {1,2,3} or {"a","b\"c"}
+  template <typename T>
+  [[nodiscard]] auto array_to_text(const std::vector<T>& values) -> std::string
+  {
+    auto ret = std::string{"{"};
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      if (i > 0)
+        ret.push_back(',');
+
+      if constexpr (std::is_same_v<T, bool>)
+      {
+        ret += values[i] ? "t" : "f";
+      }
+      else if constexpr (::sqlpp::is_integral_v<T>)
+      {
+        ret += std::to_string(values[i]);
+      }
+      else
+      {
+        ret.push_back('"');
+        for (const auto c : std::string_view{values[i]})
+        {
+          if (c == '"' or c == '\\')
+            ret.push_back('\\');
+          ret.push_back(c);
+        }
+        ret.push_back('"');
+      }
+    }
+    ret.push_back('}');
+    return ret;
+  }
+
+  // The whole list is a single value, and thus a single parameter with parameterized literals
+  template <typename L, typename T>
+  [[nodiscard]] auto array_comparison_to_sql_string(context_t& context,
+                                                    const L& l,
+                                                    const value_list_t<T>& list,
+                                                    std::string_view comparison) -> std::string
+  {
+    auto ret = to_sql_string(context, embrace(l));
+    ret += comparison;
+    ret += "(CAST(";
+    ret += to_sql_string(context, std::string_view{array_to_text(list.values)});
+    ret += " AS ";
+    ret += array_type_of<T>();
+    ret += "))";
+    return ret;
+  }
+}  // namespace sqlpp::postgresql::detail
+
+namespace sqlpp
+{
+  template <typename L, typename T>
+  [[nodiscard]] auto to_sql_string(postgresql::context_t& context, const in_t<L, value_list_t<T>>& t)
+  {
+    if constexpr (postgresql::detail::array_type_of<T>() != nullptr)
+    {
+      return postgresql::detail::array_comparison_to_sql_string(context, t.l, std::get<0>(t.args), " = ANY");
+    }
+    else
+    {
+      return detail::value_list_to_sql_string(context, t.l, std::get<0>(t.args), " IN(", " OR ", "1 = 0");
+    }
+  }
+
+  template <typename L, typename T>
+  [[nodiscard]] auto to_sql_string(postgresql::context_t& context, const not_in_t<L, value_list_t<T>>& t)
+  {
+    if constexpr (postgresql::detail::array_type_of<T>() != nullptr)
+    {
+      return postgresql::detail::array_comparison_to_sql_string(context, t.l, std::get<0>(t.args), " <> ALL");
+    }
+    else
+    {
+      return detail::value_list_to_sql_string(context, t.l, std::get<0>(t.args), " NOT IN(", " AND ", "1 = 1");
+    }
+  }
+}  // namespace sqlpp
@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <sqlpp17/clause/bulk_update.h>
+#include <sqlpp17/literal_parameters.h>
+
+#include <serialize/assert_equality.h>
+#include <sqlpp17/postgresql/connection.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::postgresql::context_t;
+using ::sqlpp::test::assert_equality;
+using ::test::tabPerson;
+
+int main()
+{
+  try
+  {
+    const auto bulk =
+        bulk_update(tabPerson, tabPerson.id, tabPerson.name, tabPerson.address)
+            .rows(std::vector{std::tuple{1, std::string("Ada"), std::optional<std::string>{}},
+                              std::tuple{2, std::string("Bjarne"), std::optional<std::string>{"Aarhus"}}});
+
+    // Values are joined, the first row determines the column types
+    assert_equality("UPDATE tab_person SET name = bulk_update_values.name, address = bulk_update_values.address "
+                    "FROM (VALUES (CAST(1 AS BIGINT), CAST('Ada' AS VARCHAR(255)), CAST(NULL AS VARCHAR(255))), "
+                    "(2, 'Bjarne', 'Aarhus')) AS bulk_update_values (id, name, address) "
+                    "WHERE tab_person.id = bulk_update_values.id",
+                    to_sql_string_c(context_t{}, bulk));
+
+    const auto parameterized = ::sqlpp::parameterize<context_t>(bulk);
+    assert_equality("UPDATE tab_person SET name = bulk_update_values.name, address = bulk_update_values.address "
+                    "FROM (VALUES (CAST($1 AS BIGINT), CAST($2 AS VARCHAR(255)), CAST(NULL AS VARCHAR(255))), "
+                    "($3, $4, $5)) AS bulk_update_values (id, name, address) "
+                    "WHERE tab_person.id = bulk_update_values.id",
+                    parameterized.sql);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+}
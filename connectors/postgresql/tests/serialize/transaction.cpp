@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include <sqlpp17/transaction.h>
+
+#include <serialize/assert_equality.h>
+#include <sqlpp17/postgresql/connection.h>
+
+using ::sqlpp::postgresql::detail::begin_statement_of;
+using ::sqlpp::test::assert_equality;
+
+int main()
+{
+  try
+  {
+    assert_equality("START TRANSACTION", begin_statement_of({}));
+    assert_equality("START TRANSACTION ISOLATION LEVEL REPEATABLE READ, READ ONLY",
+                    begin_statement_of({::sqlpp::read_only, ::sqlpp::isolation_level::repeatable_read}));
+    assert_equality("START TRANSACTION ISOLATION LEVEL SERIALIZABLE",
+                    begin_statement_of({::sqlpp::read_write, ::sqlpp::isolation_level::serializable}));
+
+    // Read only serializable transactions are deferrable unless requested otherwise
+    assert_equality("START TRANSACTION ISOLATION LEVEL SERIALIZABLE, READ ONLY, DEFERRABLE",
+                    begin_statement_of({::sqlpp::read_only, ::sqlpp::isolation_level::serializable}));
+    assert_equality("START TRANSACTION ISOLATION LEVEL SERIALIZABLE, READ ONLY, NOT DEFERRABLE",
+                    begin_statement_of({::sqlpp::read_only, ::sqlpp::isolation_level::serializable, false}));
+    assert_equality("START TRANSACTION READ ONLY, DEFERRABLE",
+                    begin_statement_of({::sqlpp::read_only, ::sqlpp::isolation_level::current, true}));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+}
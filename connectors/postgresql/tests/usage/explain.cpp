@@ -0,0 +1,123 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+
+#include <sqlpp17/exception.h>
+#include <sqlpp17/postgresql/explain.h>
+#include <sqlpp17_test/assert_true.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  // EXPLAIN (ANALYZE, FORMAT JSON) SELECT ... FROM tab_person JOIN tab_department ... WHERE tab_department.id = 1
+  constexpr auto analyzed_plan = R"json([
+  {
+    "Plan": {
+      "Node Type": "Nested Loop",
+      "Parallel Aware": false,
+      "Startup Cost": 0.15,
+      "Total Cost": 33.47,
+      "Plan Rows": 6,
+      "Plan Width": 516,
+      "Actual Startup Time": 0.011,
+      "Actual Total Time": 0.012,
+      "Actual Rows": 1,
+      "Actual Loops": 1,
+      "Plans": [
+        {
+          "Node Type": "Index Scan",
+          "Parent Relationship": "Outer",
+          "Scan Direction": "Forward",
+          "Index Name": "tab_department_pkey",
+          "Relation Name": "tab_department",
+          "Alias": "tab_department",
+          "Total Cost": 8.17,
+          "Plan Rows": 1,
+          "Index Cond": "(id = 1)",
+          "Actual Total Time": 0.005,
+          "Actual Rows": 1
+        },
+        {
+          "Node Type": "Seq Scan",
+          "Parent Relationship": "Inner",
+          "Relation Name": "tab_person",
+          "Alias": "tab_person",
+          "Total Cost": 25.24,
+          "Plan Rows": 6,
+          "Filter": "(department = 1) AND (name <> 'a \"quoted\" name')",
+          "Actual Total Time": 0.002,
+          "Actual Rows": 0
+        }
+      ]
+    },
+    "Planning Time": 0.128,
+    "Triggers": [],
+    "Execution Time": 0.031
+  }
+])json";
+}  // namespace
+
+int main()
+{
+  try
+  {
+    const auto nodes = ::sqlpp::postgresql::detail::parse_explain_json(analyzed_plan);
+    assert_true(nodes.size() == 1, "root");
+
+    const auto& join = nodes.front();
+    assert_true(join.operation.compare("Nested Loop") == 0 and join.relation.empty(), "join");
+    assert_true(join.estimated_cost == 33.47 and join.estimated_rows == 6.0, "join estimates");
+    assert_true(join.actual_rows == 1.0 and join.actual_time_ms == 0.012, "join actuals");
+    assert_true(join.children.size() == 2, "join children");
+
+    const auto& index_scan = join.children[0];
+    assert_true(index_scan.index.compare("tab_department_pkey") == 0, "index scan index");
+    assert_true(index_scan.relation.compare("tab_department") == 0 and not index_scan.full_scan, "index scan");
+
+    const auto& seq_scan = join.children[1];
+    assert_true(seq_scan.full_scan and seq_scan.index.empty() and seq_scan.actual_rows == 0.0, "seq scan");
+
+    auto plan = ::sqlpp::query_plan{};
+    plan.nodes = nodes;
+    assert_true(plan.has_full_scan() and plan.uses_index("tab_department_pkey"), "query plan");
+
+    try
+    {
+      [[maybe_unused]] const auto broken = ::sqlpp::postgresql::detail::parse_explain_json(R"([{"Plan": {"Node Type": )");
+      assert_true(false, "missing exception");
+    }
+    catch (const ::sqlpp::exception&)
+    {
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
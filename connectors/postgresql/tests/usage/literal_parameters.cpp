@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#include <sqlpp17/clause/create_table.h>
+#include <sqlpp17/clause/drop_table.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/postgresql/connection.h>
+#include <sqlpp17/postgresql_test/get_config.h>
+
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+
+namespace postgresql = ::sqlpp::postgresql;
+using ::test::tabDepartment;
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    auto config = postgresql::test::get_config();
+    config.parameterize_literals = true;
+    auto db = postgresql::connection_t<::sqlpp::debug::allowed>{config};
+
+    db(drop_table(tabDepartment));
+    // DDL keeps its literals, the DEFAULT of tab_department.division must not become a parameter
+    db(create_table(tabDepartment));
+
+    // Text is sent as is, without escaping
+    for (const auto* name : {"one", "it's", "back\\slash"})
+    {
+      db(insert_into(tabDepartment).set(tabDepartment.name = name));
+    }
+
+    auto found = 0;
+    for (const auto& row : db(select(tabDepartment.id, tabDepartment.name)
+                                  .from(tabDepartment)
+                                  .where(tabDepartment.name == "it's" and tabDepartment.id > 0)))
+    {
+      const std::optional<std::string_view> name = row.name;
+      assert_true(name and *name == "it's", "selected name");
+      ++found;
+    }
+    assert_true(found == 1, "selected row");
+
+    assert_true(db(update(tabDepartment).set(tabDepartment.name = "two").where(tabDepartment.id >= 2.5)) == 1,
+                "update");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+
+#include <sqlpp17/clause/command.h>
+#include <sqlpp17/clause/create_table.h>
+#include <sqlpp17/clause/drop_table.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/parameter.h>
+
+#include <sqlpp17/postgresql/connection.h>
+#include <sqlpp17/postgresql_test/get_config.h>
+
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+
+namespace postgresql = ::sqlpp::postgresql;
+using ::test::tabDepartment;
+
+SQLPP_CREATE_NAME_TAG(pName);
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    const auto config = postgresql::test::get_config();
+    auto db = postgresql::connection_t<::sqlpp::debug::allowed>{config};
+
+    db(drop_table(tabDepartment));
+    db(create_table(tabDepartment));
+
+    // Results are returned in order, once the batch is synced
+    {
+      auto pipeline = db.pipeline();
+      auto prepared =
+          db.prepare(insert_into(tabDepartment).set(tabDepartment.name = ::sqlpp::parameter<std::string>(pName)));
+
+      auto first = pipeline(insert_into(tabDepartment).default_values());
+      prepared.parameters.pName = "one";
+      auto second = pipeline(prepared);
+      prepared.parameters.pName = "two";
+      auto third = pipeline(prepared);
+      auto rows = pipeline(select(tabDepartment.id).from(tabDepartment).unconditionally());
+      assert_true(pipeline.queued() == 4 and not first.is_ready(), "queued");
+
+      pipeline.sync();
+      assert_true(pipeline.queued() == 0 and first.is_ready() and rows.is_ready(), "synced");
+      [[maybe_unused]] const auto id = first.get();
+      [[maybe_unused]] const auto second_id = second.get();
+      [[maybe_unused]] const auto third_id = third.get();
+
+      auto count = 0;
+      for ([[maybe_unused]] const auto& row : rows.get())
+      {
+        ++count;
+      }
+      assert_true(count == 3, "selected rows");
+    }
+
+    // get() syncs if necessary, and the batch size limit syncs automatically
+    {
+      auto pipeline = db.pipeline({2});
+      auto first = pipeline(insert_into(tabDepartment).default_values());
+      assert_true(not first.is_ready(), "not synced yet");
+      auto second = pipeline(insert_into(tabDepartment).default_values());
+      assert_true(first.is_ready() and second.is_ready() and pipeline.queued() == 0, "synced automatically");
+      auto third = pipeline(insert_into(tabDepartment).default_values());
+      [[maybe_unused]] const auto id = third.get();
+      [[maybe_unused]] const auto first_id = first.get();
+    }
+
+    // A failing statement aborts its whole batch
+    {
+      auto pipeline = db.pipeline();
+      auto before = pipeline(insert_into(tabDepartment).default_values());
+      auto failing = pipeline(sqlpp::command("SELECT 1/0"));
+      auto after = pipeline(insert_into(tabDepartment).default_values());
+      pipeline.sync();
+
+      try
+      {
+        [[maybe_unused]] const auto result = failing.get();
+        assert_true(false, "missing error");
+      }
+      catch (const postgresql::pipeline_aborted_exception&)
+      {
+        assert_true(false, "failing statement reported as aborted");
+      }
+      catch (const ::sqlpp::exception&)
+      {
+      }
+
+      for (auto* aborted : {&before, &after})
+      {
+        try
+        {
+          [[maybe_unused]] const auto id = aborted->get();
+          assert_true(false, "missing abort");
+        }
+        catch (const postgresql::pipeline_aborted_exception&)
+        {
+        }
+      }
+
+      // The next batch is not affected
+      auto next = pipeline(insert_into(tabDepartment).default_values());
+      [[maybe_unused]] const auto id = next.get();
+    }
+
+    // The connection can be used normally once the pipeline is gone
+    auto count = 0;
+    for ([[maybe_unused]] const auto& row : db(select(tabDepartment.id).from(tabDepartment).unconditionally()))
+    {
+      ++count;
+    }
+    assert_true(count == 7, "rows after pipelines");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
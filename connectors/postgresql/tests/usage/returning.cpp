@@ -0,0 +1,96 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <sqlpp17/clause/create_table.h>
+#include <sqlpp17/clause/delete_from.h>
+#include <sqlpp17/clause/drop_table.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/postgresql/connection.h>
+#include <sqlpp17/postgresql_test/get_config.h>
+
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+
+namespace postgresql = ::sqlpp::postgresql;
+using ::test::tabDepartment;
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    auto db = postgresql::connection_t<::sqlpp::debug::allowed>{postgresql::test::get_config()};
+
+    db(drop_table(tabDepartment));
+    db(create_table(tabDepartment));
+
+    // Generated keys come back with the insert, without a second round trip
+    auto ids = std::vector<std::int64_t>{};
+    for (const auto* name : {"one", "two"})
+    {
+      for (const auto& row : db(insert_into(tabDepartment).set(tabDepartment.name = name).returning(tabDepartment.id)))
+      {
+        ids.push_back(row.id);
+      }
+    }
+    assert_true(ids.size() == 2 and ids[0] < ids[1], "generated keys");
+
+    auto updated = 0;
+    for (const auto& row : db(update(tabDepartment)
+                                  .set(tabDepartment.name = "three")
+                                  .where(tabDepartment.id == ids[1])
+                                  .returning(tabDepartment.id, tabDepartment.name)))
+    {
+      const std::optional<std::string_view> name = row.name;
+      assert_true(row.id == ids[1] and name and *name == "three", "updated row");
+      ++updated;
+    }
+    assert_true(updated == 1, "updated rows");
+
+    auto deleted = 0;
+    for ([[maybe_unused]] const auto& row :
+         db(delete_from(tabDepartment).where(tabDepartment.id == ids[0]).returning(tabDepartment.id)))
+    {
+      ++deleted;
+    }
+    assert_true(deleted == 1, "deleted rows");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -27,4 +27,5 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <sqlpp17/sqlite3/clause/create_table.h>
+#include <sqlpp17/sqlite3/clause/on_conflict.h>
 #include <sqlpp17/sqlite3/clause/truncate.h>
@@ -27,32 +27,60 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <functional>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
 
+#include <sqlpp17/cancellation.h>
 #include <sqlpp17/connection.h>
 #include <sqlpp17/exception.h>
+#include <sqlpp17/literal_parameters.h>
 #include <sqlpp17/result.h>
 #include <sqlpp17/statement.h>
+#include <sqlpp17/transaction.h>
 #include <sqlpp17/clause/command.h>
 
 #include <sqlpp17/sqlite3/clause.h>
 #include <sqlpp17/sqlite3/connection_config.h>
 #include <sqlpp17/sqlite3/context.h>
+#include <sqlpp17/sqlite3/explain.h>
 #include <sqlpp17/sqlite3/parameter.h>
 #include <sqlpp17/sqlite3/prepared_statement.h>
 #include <sqlpp17/sqlite3/prepared_statement_result.h>
+#include <sqlpp17/sqlite3/profiler.h>
+#include <sqlpp17/sqlite3/value_list.h>
 
 namespace sqlpp::sqlite3
 {
-  template <typename Pool, ::sqlpp::debug Debug>
+  template <typename Pool, ::sqlpp::debug Debug, typename Instrumentation = ::sqlpp::no_instrumentation>
   class base_connection;
 
-  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed>
-  using connection_t = base_connection<no_pool, Debug>;
+  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed, typename Instrumentation = ::sqlpp::no_instrumentation>
+  using connection_t = base_connection<no_pool, Debug, Instrumentation>;
 };  // namespace sqlpp::sqlite3
 
 namespace sqlpp::sqlite3::detail
 {
+  inline auto begin_statement_of(const ::sqlpp::transaction_options& options) -> std::string
+  {
+    // Readers do not need write locks
+    if (options.access == ::sqlpp::access_mode::read_only)
+    {
+      return "BEGIN DEFERRED";
+    }
+
+    switch (options.begin)
+    {
+      case ::sqlpp::begin_mode::immediate:
+        return "BEGIN IMMEDIATE";
+      case ::sqlpp::begin_mode::exclusive:
+        return "BEGIN EXCLUSIVE";
+      default:
+        return "BEGIN TRANSACTION";
+    }
+  }
+
   struct connection_cleanup_t
   {
   public:
@@ -71,16 +99,28 @@ namespace sqlpp::sqlite3::detail
 
 namespace sqlpp::sqlite3
 {
-  template<typename Pool, ::sqlpp::debug Debug>
+  template<typename Pool, ::sqlpp::debug Debug, typename Instrumentation>
   class base_connection : public ::sqlpp::connection,
                           private ::sqlpp::pool_base<Pool>,
-                          private ::sqlpp::debug_base<Debug>
+                          private ::sqlpp::debug_base<Debug>,
+                          private ::sqlpp::instrumentation_base<Instrumentation>,
+                          private ::sqlpp::execution_limits_base
   {
     using _pool_base = ::sqlpp::pool_base<Pool>;
     using _debug_base = ::sqlpp::debug_base<Debug>;
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
 
     detail::unique_connection_ptr _handle;
-    bool _transaction_active = false;
+    statement_profiler* _profiler = nullptr;
+    // Directly executed statements with parameterized literals, see connection_config_t::parameterize_literals
+    std::shared_ptr<detail::statement_cache> _statement_cache;
+    std::size_t _transaction_depth = 0;
+    bool _read_only_transaction = false;
+
+    using _control_statement =
+        prepared_statement_t<::sqlpp::execute_result, ::sqlpp::type_vector<>, ::sqlpp::none_t, Instrumentation>;
+    // Transaction control statements, prepared on first use
+    std::unordered_map<std::string, _control_statement> _control_statements;
 
     template <typename... Clauses>
     friend class ::sqlpp::statement;
@@ -92,19 +132,34 @@ namespace sqlpp::sqlite3
 
     base_connection(const connection_config_t& config,
                  detail::unique_connection_ptr&& handle,
-                 Pool* connection_pool)
-        : _pool_base{connection_pool}, _debug_base{config.debug}, _handle{std::move(handle)}
+                 Pool* connection_pool,
+                 Instrumentation instrumentation)
+        : _pool_base{connection_pool},
+          _debug_base{config.debug},
+          _instrumentation_base{std::move(instrumentation)},
+          _handle{std::move(handle)},
+          _profiler{config.profiler},
+          _statement_cache{make_statement_cache(config)}
     {
+      this->attach_connection(_handle.get());
     }
 
-    base_connection(const connection_config_t& config, Pool* connection_pool) : base_connection{config}
+    base_connection(const connection_config_t& config, Pool* connection_pool, Instrumentation instrumentation)
+        : base_connection{config, std::move(instrumentation)}
     {
       this->_connection_pool = connection_pool;
     }
 
   public:
+    using instrumentation_type = Instrumentation;
+
     base_connection() = delete;
-    base_connection(const connection_config_t& config) : _debug_base{config.debug}, _handle{nullptr, {}}
+    base_connection(const connection_config_t& config, Instrumentation instrumentation = {})
+        : _debug_base{config.debug},
+          _instrumentation_base{std::move(instrumentation)},
+          _handle{nullptr, {}},
+          _profiler{config.profiler},
+          _statement_cache{make_statement_cache(config)}
     {
       ::sqlite3* connection_ptr = nullptr;
       const auto rc = sqlite3_open_v2(config.path_to_database.c_str(), &connection_ptr, config.flags,
@@ -133,6 +188,8 @@ namespace sqlpp::sqlite3
       {
         config.post_connect(_handle.get());
       }
+
+      this->attach_connection(_handle.get());
     }
 
     base_connection(const base_connection&) = delete;
@@ -143,14 +200,22 @@ namespace sqlpp::sqlite3
     {
       if constexpr (not std::is_same_v<Pool, ::sqlpp::no_pool>)
       {
-        if (this->_connection_pool)
+        if (this->_connection_pool and _handle)
+        {
+          _control_statements.clear();
+          _statement_cache.reset();
+          // The progress handler refers to the limits of this connection
+          sqlite3_progress_handler(_handle.get(), 0, nullptr, nullptr);
           this->_connection_pool->put(std::move(_handle));
+        }
       }
     }
 
     auto operator()(const std::string& sql_string)
     {
-      auto prepared_statement = prepared_statement_t<::sqlpp::execute_result, ::sqlpp::type_vector<>, ::sqlpp::none_t>{*this, sql_string, detail::result_owns_statement{true}};
+      auto prepared_statement =
+          prepared_statement_t<::sqlpp::execute_result, ::sqlpp::type_vector<>, ::sqlpp::none_t, Instrumentation>{
+              *this, sql_string, detail::result_owns_statement{true}};
       prepared_statement.execute();
     }
 
@@ -206,41 +271,115 @@ namespace sqlpp::sqlite3
       }
     }
 
-    auto start_transaction() -> void
+    // See ::sqlpp::explain. Sqlite3 reports the plan only, without estimates.
+    template <typename... Clauses>
+    auto explain(const ::sqlpp::statement<Clauses...>& statement, ::sqlpp::explain_mode mode)
     {
-      if (_transaction_active)
+      using Statement = ::sqlpp::statement<Clauses...>;
+      if constexpr (constexpr auto _check = check_statement_preparable<base_connection>(type_v<Statement>); _check)
+      {
+        if (mode == ::sqlpp::explain_mode::analyze)
+        {
+          throw sqlpp::exception("Sqlite3: Cannot explain with explain_mode::analyze");
+        }
+        return detail::explain_query_plan(get(), to_sql_string_c(context_t{}, statement));
+      }
+      else
       {
-        throw sqlpp::exception("Sqlite3: Cannot have more than one open transaction per connection");
+        return ::sqlpp::bad_expression_t{_check};
       }
+    }
 
-      auto prepared_statement =
-          prepared_statement_t{*this, ::sqlpp::command("BEGIN TRANSACTION"), detail::result_owns_statement{true}};
-      prepared_statement.execute();
-      _transaction_active = true;
+    // Transactions started while another one is open use savepoints, see ::sqlpp::transaction_t
+    auto start_transaction(const ::sqlpp::transaction_options& options = {}) -> void
+    {
+      if (_transaction_depth == 0)
+      {
+        execute_control(detail::begin_statement_of(options));
+        if (options.access == ::sqlpp::access_mode::read_only)
+        {
+          try
+          {
+            execute_control("PRAGMA query_only = 1");
+          }
+          catch (...)
+          {
+            execute_control("ROLLBACK");
+            throw;
+          }
+          _read_only_transaction = true;
+        }
+      }
+      else
+      {
+        execute_control("SAVEPOINT " + ::sqlpp::detail::savepoint_name(_transaction_depth));
+      }
+      ++_transaction_depth;
     }
 
     auto commit() -> void
     {
-      if (not _transaction_active)
+      if (_transaction_depth == 0)
       {
         throw sqlpp::exception("Sqlite3: Cannot commit without active transaction");
       }
 
-      _transaction_active = false;
-      auto prepared_statement = prepared_statement_t{*this, ::sqlpp::command("COMMIT"), detail::result_owns_statement{true}};
-      prepared_statement.execute();
+      // The depth only changes once the control statement succeeded, so that a failed commit can still be rolled back
+      if (_transaction_depth > 1)
+      {
+        execute_control("RELEASE " + ::sqlpp::detail::savepoint_name(_transaction_depth - 1));
+        --_transaction_depth;
+        return;
+      }
+
+      const auto read_only = _read_only_transaction;
+      end_read_only_transaction();
+      try
+      {
+        execute_control("COMMIT");
+      }
+      catch (...)
+      {
+        // A failed COMMIT (e.g. SQLITE_BUSY) leaves the transaction open, it can be retried or rolled back.
+        // Only some errors make sqlite3 roll back by itself.
+        if (sqlite3_get_autocommit(get()))
+        {
+          _transaction_depth = 0;
+        }
+        else if (read_only)
+        {
+          execute_control("PRAGMA query_only = 1");
+          _read_only_transaction = true;
+        }
+        throw;
+      }
+      _transaction_depth = 0;
     }
 
     auto rollback() -> void
     {
-      if (not _transaction_active)
+      if (_transaction_depth == 0)
       {
         throw sqlpp::exception("Sqlite3: Cannot rollback without active transaction");
       }
 
-      _transaction_active = false;
-      auto prepared_statement = prepared_statement_t{*this, ::sqlpp::command("ROLLBACK"), detail::result_owns_statement{true}};
-      prepared_statement.execute();
+      if (_transaction_depth > 1)
+      {
+        const auto name = ::sqlpp::detail::savepoint_name(_transaction_depth - 1);
+        execute_control("ROLLBACK TO " + name);
+        execute_control("RELEASE " + name);
+        --_transaction_depth;
+        return;
+      }
+
+      end_read_only_transaction();
+      execute_control("ROLLBACK");
+      _transaction_depth = 0;
+    }
+
+    [[nodiscard]] auto transaction_depth() const -> std::size_t
+    {
+      return _transaction_depth;
     }
 
     auto destroy_transaction() noexcept -> void
@@ -273,46 +412,147 @@ namespace sqlpp::sqlite3
       }
     }
 
+    // Use this to avoid formatting debug messages that nobody is going to see
+    auto is_debug_active() const -> bool
+    {
+      if constexpr (is_debug_allowed())
+      {
+        return static_cast<bool>(this->_debug);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    using _instrumentation_base::instrument;
+    using _instrumentation_base::instrumentation;
+    using _instrumentation_base::is_instrumented;
+
+    using execution_limits_base::clear_cancellation_token;
+    using execution_limits_base::clear_deadline;
+    using execution_limits_base::clear_statement_timeout;
+    using execution_limits_base::limits;
+    using execution_limits_base::set_cancellation_token;
+    using execution_limits_base::set_deadline;
+    using execution_limits_base::set_statement_timeout;
+
     auto* get() const
     {
       return _handle.get();
     }
 
+    auto* profiler() const
+    {
+      return _profiler;
+    }
+
     auto is_alive() -> bool;
 
+    // Bound parameters per statement, SQLITE_MAX_VARIABLE_NUMBER unless lowered via sqlite3_limit()
+    [[nodiscard]] auto max_statement_parameters() const -> std::size_t
+    {
+      return static_cast<std::size_t>(sqlite3_limit(_handle.get(), SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+    }
+
   private:
+    static auto make_statement_cache(const connection_config_t& config) -> std::shared_ptr<detail::statement_cache>
+    {
+      return config.parameterize_literals ? std::make_shared<detail::statement_cache>(config.statement_cache_size)
+                                          : nullptr;
+    }
+
+    // Prepares directly executed statements, with parameterized literals if configured
+    template <typename Statement>
+    auto prepare_direct(const Statement& statement)
+    {
+      using _prepared_statement_t = prepared_statement_t<result_type_of_t<Statement>, parameters_of_t<Statement>,
+                                                         result_row_of_t<Statement>, Instrumentation>;
+      if (not _statement_cache or not ::sqlpp::is_literal_parameterizable_v<Statement>)
+      {
+        return _prepared_statement_t{*this, statement, detail::result_owns_statement{true}};
+      }
+
+      [[maybe_unused]] const auto serialization_start =
+          ::sqlpp::instrumentation_now<_instrumentation_base::is_instrumented()>();
+      const auto parameterized = ::sqlpp::parameterize<context_t>(statement);
+      auto prepared_statement = [&]() {
+        if (auto* handle = _statement_cache->take(parameterized.sql))
+        {
+          return _prepared_statement_t{*this, detail::unique_prepared_statement_ptr{handle, {true, _statement_cache}},
+                                       type_hash<Statement>()};
+        }
+        auto prepared = _prepared_statement_t{*this, parameterized.sql, detail::result_owns_statement{true},
+                                              type_hash<Statement>(), serialization_start};
+        prepared.cache_in(_statement_cache, parameterized.sql);
+        return prepared;
+      }();
+      bind_literals(prepared_statement.get(), parameterized.literals);
+      return prepared_statement;
+    }
+
+    // Transaction control statements are not subject to execution limits. Sqlite3 could not interrupt syncing
+    // a COMMIT anyway, and rolling back must always be possible.
+    auto execute_control(const std::string& sql) -> void
+    {
+      auto [statement, inserted] = _control_statements.try_emplace(sql);
+      if (inserted)
+      {
+        try
+        {
+          statement->second = _control_statement{*this, sql, detail::result_owns_statement{true}};
+          statement->second.ignore_execution_limits();
+        }
+        catch (...)
+        {
+          _control_statements.erase(statement);
+          throw;
+        }
+      }
+      statement->second.execute();
+    }
+
+    auto end_read_only_transaction() -> void
+    {
+      if (_read_only_transaction)
+      {
+        execute_control("PRAGMA query_only = 0");
+        _read_only_transaction = false;
+      }
+    }
+
     template <typename... Clauses>
     auto execute(const ::sqlpp::statement<Clauses...>& statement)
     {
-      auto prepared_statement = prepare(statement);
+      auto prepared_statement = prepare_direct(statement);
       prepared_statement.execute();
     }
 
     template <typename Statement>
     auto insert(const Statement& statement)
     {
-      auto prepared_statement = prepare(statement);
+      auto prepared_statement = prepare_direct(statement);
       return prepared_statement.execute();
     }
 
     template <typename Statement>
     auto update(const Statement& statement)
     {
-      auto prepared_statement = prepare(statement);
+      auto prepared_statement = prepare_direct(statement);
       return prepared_statement.execute();
     }
 
     template <typename Statement>
     auto delete_from(const Statement& statement)
     {
-      auto prepared_statement = prepare(statement);
+      auto prepared_statement = prepare_direct(statement);
       return prepared_statement.execute();
     }
 
     template <typename Statement>
     [[nodiscard]] auto select(const Statement& statement)
     {
-      auto prepared_statement = ::sqlpp::sqlite3::prepared_statement_t{*this, statement, detail::result_owns_statement{true}};
+      auto prepared_statement = prepare_direct(statement);
       return prepared_statement.execute();
     }
 
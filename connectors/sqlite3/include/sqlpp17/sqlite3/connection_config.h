@@ -34,6 +34,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace sqlpp::sqlite3
 {
+  class statement_profiler;
+
   struct connection_config_t
   {
     std::function<void(::sqlite3*)> post_connect;
@@ -42,6 +44,12 @@ namespace sqlpp::sqlite3
     int flags = 0;
     std::string vfs;
     std::function<void(std::string_view)> debug;
+    statement_profiler* profiler = nullptr;  // optional, see profiler.h
+
+    // Directly executed statements bind their literal values as parameters and reuse prepared statements with
+    // the same SQL text, see ::sqlpp::parameterize. Up to statement_cache_size statements are kept per connection.
+    bool parameterize_literals = false;
+    std::size_t statement_cache_size = 64;
 
     connection_config_t() = default;
     connection_config_t(const connection_config_t&) = default;
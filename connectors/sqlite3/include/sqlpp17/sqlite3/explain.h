@@ -0,0 +1,141 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sqlpp17/exception.h>
+#include <sqlpp17/explain.h>
+
+#include <sqlpp17/sqlite3/prepared_statement_result.h>
+
+namespace sqlpp::sqlite3::detail
+{
+  // Interprets the detail column of EXPLAIN QUERY PLAN, e.g.
+  //   SCAN tab_person
+  //   SEARCH tab_person USING INDEX idx_name (name=?)
+  //   SEARCH tab_person USING INTEGER PRIMARY KEY (rowid=?)
+  //   USE TEMP B-TREE FOR ORDER BY
+  inline auto make_plan_node(std::string_view detail) -> ::sqlpp::plan_node
+  {
+    auto node = ::sqlpp::plan_node{};
+    node.operation = std::string(detail);
+
+    const auto is_scan = detail.substr(0, 5).compare("SCAN ") == 0;
+    const auto is_search = detail.substr(0, 7).compare("SEARCH ") == 0;
+    if (not is_scan and not is_search)
+    {
+      return node;
+    }
+
+    auto rest = detail.substr(is_scan ? 5 : 7);
+    if (rest.substr(0, 6).compare("TABLE ") == 0)  // before sqlite 3.36
+    {
+      rest.remove_prefix(6);
+    }
+    node.relation = std::string(rest.substr(0, rest.find(' ')));
+
+    if (const auto pos = rest.find(" INTEGER PRIMARY KEY"); pos != rest.npos)
+    {
+      node.index = "INTEGER PRIMARY KEY";
+    }
+    else if (const auto pos = rest.find(" INDEX "); pos != rest.npos)
+    {
+      const auto name = rest.substr(pos + 7);
+      node.index = std::string(name.substr(0, name.find(' ')));
+    }
+
+    node.full_scan = is_scan and node.index.empty();
+    return node;
+  }
+
+  inline auto explain_query_plan(::sqlite3* connection, const std::string& sql_string) -> ::sqlpp::query_plan
+  {
+    auto plan = ::sqlpp::query_plan{};
+    plan.sql = sql_string;
+
+    const auto explain_string = "EXPLAIN QUERY PLAN " + sql_string;
+    ::sqlite3_stmt* statement_ptr = nullptr;
+    if (const auto rc = sqlite3_prepare_v2(connection, explain_string.c_str(), static_cast<int>(explain_string.size()),
+                                           &statement_ptr, nullptr);
+        rc != SQLITE_OK)
+    {
+      throw sqlpp::exception("Sqlite3 error: Could not explain statement: " + std::string(sqlite3_errmsg(connection)) +
+                             " (statement was >>" + sql_string + "<<\n");
+    }
+    const auto statement = unique_prepared_statement_ptr(statement_ptr, {true});
+
+    // Rows are id, parent, notused, detail. Parents are reported before their children.
+    struct row_t
+    {
+      int id;
+      int parent;
+      ::sqlpp::plan_node node;
+    };
+    auto rows = std::vector<row_t>{};
+    while (true)
+    {
+      const auto rc = sqlite3_step(statement.get());
+      if (rc == SQLITE_DONE)
+        break;
+      if (rc != SQLITE_ROW)
+      {
+        throw sqlpp::exception("Sqlite3 error: Could not explain statement: " +
+                               std::string(sqlite3_errmsg(connection)));
+      }
+
+      const auto* detail = reinterpret_cast<const char*>(sqlite3_column_text(statement.get(), 3));
+      plan.raw += std::string(detail ? detail : "") + '\n';
+      rows.push_back({sqlite3_column_int(statement.get(), 0), sqlite3_column_int(statement.get(), 1),
+                      make_plan_node(detail ? detail : "")});
+    }
+
+    // Attach children bottom-up, so that each node is complete before it is moved into its parent
+    for (auto index = rows.size(); index-- > 0;)
+    {
+      auto& row = rows[index];
+      auto parent = rows.begin();
+      while (parent != rows.begin() + static_cast<std::ptrdiff_t>(index) and parent->id != row.parent)
+        ++parent;
+
+      if (row.parent != 0 and parent != rows.begin() + static_cast<std::ptrdiff_t>(index))
+      {
+        parent->node.children.insert(parent->node.children.begin(), std::move(row.node));
+        row.id = -1;  // moved
+      }
+    }
+    for (auto& row : rows)
+    {
+      if (row.id != -1)
+        plan.nodes.push_back(std::move(row.node));
+    }
+
+    return plan;
+  }
+}  // namespace sqlpp::sqlite3::detail
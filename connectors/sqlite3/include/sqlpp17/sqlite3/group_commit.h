@@ -0,0 +1,334 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <sqlpp17/exception.h>
+#include <sqlpp17/materialize.h>
+#include <sqlpp17/statement.h>
+#include <sqlpp17/transaction.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+
+namespace sqlpp::sqlite3
+{
+  struct group_commit_config_t
+  {
+    std::size_t max_batch_size = 256;  // writes per transaction
+    int busy_timeout_ms = 5000;        // waiting for other processes writing to the database
+  };
+
+  struct group_commit_stats_t
+  {
+    std::uint64_t batches = 0;   // transactions, i.e. COMMITs
+    std::uint64_t writes = 0;    // writes run in these transactions
+    std::uint64_t failures = 0;  // writes that threw, or that were rolled back with their batch
+  };
+}  // namespace sqlpp::sqlite3
+
+namespace sqlpp::sqlite3::detail
+{
+  // Runs write(i) for each i < size in one BEGIN IMMEDIATE ... COMMIT, each in a savepoint of its own, so that a
+  // write that throws is rolled back without affecting the others. rejected(i, error) is called for such writes
+  // right away. Returns the error of the transaction as a whole (e.g. of BEGIN or COMMIT), which applies to all
+  // writes that have not been rejected. Used by group_commit_writer and worker_t.
+  template <typename Connection, typename Write, typename Rejected>
+  auto commit_batch(Connection& connection, std::size_t size, Write write, Rejected rejected) -> std::exception_ptr
+  {
+    auto options = ::sqlpp::transaction_options{};
+    options.begin = ::sqlpp::begin_mode::immediate;
+    try
+    {
+      connection.start_transaction(options);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        // Nested transactions are savepoints
+        connection.start_transaction();
+        try
+        {
+          write(i);
+          connection.commit();
+        }
+        catch (...)
+        {
+          const auto error = std::current_exception();
+          connection.rollback();
+          rejected(i, error);
+        }
+      }
+      connection.commit();
+      return nullptr;
+    }
+    catch (...)
+    {
+      // Roll back what is left, but give up if rolling back fails
+      for (auto depth = connection.transaction_depth(); depth > 0; depth = connection.transaction_depth())
+      {
+        connection.destroy_transaction();
+        if (connection.transaction_depth() == depth)
+          break;
+      }
+      return std::current_exception();
+    }
+  }
+
+  template <typename Connection>
+  class group_commit_request
+  {
+  public:
+    virtual ~group_commit_request() = default;
+
+    virtual auto run(Connection& connection) -> void = 0;
+    virtual auto complete() -> void = 0;
+    virtual auto fail(std::exception_ptr error) -> void = 0;
+  };
+
+  template <typename Connection, typename Write>
+  class group_commit_write final : public group_commit_request<Connection>
+  {
+  public:
+    using result_type = std::invoke_result_t<Write&, Connection&>;
+
+  private:
+    Write _write;
+    std::promise<result_type> _promise;
+    std::optional<std::conditional_t<std::is_void_v<result_type>, bool, result_type>> _result;
+
+  public:
+    group_commit_write(Write write) : _write(std::move(write))
+    {
+    }
+
+    [[nodiscard]] auto get_future() -> std::future<result_type>
+    {
+      return _promise.get_future();
+    }
+
+    auto run(Connection& connection) -> void override
+    {
+      if constexpr (std::is_void_v<result_type>)
+      {
+        _write(connection);
+        _result = true;
+      }
+      else
+      {
+        _result.emplace(_write(connection));
+      }
+    }
+
+    // The result is handed out only once it has been committed
+    auto complete() -> void override
+    {
+      if constexpr (std::is_void_v<result_type>)
+      {
+        _promise.set_value();
+      }
+      else
+      {
+        _promise.set_value(std::move(*_result));
+      }
+    }
+
+    auto fail(std::exception_ptr error) -> void override
+    {
+      _promise.set_exception(std::move(error));
+    }
+  };
+}  // namespace sqlpp::sqlite3::detail
+
+namespace sqlpp::sqlite3
+{
+  // Runs the writes submitted by any number of threads on a dedicated connection and thread. Writes that queue up
+  // while a transaction is being committed are run together in the next BEGIN IMMEDIATE ... COMMIT, so that they
+  // share the cost of syncing to disk. Each write runs in its own savepoint: Writes that throw are rolled back
+  // without affecting the others in the batch.
+  //
+  // The futures returned by submit() are ready once the write has been committed (or has failed). Durability is
+  // that of a COMMIT with the synchronous setting of the database.
+  // Writes must not start or end transactions themselves, and must not return results referring to the connection.
+  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed, typename Instrumentation = ::sqlpp::no_instrumentation>
+  class group_commit_writer
+  {
+  public:
+    using connection_type = connection_t<Debug, Instrumentation>;
+
+  private:
+    using _request = detail::group_commit_request<connection_type>;
+
+    group_commit_config_t _config;
+    connection_type _connection;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::vector<std::unique_ptr<_request>> _queue;
+    group_commit_stats_t _stats;
+    bool _stop = false;
+    std::thread _committer;
+
+    auto run() -> void
+    {
+      auto batch = std::vector<std::unique_ptr<_request>>{};
+      for (;;)
+      {
+        {
+          auto lock = std::unique_lock{_mutex};
+          _wakeup.wait(lock, [this] { return _stop or not _queue.empty(); });
+          if (_queue.empty())
+          {
+            return;
+          }
+
+          const auto count = std::min(_queue.size(), _config.max_batch_size);
+          batch.assign(std::make_move_iterator(_queue.begin()),
+                       std::make_move_iterator(_queue.begin() + static_cast<std::ptrdiff_t>(count)));
+          _queue.erase(_queue.begin(), _queue.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+
+        commit_batch(batch);
+        batch.clear();
+      }
+    }
+
+    // Called before the futures become ready, so that stats() covers all completed writes
+    auto record_batch(std::size_t writes, std::size_t failures) -> void
+    {
+      const auto lock = std::lock_guard{_mutex};
+      ++_stats.batches;
+      _stats.writes += writes;
+      _stats.failures += failures;
+    }
+
+    auto commit_batch(std::vector<std::unique_ptr<_request>>& batch) -> void
+    {
+      // Failed writes are rejected right away, their futures do not depend on the COMMIT
+      auto rejected = std::vector<bool>(batch.size());
+      auto failures = std::size_t{};
+      const auto error = detail::commit_batch(
+          _connection, batch.size(), [&](std::size_t i) { batch[i]->run(_connection); },
+          [&](std::size_t i, std::exception_ptr write_error) {
+            rejected[i] = true;
+            ++failures;
+            batch[i]->fail(std::move(write_error));
+          });
+
+      record_batch(batch.size(), error ? batch.size() : failures);
+      for (std::size_t i = 0; i < batch.size(); ++i)
+      {
+        if (rejected[i])
+          continue;
+        if (error)
+          batch[i]->fail(error);
+        else
+          batch[i]->complete();
+      }
+    }
+
+  public:
+    group_commit_writer(const connection_config_t& connection_config,
+                        group_commit_config_t config = {},
+                        Instrumentation instrumentation = {})
+        : _config(config), _connection(connection_config, std::move(instrumentation))
+    {
+      if (_config.max_batch_size == 0)
+      {
+        throw sqlpp::exception("Sqlite3: group_commit_writer requires max_batch_size > 0");
+      }
+      sqlite3_busy_timeout(_connection.get(), _config.busy_timeout_ms);
+      _committer = std::thread{[this] { run(); }};
+    }
+
+    group_commit_writer(const group_commit_writer&) = delete;
+    group_commit_writer(group_commit_writer&&) = delete;
+    group_commit_writer& operator=(const group_commit_writer&) = delete;
+    group_commit_writer& operator=(group_commit_writer&&) = delete;
+
+    // Commits all writes submitted so far
+    ~group_commit_writer()
+    {
+      {
+        const auto lock = std::lock_guard{_mutex};
+        _stop = true;
+      }
+      _wakeup.notify_one();
+      _committer.join();
+    }
+
+    // write is called with the connection_type& of the writer, its result is handed out via the future
+    template <typename Write>
+    [[nodiscard]] auto submit(Write write)
+    {
+      auto request = std::make_unique<detail::group_commit_write<connection_type, Write>>(std::move(write));
+      auto future = request->get_future();
+      {
+        const auto lock = std::lock_guard{_mutex};
+        if (_stop)
+        {
+          throw sqlpp::exception("Sqlite3: group_commit_writer is shutting down");
+        }
+        _queue.push_back(std::move(request));
+      }
+      _wakeup.notify_one();
+      return future;
+    }
+
+    // Selects are materialized, see owned_row_t, since their rows must not refer to the connection
+    template <typename... Clauses>
+    [[nodiscard]] auto submit(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      return submit([statement](connection_type& connection) {
+        if constexpr (std::is_same_v<result_type_of_t<Statement>, select_result>)
+        {
+          return ::sqlpp::materialize(connection(statement));
+        }
+        else
+        {
+          return connection(statement);
+        }
+      });
+    }
+
+    [[nodiscard]] auto stats() const -> group_commit_stats_t
+    {
+      const auto lock = std::lock_guard{_mutex};
+      return _stats;
+    }
+  };
+}  // namespace sqlpp::sqlite3
@@ -30,6 +30,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <memory>
 #include <optional>
 #include <string_view>
+#include <variant>
+#include <vector>
 
 #ifdef SQLPP_USE_SQLCIPHER
 #include <sqlcipher/sqlite3.h>
@@ -37,7 +39,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sqlite3.h>
 #endif
 
+#include <sqlpp17/instrumentation.h>
+#include <sqlpp17/literal_parameters.h>
 #include <sqlpp17/prepared_statement_parameters.h>
+#include <sqlpp17/type_hash.h>
 
 #include <sqlpp17/sqlite3/prepared_statement_result.h>
 
@@ -126,12 +131,45 @@ namespace sqlpp::sqlite3
       (..., bind_parameter(statement, static_cast<parameter_base_t<ParameterSpecs>&>(parameters)(), ++index));
   }
 
-  template<typename ResultType, typename ParameterVector, typename ResultRow>
-  class prepared_statement_t
+  // Literals might be needed while stepping through a result, after the literals vector is gone
+  inline auto bind_literals(::sqlite3_stmt* statement, const std::vector<::sqlpp::literal_value>& literals) -> void
   {
+    int index = 0;
+    for (const auto& literal : literals)
+    {
+      ++index;
+      std::visit(
+          [statement, index](const auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, bool>)
+              detail::check_bind_result(sqlite3_bind_int(statement, index, value), "bool");
+            else if constexpr (std::is_same_v<T, std::int64_t>)
+              detail::check_bind_result(sqlite3_bind_int64(statement, index, value), "int64_t");
+            else if constexpr (std::is_same_v<T, double>)
+              detail::check_bind_result(sqlite3_bind_double(statement, index, value), "double");
+            else
+              detail::check_bind_result(sqlite3_bind_text(statement, index, value.data(),
+                                                          static_cast<int>(value.size()), SQLITE_TRANSIENT),
+                                        "string");
+          },
+          literal);
+    }
+  }
+
+  template <typename ResultType,
+            typename ParameterVector,
+            typename ResultRow,
+            typename Instrumentation = ::sqlpp::no_instrumentation>
+  class prepared_statement_t : private ::sqlpp::instrumentation_base<Instrumentation>
+  {
+    using _instrumentation_base = ::sqlpp::instrumentation_base<Instrumentation>;
+
     detail::unique_prepared_statement_ptr _handle;
     detail::result_owns_statement _ownership;
     ::sqlite3* _connection;
+    statement_profiler* _profiler = nullptr;
+    ::sqlpp::execution_limits* _limits = nullptr;
+    std::uint32_t _statement_hash = 0;
 
   public:
     ::sqlpp::prepared_statement_parameters<ParameterVector> parameters = {};
@@ -139,9 +177,24 @@ namespace sqlpp::sqlite3
     prepared_statement_t() = default;
 
     template <typename Connection>
-    prepared_statement_t(const Connection& connection, const std::string& sql_string, detail::result_owns_statement ownership)
-        : _ownership(ownership), _connection(connection.get())
+    prepared_statement_t(const Connection& connection,
+                         const std::string& sql_string,
+                         detail::result_owns_statement ownership,
+                         std::uint32_t statement_hash,
+                         [[maybe_unused]] ::sqlpp::instrumentation_clock::time_point serialization_start)
+        : _instrumentation_base{connection.instrumentation()},
+          _ownership(ownership),
+          _connection(connection.get()),
+          _profiler(connection.profiler()),
+          _limits(connection.limits()),
+          _statement_hash(statement_hash)
     {
+      if constexpr (_instrumentation_base::is_instrumented())
+      {
+        const auto now = ::sqlpp::instrumentation_clock::now();
+        this->instrument(::sqlpp::prepare_start_event{_statement_hash, sql_string, now - serialization_start, now});
+      }
+
       ::sqlite3_stmt* statement_ptr = nullptr;
 
       const auto rc = sqlite3_prepare_v2(connection.get(), sql_string.c_str(), static_cast<int>(sql_string.size()),
@@ -151,16 +204,55 @@ namespace sqlpp::sqlite3
 
       if (rc != SQLITE_OK)
       {
+        if constexpr (_instrumentation_base::is_instrumented())
+          this->instrument(::sqlpp::error_event{_statement_hash, sqlite3_errmsg(connection.get()),
+                                                ::sqlpp::instrumentation_clock::now()});
         throw sqlpp::exception("Sqlite3: Could not prepare statement: " + std::string(sqlite3_errmsg(connection.get())) +
-                               " (statement was >>" + sql_string + "<<)\n");
+                                   " (statement was >>" + sql_string + "<<)\n",
+                               detail::error_code_of(rc));
       }
+
+      if constexpr (_instrumentation_base::is_instrumented())
+        this->instrument(::sqlpp::prepare_end_event{_statement_hash, ::sqlpp::instrumentation_clock::now()});
+    }
+
+    template <typename Connection>
+    prepared_statement_t(const Connection& connection, const std::string& sql_string, detail::result_owns_statement ownership)
+        : prepared_statement_t{connection, sql_string, ownership, _hash_of(sql_string),
+                               ::sqlpp::instrumentation_now<_instrumentation_base::is_instrumented()>()}
+    {
     }
 
     template <typename Connection, typename Statement>
     prepared_statement_t(const Connection& connection, const Statement& statement, detail::result_owns_statement ownership)
-        : prepared_statement_t{connection, to_sql_string_c(context_t{}, statement), ownership}
+        : prepared_statement_t{connection, statement, ownership,
+                               ::sqlpp::instrumentation_now<_instrumentation_base::is_instrumented()>()}
     {}
 
+    template <typename Connection, typename Statement>
+    prepared_statement_t(const Connection& connection,
+                         const Statement& statement,
+                         detail::result_owns_statement ownership,
+                         ::sqlpp::instrumentation_clock::time_point serialization_start)
+        : prepared_statement_t{connection, to_sql_string_c(context_t{}, statement), ownership, _hash_of<Statement>(),
+                               serialization_start}
+    {}
+
+    // Takes a statement that was prepared before, e.g. from a statement cache
+    template <typename Connection>
+    prepared_statement_t(const Connection& connection,
+                         detail::unique_prepared_statement_ptr handle,
+                         std::uint32_t statement_hash)
+        : _instrumentation_base{connection.instrumentation()},
+          _handle(std::move(handle)),
+          _ownership(detail::result_owns_statement{true}),
+          _connection(connection.get()),
+          _profiler(connection.profiler()),
+          _limits(connection.limits()),
+          _statement_hash(statement_hash)
+    {
+    }
+
     prepared_statement_t(const prepared_statement_t&) = delete;
     prepared_statement_t(prepared_statement_t&& rhs) = default;
     prepared_statement_t& operator=(const prepared_statement_t&) = delete;
@@ -169,16 +261,24 @@ namespace sqlpp::sqlite3
 
     auto execute()
     {
+      if constexpr (_instrumentation_base::is_instrumented())
+        this->instrument(::sqlpp::execute_start_event{_statement_hash, {}, {}, ::sqlpp::instrumentation_clock::now()});
+
       if (const auto rc = sqlite3_reset(_handle.get()); rc != SQLITE_OK)
       {
-        throw sqlpp::exception("Sqlite3: Could not reset statement: " + std::string(sqlite3_errmsg(_connection)));
+        throw sqlpp::exception("Sqlite3: Could not reset statement: " + std::string(sqlite3_errmsg(_connection)),
+                               detail::error_code_of(rc));
       }
 
       ::sqlpp::sqlite3::bind_parameters(_handle.get(), parameters);
+      detail::begin_statement(_connection, _limits);
 
       if constexpr (not std::is_same_v<ResultType, select_result>)
       {
-        switch (const auto rc = sqlite3_step(_handle.get()); rc)
+        const auto rc = sqlite3_step(_handle.get());
+        if (_limits)
+          detail::end_statement(_connection);
+        switch (rc)
         {
           case SQLITE_OK:
             [[fallthrough]];
@@ -186,9 +286,32 @@ namespace sqlpp::sqlite3
             [[fallthrough]];  // might occur if execute is called with a select
           case SQLITE_DONE:
             break;
+          case SQLITE_INTERRUPT:
+            if constexpr (_instrumentation_base::is_instrumented())
+              this->instrument(
+                  ::sqlpp::error_event{_statement_hash, sqlite3_errstr(rc), ::sqlpp::instrumentation_clock::now()});
+            detail::throw_interrupted(_handle.get(), _limits);
           default:
-            throw sqlpp::exception("Sqlite3: Could not execute statement: "  + std::string(sqlite3_errstr(rc)));
+            if constexpr (_instrumentation_base::is_instrumented())
+              this->instrument(
+                  ::sqlpp::error_event{_statement_hash, sqlite3_errstr(rc), ::sqlpp::instrumentation_clock::now()});
+            // Otherwise the next execute() would report this error again when resetting, e.g. for a cached COMMIT
+            sqlite3_reset(_handle.get());
+            throw sqlpp::exception("Sqlite3: Could not execute statement: " + std::string(sqlite3_errstr(rc)),
+                                   detail::error_code_of(rc));
         }
+
+        if (_profiler)
+          _profiler->record(_statement_hash, _handle.get());
+      }
+
+      if constexpr (_instrumentation_base::is_instrumented())
+      {
+        // Rows of a select are only known after stepping through them
+        const auto rows = std::is_same_v<ResultType, select_result>
+                              ? std::nullopt
+                              : std::optional<std::size_t>{static_cast<std::size_t>(sqlite3_changes(_connection))};
+        this->instrument(::sqlpp::execute_end_event{_statement_hash, rows, ::sqlpp::instrumentation_clock::now()});
       }
 
       if constexpr (std::is_same_v<ResultType, insert_result>)
@@ -205,10 +328,14 @@ namespace sqlpp::sqlite3
       }
       else if constexpr (std::is_same_v<ResultType, select_result>)
       {
-        return ::sqlpp::result_t<prepared_statement_result_t<ResultRow>>{
-            (_ownership == (detail::result_owns_statement{true}))
-                ? detail::unique_prepared_statement_ptr{_handle.release(), {true}}
-                : detail::unique_prepared_statement_ptr{_handle.get(), {false}}};
+        auto handle = ::sqlpp::make_result_handle<Instrumentation>(
+            prepared_statement_result_t<ResultRow>{
+                (_ownership == (detail::result_owns_statement{true}))
+                    ? std::move(_handle)
+                    : detail::unique_prepared_statement_ptr{_handle.get(), {false}},
+                _profiler, _statement_hash, _limits},
+            *this, _statement_hash);
+        return ::sqlpp::result_t<decltype(handle)>{std::move(handle)};
       }
       else if constexpr (std::is_same_v<ResultType, execute_result>)
       {
@@ -220,6 +347,21 @@ namespace sqlpp::sqlite3
       }
     }
 
+    // Hands the statement to the cache once done with it, instead of finalizing it (if the cache has room)
+    auto cache_in(const std::shared_ptr<detail::statement_cache>& cache, const std::string& sql_string) -> void
+    {
+      if (_handle.get_deleter()._owning and cache->adopt(sql_string, _handle.get()))
+      {
+        _handle.get_deleter()._cache = cache;
+      }
+    }
+
+    // Used for statements that must run even after a deadline passed, e.g. ROLLBACK
+    auto ignore_execution_limits() -> void
+    {
+      _limits = nullptr;
+    }
+
     auto* get() const
     {
       return _handle.get();
@@ -229,14 +371,48 @@ namespace sqlpp::sqlite3
     {
       return _connection;
     }
+
+    // Counters since the statement was prepared or last reset, see profiler.h
+    [[nodiscard]] auto status(bool reset_counters = false) const -> statement_status
+    {
+      return detail::read_statement_status(_handle.get(), reset_counters);
+    }
+
+    [[nodiscard]] auto scan_status(bool reset_counters = false) const -> std::vector<::sqlpp::sqlite3::scan_status>
+    {
+      return detail::read_scan_status(_handle.get(), reset_counters);
+    }
+
+  private:
+    // Statement hashes are compile-time constants and also identify statements for the profiler
+    template <typename Statement>
+    static constexpr auto _hash_of() -> std::uint32_t
+    {
+      return type_hash<Statement>();
+    }
+
+    static auto _hash_of([[maybe_unused]] const std::string& sql_string) -> std::uint32_t
+    {
+      if constexpr (_instrumentation_base::is_instrumented())
+      {
+        return djb2_hash(sql_string);
+      }
+      else
+      {
+        return 0;
+      }
+    }
   };
 
   template <typename Connection, typename Statement>
   prepared_statement_t(const Connection&, const Statement&, detail::result_owns_statement)
-      ->prepared_statement_t<result_type_of_t<Statement>, parameters_of_t<Statement>, result_row_of_t<Statement>>;
+      ->prepared_statement_t<result_type_of_t<Statement>,
+                             parameters_of_t<Statement>,
+                             result_row_of_t<Statement>,
+                             typename Connection::instrumentation_type>;
 
-  template <typename ResultType, typename ParameterVector, typename ResultRow>
-  auto execute(prepared_statement_t<ResultType, ParameterVector, ResultRow>& statement)
+  template <typename ResultType, typename ParameterVector, typename ResultRow, typename Instrumentation>
+  auto execute(prepared_statement_t<ResultType, ParameterVector, ResultRow, Instrumentation>& statement)
   {
     return statement.execute();
   }
@@ -26,10 +26,12 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string_view>
+#include <vector>
 
 #ifdef SQLPP_USE_SQLCIPHER
 #include <sqlcipher/sqlite3.h>
@@ -37,20 +39,44 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sqlite3.h>
 #endif
 
+#include <sqlpp17/cancellation.h>
 #include <sqlpp17/result_row.h>
+#include <sqlpp17/detail/statement_cache.h>
+
+#include <sqlpp17/sqlite3/profiler.h>
 
 namespace sqlpp::sqlite3::detail
 {
   enum class result_owns_statement : bool {};
 
+  struct statement_cache_traits
+  {
+    static auto reset(::sqlite3_stmt* handle) -> void
+    {
+      sqlite3_reset(handle);
+      sqlite3_clear_bindings(handle);
+    }
+
+    static auto finalize(::sqlite3_stmt* handle) -> void
+    {
+      sqlite3_finalize(handle);
+    }
+  };
+  using statement_cache = ::sqlpp::detail::statement_cache<::sqlite3_stmt, statement_cache_traits>;
+
   struct prepared_statement_cleanup_t
   {
     bool _owning;
+    std::weak_ptr<statement_cache> _cache = {};  // cached statements are handed back instead of being finalized
 
     auto operator()(::sqlite3_stmt* handle) noexcept -> void
     {
       if (_owning and handle)
       {
+        if (const auto cache = _cache.lock(); cache and cache->release(handle))
+        {
+          return;
+        }
         // This might fail, but throwing is not an option here
         sqlite3_finalize(handle);
       }
@@ -58,7 +84,56 @@ namespace sqlpp::sqlite3::detail
   };
   using unique_prepared_statement_ptr = std::unique_ptr<::sqlite3_stmt, detail::prepared_statement_cleanup_t>;
 
-  inline auto get_next_result_row(::sqlite3_stmt* stmt) -> bool
+  inline auto error_code_of(int rc) -> ::sqlpp::error_code
+  {
+    switch (rc & 0xff)
+    {
+      case SQLITE_BUSY:
+        [[fallthrough]];
+      case SQLITE_LOCKED:
+        return ::sqlpp::error_code::busy;
+      default:
+        return ::sqlpp::error_code::unspecified;
+    }
+  }
+
+  // Number of virtual machine instructions between checks of the execution limits
+  constexpr auto progress_handler_period = 1000;
+
+  inline auto check_execution_limits(void* limits) -> int
+  {
+    return static_cast<::sqlpp::execution_limits*>(limits)->check() != ::sqlpp::interrupt_reason::none;
+  }
+
+  // Removes the progress handler once the statement is done, see begin_statement
+  inline auto end_statement(::sqlite3* connection) -> void
+  {
+    sqlite3_progress_handler(connection, 0, nullptr, nullptr);
+  }
+
+  // Sqlite3 checks the limits of the running statement via the progress handler, while executing and fetching.
+  // Statements without limits (e.g. transaction control) must not be checked against those of an earlier one.
+  inline auto begin_statement(::sqlite3* connection, ::sqlpp::execution_limits* limits) -> void
+  {
+    if (limits and limits->begin_statement())
+    {
+      sqlite3_progress_handler(connection, progress_handler_period, &check_execution_limits, limits);
+    }
+    else
+    {
+      end_statement(connection);
+    }
+  }
+
+  // Resets the statement, so that it can be executed again
+  [[noreturn]] inline auto throw_interrupted(::sqlite3_stmt* stmt, const ::sqlpp::execution_limits* limits) -> void
+  {
+    sqlite3_reset(stmt);
+    ::sqlpp::detail::throw_interrupted(limits ? limits->reason() : ::sqlpp::interrupt_reason::none,
+                                       "Sqlite3: Statement interrupted");
+  }
+
+  inline auto get_next_result_row(::sqlite3_stmt* stmt, const ::sqlpp::execution_limits* limits = nullptr) -> bool
   {
     auto rc = sqlite3_step(stmt);
 
@@ -68,9 +143,12 @@ namespace sqlpp::sqlite3::detail
         return true;
       case SQLITE_DONE:
         return false;
+      case SQLITE_INTERRUPT:
+        throw_interrupted(stmt, limits);
       default:
-        throw sqlpp::exception("Sqlite3 error: Unexpected return value for sqlite3_step(): " +
-                               std::string(sqlite3_errstr(rc)));
+        throw sqlpp::exception(
+            "Sqlite3 error: Unexpected return value for sqlite3_step(): " + std::string(sqlite3_errstr(rc)),
+            error_code_of(rc));
     }
   }
 }  // namespace sqlpp::sqlite3::detail
@@ -140,6 +218,9 @@ namespace sqlpp::sqlite3
   class prepared_statement_result_t<result_row_t<ColumnSpecs...>>
   {
     detail::unique_prepared_statement_ptr _handle;
+    statement_profiler* _profiler = nullptr;
+    std::uint32_t _statement_hash = 0;
+    const ::sqlpp::execution_limits* _limits = nullptr;
 
     result_row_t<ColumnSpecs...> _row;
 
@@ -147,8 +228,11 @@ namespace sqlpp::sqlite3
     using row_type = decltype(_row);
 
     prepared_statement_result_t() = default;
-    prepared_statement_result_t(detail::unique_prepared_statement_ptr&& handle)
-        : _handle(std::move(handle))
+    prepared_statement_result_t(detail::unique_prepared_statement_ptr&& handle,
+                                statement_profiler* profiler = nullptr,
+                                std::uint32_t statement_hash = 0,
+                                const ::sqlpp::execution_limits* limits = nullptr)
+        : _handle(std::move(handle)), _profiler(profiler), _statement_hash(statement_hash), _limits(limits)
     {
     }
     prepared_statement_result_t(const prepared_statement_result_t&) = delete;
@@ -159,12 +243,28 @@ namespace sqlpp::sqlite3
 
     auto get_next_row() -> void
     {
-      if (detail::get_next_result_row(_handle.get()))
+      auto has_row = false;
+      try
+      {
+        has_row = detail::get_next_result_row(_handle.get(), _limits);
+      }
+      catch (...)
+      {
+        if (_limits)
+          detail::end_statement(sqlite3_db_handle(_handle.get()));
+        throw;
+      }
+
+      if (has_row)
       {
         assign_fields(_handle.get(), _row, std::make_integer_sequence<unsigned, sizeof...(ColumnSpecs)>{});
       }
       else
       {
+        if (_limits)
+          detail::end_statement(sqlite3_db_handle(_handle.get()));
+        if (_profiler)
+          _profiler->record(_statement_hash, _handle.get());
         reset();
       }
     }
@@ -184,6 +284,17 @@ namespace sqlpp::sqlite3
       return _handle.get();
     }
 
+    // Counters since the statement was prepared or last reset, see profiler.h
+    [[nodiscard]] auto status(bool reset_counters = false) const -> statement_status
+    {
+      return detail::read_statement_status(_handle.get(), reset_counters);
+    }
+
+    [[nodiscard]] auto scan_status(bool reset_counters = false) const -> std::vector<::sqlpp::sqlite3::scan_status>
+    {
+      return detail::read_scan_status(_handle.get(), reset_counters);
+    }
+
     auto reset() -> void
     {
       *this = {};
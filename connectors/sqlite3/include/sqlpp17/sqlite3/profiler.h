@@ -0,0 +1,221 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef SQLPP_USE_SQLCIPHER
+#include <sqlcipher/sqlite3.h>
+#else
+#include <sqlite3.h>
+#endif
+
+#include <sqlpp17/normalize_sql.h>
+#include <sqlpp17/type_hash.h>
+
+namespace sqlpp::sqlite3
+{
+  // Counters of sqlite3_stmt_status, see https://www.sqlite.org/c3ref/c_stmtstatus_counter.html
+  struct statement_status
+  {
+    std::uint64_t fullscan_steps = 0;  // steps in full table scans, candidates for an index
+    std::uint64_t sorts = 0;           // sort operations (temp b-trees), candidates for an index
+    std::uint64_t autoindex = 0;       // rows inserted into automatic indexes, candidates for a permanent index
+    std::uint64_t vm_steps = 0;        // virtual machine operations, a rough measure of the total work
+    std::uint64_t reprepares = 0;      // automatic re-preparations due to schema changes
+    std::uint64_t runs = 0;            // completed executions
+    std::uint64_t filter_hits = 0;     // bloom filter hits, sqlite3 3.38.0 or later
+    std::uint64_t filter_misses = 0;   // bloom filter misses, sqlite3 3.38.0 or later
+    std::uint64_t memory_used = 0;     // bytes used by the prepared statement (the maximum for aggregates)
+
+    auto operator+=(const statement_status& rhs) -> statement_status&
+    {
+      fullscan_steps += rhs.fullscan_steps;
+      sorts += rhs.sorts;
+      autoindex += rhs.autoindex;
+      vm_steps += rhs.vm_steps;
+      reprepares += rhs.reprepares;
+      runs += rhs.runs;
+      filter_hits += rhs.filter_hits;
+      filter_misses += rhs.filter_misses;
+      memory_used = memory_used < rhs.memory_used ? rhs.memory_used : memory_used;
+      return *this;
+    }
+  };
+
+  // Per loop of the query plan, see https://www.sqlite.org/c3ref/stmt_scanstatus.html
+  // Only available if SQLITE_ENABLE_STMT_SCANSTATUS is defined (and sqlite3 has been compiled with it).
+  struct scan_status
+  {
+    std::string name;     // table or index
+    std::string explain;  // as in EXPLAIN QUERY PLAN
+    std::uint64_t loops = 0;
+    std::uint64_t visits = 0;
+    double estimated_rows = 0.0;  // per loop
+  };
+
+  struct statement_profile
+  {
+    std::uint32_t statement_hash = 0;
+    std::string sql;  // normalized, see normalize_sql
+    statement_status status;
+    std::vector<scan_status> scans;
+  };
+}  // namespace sqlpp::sqlite3
+
+namespace sqlpp::sqlite3::detail
+{
+  inline auto read_statement_status(::sqlite3_stmt* statement, bool reset) -> statement_status
+  {
+    const auto read = [statement, reset](int op) {
+      return static_cast<std::uint64_t>(sqlite3_stmt_status(statement, op, reset));
+    };
+
+    auto status = statement_status{};
+    if (not statement)
+    {
+      return status;
+    }
+    status.fullscan_steps = read(SQLITE_STMTSTATUS_FULLSCAN_STEP);
+    status.sorts = read(SQLITE_STMTSTATUS_SORT);
+    status.autoindex = read(SQLITE_STMTSTATUS_AUTOINDEX);
+    status.vm_steps = read(SQLITE_STMTSTATUS_VM_STEP);
+    status.reprepares = read(SQLITE_STMTSTATUS_REPREPARE);
+    status.runs = read(SQLITE_STMTSTATUS_RUN);
+#if SQLITE_VERSION_NUMBER >= 3038000
+    status.filter_hits = read(SQLITE_STMTSTATUS_FILTER_HIT);
+    status.filter_misses = read(SQLITE_STMTSTATUS_FILTER_MISS);
+#endif
+    status.memory_used = read(SQLITE_STMTSTATUS_MEMUSED);
+    return status;
+  }
+
+  inline auto read_scan_status([[maybe_unused]] ::sqlite3_stmt* statement, [[maybe_unused]] bool reset)
+      -> std::vector<scan_status>
+  {
+    auto scans = std::vector<scan_status>{};
+#ifdef SQLITE_ENABLE_STMT_SCANSTATUS
+    for (auto index = 0; statement; ++index)
+    {
+      auto loops = sqlite3_int64{};
+      if (sqlite3_stmt_scanstatus(statement, index, SQLITE_SCANSTAT_NLOOP, &loops))
+        break;
+
+      auto& scan = scans.emplace_back();
+      scan.loops = static_cast<std::uint64_t>(loops);
+
+      auto visits = sqlite3_int64{};
+      sqlite3_stmt_scanstatus(statement, index, SQLITE_SCANSTAT_NVISIT, &visits);
+      scan.visits = static_cast<std::uint64_t>(visits);
+      sqlite3_stmt_scanstatus(statement, index, SQLITE_SCANSTAT_EST, &scan.estimated_rows);
+
+      const char* text = nullptr;
+      if (sqlite3_stmt_scanstatus(statement, index, SQLITE_SCANSTAT_NAME, &text) == 0 and text)
+        scan.name = text;
+      if (sqlite3_stmt_scanstatus(statement, index, SQLITE_SCANSTAT_EXPLAIN, &text) == 0 and text)
+        scan.explain = text;
+    }
+    if (reset and statement)
+    {
+      sqlite3_stmt_scanstatus_reset(statement);
+    }
+#endif
+    return scans;
+  }
+}  // namespace sqlpp::sqlite3::detail
+
+namespace sqlpp::sqlite3
+{
+  // Aggregates the status of prepared statements per statement type.
+  // Connections report to the profiler given in their connection_config_t, see connection_config_t::profiler.
+  // The profiler must outlive these connections.
+  class statement_profiler
+  {
+    mutable std::mutex _mutex;
+    std::vector<statement_profile> _profiles;
+    std::unordered_map<std::uint32_t, std::size_t> _index;  // statement hash to position in _profiles
+
+  public:
+    // Adds the counters of the statement since the last call and resets them.
+    // Statements without hash (e.g. string queries) are identified by their normalized text.
+    auto record(std::uint32_t statement_hash, ::sqlite3_stmt* statement) -> void
+    {
+      const auto status = detail::read_statement_status(statement, true);
+      const auto scans = detail::read_scan_status(statement, true);
+      const auto* sql = sqlite3_sql(statement);
+
+      auto normalized = std::string{};
+      if (statement_hash == 0 and sql)
+      {
+        normalized = normalize_sql(sql);
+        statement_hash = djb2_hash(normalized);
+      }
+
+      const auto lock = std::lock_guard{_mutex};
+      const auto [position, inserted] = _index.try_emplace(statement_hash, _profiles.size());
+      if (inserted)
+      {
+        auto& profile = _profiles.emplace_back();
+        profile.statement_hash = statement_hash;
+        if (sql)
+          profile.sql = normalized.empty() ? normalize_sql(sql) : std::move(normalized);
+      }
+      auto& profile = _profiles[position->second];
+      profile.status += status;
+      if (profile.scans.size() < scans.size())
+      {
+        profile.scans.resize(scans.size());
+      }
+      for (auto index = std::size_t{0}; index < scans.size(); ++index)
+      {
+        auto& scan = profile.scans[index];
+        scan.name = scans[index].name;
+        scan.explain = scans[index].explain;
+        scan.loops += scans[index].loops;
+        scan.visits += scans[index].visits;
+        scan.estimated_rows = scans[index].estimated_rows;
+      }
+    }
+
+    [[nodiscard]] auto snapshot() const -> std::vector<statement_profile>
+    {
+      const auto lock = std::lock_guard{_mutex};
+      return _profiles;
+    }
+
+    auto reset() -> void
+    {
+      const auto lock = std::lock_guard{_mutex};
+      _profiles.clear();
+      _index.clear();
+    }
+  };
+}  // namespace sqlpp::sqlite3
@@ -0,0 +1,474 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include <sqlpp17/detail/mpsc_queue.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/materialize.h>
+#include <sqlpp17/statement.h>
+#include <sqlpp17/transaction.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3/group_commit.h>
+
+namespace sqlpp::sqlite3
+{
+  struct worker_config_t
+  {
+    bool batch_writes = true;          // run queued inserts, updates and deletes in a shared transaction
+    std::size_t max_batch_size = 64;   // writes per transaction
+    int busy_timeout_ms = 5000;        // waiting for other processes writing to the database
+  };
+
+  struct worker_stats_t
+  {
+    std::size_t queue_depth = 0;      // tasks submitted, but not yet started
+    std::size_t max_queue_depth = 0;  // highest queue_depth so far
+    std::uint64_t tasks = 0;          // tasks completed, including failures
+    std::uint64_t failures = 0;       // tasks that threw, or whose batch could not be committed
+    std::uint64_t batches = 0;        // transactions shared by several writes
+    std::chrono::nanoseconds wait_time = {};     // sum of the time tasks spent in the queue
+    std::chrono::nanoseconds service_time = {};  // sum of the time from starting tasks to completing them
+  };
+}  // namespace sqlpp::sqlite3
+
+namespace sqlpp::sqlite3::detail
+{
+  template <typename Connection>
+  class worker_task
+  {
+    std::chrono::steady_clock::time_point _submitted = std::chrono::steady_clock::now();
+
+  public:
+    virtual ~worker_task() = default;
+
+    auto submitted() const
+    {
+      return _submitted;
+    }
+
+    virtual auto is_write() const -> bool = 0;
+    virtual auto run(Connection& connection) -> void = 0;
+    virtual auto complete() -> void = 0;
+    virtual auto fail(std::exception_ptr error) -> void = 0;
+  };
+
+  // Runs work(connection) and hands its result (or exception) to completion(error, result) once complete() or
+  // fail() are called. For batched writes, that happens after the COMMIT.
+  template <typename Connection, typename Work, typename Completion>
+  class worker_call final : public worker_task<Connection>
+  {
+  public:
+    using value_type = std::invoke_result_t<Work&, Connection&>;
+    using storage_type = std::optional<std::conditional_t<std::is_void_v<value_type>, std::monostate, value_type>>;
+
+  private:
+    Work _work;
+    Completion _completion;
+    bool _is_write;
+    storage_type _result;
+
+  public:
+    worker_call(Work work, Completion completion, bool is_write)
+        : _work(std::move(work)), _completion(std::move(completion)), _is_write(is_write)
+    {
+    }
+
+    auto is_write() const -> bool override
+    {
+      return _is_write;
+    }
+
+    auto run(Connection& connection) -> void override
+    {
+      if constexpr (std::is_void_v<value_type>)
+      {
+        _work(connection);
+        _result.emplace();
+      }
+      else
+      {
+        _result.emplace(_work(connection));
+      }
+    }
+
+    auto complete() -> void override
+    {
+      _completion(std::exception_ptr{}, std::move(_result));
+    }
+
+    auto fail(std::exception_ptr error) -> void override
+    {
+      _result.reset();
+      _completion(std::move(error), std::move(_result));
+    }
+  };
+
+  template <typename Value>
+  auto promise_completion(std::shared_ptr<std::promise<Value>> promise)
+  {
+    return [promise = std::move(promise)](std::exception_ptr error, auto&& result) {
+      if (error)
+        promise->set_exception(std::move(error));
+      else if constexpr (std::is_void_v<Value>)
+        promise->set_value();
+      else
+        promise->set_value(std::move(*result));
+    };
+  }
+}  // namespace sqlpp::sqlite3::detail
+
+namespace sqlpp::sqlite3
+{
+  // Owns a connection and runs everything submitted to it on a dedicated thread, so that threads that must not
+  // block (e.g. event loops) can use SQLite. Tasks are submitted via a lock-free queue and run in order.
+  //
+  // Results are handed out via futures or handlers (called on the worker thread, they must not throw). Selects
+  // are materialized, see owned_row_t, since their rows must not refer to the connection.
+  //
+  // Inserts, updates and deletes that queue up behind each other are run in a shared transaction (BEGIN
+  // IMMEDIATE ... COMMIT), each in its own savepoint: A write that fails is rolled back without affecting the
+  // others. Their results are handed out after the COMMIT. Writes are not batched while a transaction that was
+  // started by a submitted function is open.
+  template <::sqlpp::debug Debug = ::sqlpp::debug::allowed, typename Instrumentation = ::sqlpp::no_instrumentation>
+  class worker_t
+  {
+  public:
+    using connection_type = connection_t<Debug, Instrumentation>;
+
+  private:
+    using _task = detail::worker_task<connection_type>;
+    using _clock = std::chrono::steady_clock;
+
+    worker_config_t _config;
+    connection_type _connection;
+
+    ::sqlpp::detail::mpsc_queue<std::unique_ptr<_task>> _queue;
+    std::atomic<std::size_t> _queue_depth = 0;
+    std::atomic<std::size_t> _max_queue_depth = 0;
+    std::atomic<bool> _stop = false;
+
+    // Parking the worker thread while the queue is empty
+    std::atomic<bool> _sleeping = false;
+    std::mutex _sleep_mutex;
+    std::condition_variable _wakeup;
+
+    mutable std::mutex _stats_mutex;
+    worker_stats_t _stats;
+
+    std::unique_ptr<_task> _next;  // popped, but not part of the current batch
+    std::thread _thread;
+
+    auto push(std::unique_ptr<_task> task) -> void
+    {
+      if (_stop)
+      {
+        throw ::sqlpp::exception("Sqlite3: worker is shutting down");
+      }
+      const auto depth = ++_queue_depth;
+      auto max_depth = _max_queue_depth.load();
+      while (max_depth < depth and not _max_queue_depth.compare_exchange_weak(max_depth, depth))
+      {
+      }
+      _queue.push(std::move(task));
+
+      if (_sleeping.load())
+      {
+        {
+          const auto lock = std::lock_guard{_sleep_mutex};
+          _sleeping = false;
+        }
+        _wakeup.notify_one();
+      }
+    }
+
+    auto try_pop() -> std::unique_ptr<_task>
+    {
+      if (_next)
+      {
+        return std::move(_next);
+      }
+      if (auto task = _queue.try_pop())
+      {
+        --_queue_depth;
+        return std::move(*task);
+      }
+      return nullptr;
+    }
+
+    // Returns nullptr once stopped and drained
+    auto pop() -> std::unique_ptr<_task>
+    {
+      for (;;)
+      {
+        if (auto task = try_pop())
+        {
+          return task;
+        }
+
+        auto lock = std::unique_lock{_sleep_mutex};
+        _sleeping = true;
+        // A push that happened before _sleeping was set is visible now, later ones see _sleeping
+        if (_queue_depth.load() == 0)
+        {
+          if (_stop)
+          {
+            _sleeping = false;
+            return nullptr;
+          }
+          _wakeup.wait(lock, [this] { return not _sleeping or _stop; });
+        }
+        _sleeping = false;
+      }
+    }
+
+    auto record(const _task& task,
+                _clock::time_point started,
+                _clock::time_point finished,
+                bool failed,
+                bool batch = false) -> void
+    {
+      const auto lock = std::lock_guard{_stats_mutex};
+      ++_stats.tasks;
+      _stats.failures += failed ? 1 : 0;
+      _stats.batches += batch ? 1 : 0;
+      _stats.wait_time += started - task.submitted();
+      _stats.service_time += finished - started;
+    }
+
+    auto run_one(std::unique_ptr<_task> task) -> void
+    {
+      const auto started = _clock::now();
+      try
+      {
+        task->run(_connection);
+      }
+      catch (...)
+      {
+        record(*task, started, _clock::now(), true);
+        task->fail(std::current_exception());
+        return;
+      }
+      record(*task, started, _clock::now(), false);
+      task->complete();
+    }
+
+    auto run_batch(std::vector<std::unique_ptr<_task>>& batch) -> void
+    {
+      const auto started = _clock::now();
+      auto failed = std::vector<std::exception_ptr>(batch.size());
+      const auto error = detail::commit_batch(
+          _connection, batch.size(), [&](std::size_t i) { batch[i]->run(_connection); },
+          [&](std::size_t i, std::exception_ptr task_error) { failed[i] = std::move(task_error); });
+      for (std::size_t i = 0; error and i < batch.size(); ++i)
+      {
+        if (not failed[i])
+          failed[i] = error;
+      }
+
+      const auto finished = _clock::now();
+      for (std::size_t i = 0; i < batch.size(); ++i)
+      {
+        record(*batch[i], started, finished, static_cast<bool>(failed[i]), i == 0);
+      }
+      for (std::size_t i = 0; i < batch.size(); ++i)
+      {
+        if (failed[i])
+          batch[i]->fail(failed[i]);
+        else
+          batch[i]->complete();
+      }
+    }
+
+    auto run() -> void
+    {
+      auto batch = std::vector<std::unique_ptr<_task>>{};
+      while (auto task = pop())
+      {
+        if (not _config.batch_writes or not task->is_write() or _connection.transaction_depth() > 0)
+        {
+          run_one(std::move(task));
+          continue;
+        }
+
+        batch.push_back(std::move(task));
+        while (batch.size() < _config.max_batch_size)
+        {
+          auto next = try_pop();
+          if (not next)
+            break;
+          if (not next->is_write())
+          {
+            _next = std::move(next);
+            break;
+          }
+          batch.push_back(std::move(next));
+        }
+
+        if (batch.size() == 1)
+        {
+          run_one(std::move(batch.front()));
+        }
+        else
+        {
+          run_batch(batch);
+        }
+        batch.clear();
+      }
+    }
+
+    template <typename Work, typename Completion>
+    auto push_call(Work work, Completion completion, bool is_write) -> void
+    {
+      using _call = detail::worker_call<connection_type, Work, Completion>;
+      push(std::make_unique<_call>(std::move(work), std::move(completion), is_write));
+    }
+
+    template <typename... Clauses>
+    static auto statement_work(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      return [statement](connection_type& connection) {
+        if constexpr (std::is_same_v<result_type_of_t<Statement>, select_result>)
+        {
+          return ::sqlpp::materialize(connection(statement));
+        }
+        else
+        {
+          return connection(statement);
+        }
+      };
+    }
+
+    template <typename... Clauses>
+    static constexpr auto is_write(const ::sqlpp::statement<Clauses...>&)
+    {
+      using ResultType = result_type_of_t<::sqlpp::statement<Clauses...>>;
+      return std::is_same_v<ResultType, insert_result> or std::is_same_v<ResultType, update_result> or
+             std::is_same_v<ResultType, delete_result>;
+    }
+
+  public:
+    worker_t(const connection_config_t& connection_config,
+             worker_config_t config = {},
+             Instrumentation instrumentation = {})
+        : _config(config), _connection(connection_config, std::move(instrumentation))
+    {
+      if (_config.max_batch_size == 0)
+      {
+        throw sqlpp::exception("Sqlite3: worker requires max_batch_size > 0");
+      }
+      sqlite3_busy_timeout(_connection.get(), _config.busy_timeout_ms);
+      _thread = std::thread{[this] { run(); }};
+    }
+
+    worker_t(const worker_t&) = delete;
+    worker_t(worker_t&&) = delete;
+    worker_t& operator=(const worker_t&) = delete;
+    worker_t& operator=(worker_t&&) = delete;
+
+    // Runs all tasks submitted so far
+    ~worker_t()
+    {
+      {
+        const auto lock = std::lock_guard{_sleep_mutex};
+        _stop = true;
+      }
+      _wakeup.notify_one();
+      _thread.join();
+    }
+
+    // work is called with the connection_type& of the worker, its result is handed out via the future.
+    // The result must not refer to the connection.
+    template <typename Work>
+    [[nodiscard]] auto submit(Work work)
+    {
+      using _value_type = std::invoke_result_t<Work&, connection_type&>;
+      auto promise = std::make_shared<std::promise<_value_type>>();
+      auto future = promise->get_future();
+      push_call(std::move(work), detail::promise_completion(std::move(promise)), false);
+      return future;
+    }
+
+    template <typename... Clauses>
+    [[nodiscard]] auto submit(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      auto work = statement_work(statement);
+      using _value_type = std::invoke_result_t<decltype(work)&, connection_type&>;
+      auto promise = std::make_shared<std::promise<_value_type>>();
+      auto future = promise->get_future();
+      push_call(std::move(work), detail::promise_completion(std::move(promise)), is_write(statement));
+      return future;
+    }
+
+    // handler(std::exception_ptr error, Value value) is called on the worker thread, where Value is what submit()
+    // would hand out via the future (default constructed if there is an error). For statements without result,
+    // handler(std::exception_ptr error) is called.
+    template <typename... Clauses, typename Handler>
+    auto submit(const ::sqlpp::statement<Clauses...>& statement, Handler handler) -> void
+    {
+      auto work = statement_work(statement);
+      using _value_type = std::invoke_result_t<decltype(work)&, connection_type&>;
+      push_call(
+          std::move(work),
+          [handler = std::move(handler)](std::exception_ptr error, auto&& result) mutable {
+            if constexpr (std::is_void_v<_value_type>)
+              handler(std::move(error));
+            else if (error)
+              handler(std::move(error), _value_type{});
+            else
+              handler(std::exception_ptr{}, std::move(*result));
+          },
+          is_write(statement));
+    }
+
+    [[nodiscard]] auto stats() const -> worker_stats_t
+    {
+      auto stats = [this] {
+        const auto lock = std::lock_guard{_stats_mutex};
+        return _stats;
+      }();
+      stats.queue_depth = _queue_depth.load();
+      stats.max_queue_depth = _max_queue_depth.load();
+      return stats;
+    }
+  };
+}  // namespace sqlpp::sqlite3
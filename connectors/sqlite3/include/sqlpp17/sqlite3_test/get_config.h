@@ -46,5 +46,15 @@ namespace sqlpp::sqlite3::test
 
     return config;
   }
+
+  // Each connection gets a private database, nothing is left behind
+  auto get_memory_config() -> ::sqlpp::sqlite3::connection_config_t
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    return config;
+  }
 }  // namespace sqlpp::sqlite3::test
 
@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <vector>
+
+#include <sqlpp17/literal_parameters.h>
+#include <sqlpp17/operator.h>
+
+#include <serialize/assert_equality.h>
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::sqlite3::context_t;
+using ::sqlpp::test::assert_equality;
+using ::test::tabPerson;
+
+int main()
+{
+  try
+  {
+    // Runtime sized lists are a single value
+    assert_equality("tab_person.id IN (SELECT value FROM json_each('[1,2,3]'))",
+                    to_sql_string_c(context_t{}, tabPerson.id.in(std::vector<int>{1, 2, 3})));
+    assert_equality(R"(tab_person.name NOT IN (SELECT value FROM json_each('["a","it''s","\"q\\"]')))",
+                    to_sql_string_c(context_t{},
+                                    tabPerson.name.not_in(std::vector<std::string>{"a", "it's", R"("q\)"})));
+
+    const auto parameterized = ::sqlpp::parameterize<context_t>(tabPerson.id.in(std::vector<int>(5000, 7)));
+    assert_equality("tab_person.id IN (SELECT value FROM json_each(?1))", parameterized.sql);
+    assert_equality("1", std::to_string(parameterized.literals.size()));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <sqlpp17/clause/bulk_update.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/function.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::test::tabPerson;
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    config.parameterize_literals = true;
+    config.post_connect = [](::sqlite3* handle) { sqlite3_limit(handle, SQLITE_LIMIT_VARIABLE_NUMBER, 100); };
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+       "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+    assert_true(db.max_statement_parameters() == 100, "parameter limit");
+
+    auto rows = std::vector<std::tuple<std::int64_t, std::string, bool>>{};
+    for (std::int64_t id = 1; id <= 250; ++id)
+    {
+      db(insert_into(tabPerson).set(tabPerson.isManager = false, tabPerson.name = "unknown"));
+      rows.emplace_back(id, "person " + std::to_string(id), id % 2 == 0);
+    }
+    rows.emplace_back(1000, "nobody", true);
+
+    // All rows exceed the parameter limit of a single statement
+    const auto bulk = bulk_update(tabPerson, tabPerson.id, tabPerson.name, tabPerson.isManager).rows(rows);
+    auto exceeded = false;
+    try
+    {
+      db(bulk);
+    }
+    catch (const ::sqlpp::exception&)
+    {
+      exceeded = true;
+    }
+    assert_true(exceeded, "single statement exceeding the limit");
+
+    // 5 parameters per row with the limit of 100 require 13 statements
+    assert_true(::sqlpp::execute_bulk_update(db, bulk) == 250, "affected rows");
+
+    for (const auto& row : db(select(count(tabPerson.id).as(tabPerson.id))
+                                  .from(tabPerson)
+                                  .where(tabPerson.isManager == true)))
+    {
+      assert_true(row.id == 125, "updated flags");
+    }
+    for (const auto& row : db(select(tabPerson.name).from(tabPerson).where(tabPerson.id == 42)))
+    {
+      assert_true(std::string_view{row.name} == "person 42", "updated name");
+    }
+
+    // Rows that fit into one statement
+    assert_true(db(bulk_update(tabPerson, tabPerson.id, tabPerson.name)
+                       .rows(std::vector{std::tuple{1, "Ada"}, std::tuple{2, "Bjarne"}})) == 2,
+                "single statement");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
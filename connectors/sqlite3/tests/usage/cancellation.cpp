@@ -0,0 +1,185 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <sqlpp17/cancellation.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  constexpr auto endless_query = "WITH RECURSIVE c(x) AS (SELECT 1 UNION ALL SELECT x + 1 FROM c) SELECT COUNT(*) FROM c";
+}  // namespace
+
+int main()
+{
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+       "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+    db.start_transaction();
+    for (auto i = 0; i < 2000; ++i)
+    {
+      db(insert_into(test::tabPerson).set(test::tabPerson.isManager = false, test::tabPerson.name = "x"));
+    }
+    db.commit();
+
+    // Statement timeouts raise timeout exceptions
+    db.set_statement_timeout(std::chrono::milliseconds{20});
+    auto timed_out = false;
+    try
+    {
+      db(endless_query);
+    }
+    catch (const ::sqlpp::timeout_exception&)
+    {
+      timed_out = true;
+    }
+    assert_true(timed_out, "statement timeout");
+    db.clear_statement_timeout();
+
+    // The connection remains usable
+    auto count = 0;
+    for ([[maybe_unused]] const auto& row : db(select(test::tabPerson.id).from(test::tabPerson).unconditionally()))
+    {
+      ++count;
+    }
+    assert_true(count == 2000, "usable after timeout");
+
+    // Cancellation from another thread
+    auto token = ::sqlpp::cancellation_token{};
+    db.set_cancellation_token(token);
+    auto canceller = std::thread{[token] {
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+      token.cancel();
+    }};
+    auto cancelled = false;
+    try
+    {
+      db(endless_query);
+    }
+    catch (const ::sqlpp::timeout_exception&)
+    {
+    }
+    catch (const ::sqlpp::cancelled_exception&)
+    {
+      cancelled = true;
+    }
+    canceller.join();
+    assert_true(cancelled, "cancellation token");
+
+    // Cancelled tokens stay cancelled
+    cancelled = false;
+    try
+    {
+      db(select(test::tabPerson.id).from(test::tabPerson).unconditionally());
+    }
+    catch (const ::sqlpp::cancelled_exception&)
+    {
+      cancelled = true;
+    }
+    assert_true(cancelled, "cancelled before start");
+
+    // Fetching is interrupted, too
+    token = ::sqlpp::cancellation_token{};
+    db.set_cancellation_token(token);
+    auto prepared_select = db.prepare(select(test::tabPerson.id).from(test::tabPerson).unconditionally());
+    count = 0;
+    cancelled = false;
+    try
+    {
+      for ([[maybe_unused]] const auto& row : execute(prepared_select))
+      {
+        if (++count == 1)
+          token.cancel();
+      }
+    }
+    catch (const ::sqlpp::cancelled_exception&)
+    {
+      cancelled = true;
+    }
+    assert_true(cancelled and count < 2000, "cancelled while fetching");
+
+    // Prepared statements can be executed again after an interruption
+    db.clear_cancellation_token();
+    count = 0;
+    for ([[maybe_unused]] const auto& row : execute(prepared_select))
+    {
+      ++count;
+    }
+    assert_true(count == 2000, "prepared statement usable after cancellation");
+
+    // Passed deadlines prevent statements from starting
+    db.set_deadline(::sqlpp::deadline_clock::now() - std::chrono::seconds{1});
+    timed_out = false;
+    try
+    {
+      db(endless_query);
+    }
+    catch (const ::sqlpp::timeout_exception&)
+    {
+      timed_out = true;
+    }
+    assert_true(timed_out, "passed deadline");
+    db.clear_deadline();
+    db("SELECT 1");
+
+    // Statements that ignore the limits are not checked against those of an earlier statement
+    db.set_statement_timeout(std::chrono::milliseconds{20});
+    db("SELECT 1");
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    auto unlimited_select = db.prepare(select(test::tabPerson.id).from(test::tabPerson).unconditionally());
+    unlimited_select.ignore_execution_limits();
+    count = 0;
+    for ([[maybe_unused]] const auto& row : execute(unlimited_select))
+    {
+      ++count;
+    }
+    assert_true(count == 2000, "statement without limits");
+    db.clear_statement_timeout();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
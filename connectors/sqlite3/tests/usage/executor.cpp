@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/executor.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3/connection_pool.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  const auto path = std::filesystem::temp_directory_path() / "sqlpp17_sqlite3_usage_executor.db";
+  std::filesystem::remove(path);
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = path.string();
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    config.post_connect = [](::sqlite3* db) { sqlite3_busy_timeout(db, 5000); };
+
+    {
+      auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+      db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, "
+         "name TEXT NOT NULL, address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+      for (auto i = 0; i < 10; ++i)
+      {
+        db(insert_into(test::tabPerson).set(test::tabPerson.isManager = i < 3, test::tabPerson.name = "a"));
+      }
+    }
+
+    auto pool = ::sqlpp::sqlite3::connection_pool_t<::sqlpp::debug::none>{4, config};
+
+    {
+      auto executor = ::sqlpp::executor_t{{4, 16}};
+      auto db = executor.bind(pool, 2);
+
+      // Fan out independent statements
+      auto [managers, all, inserted] = ::sqlpp::when_all(
+                                           db.submit(select(test::tabPerson.name)
+                                                         .from(test::tabPerson)
+                                                         .where(test::tabPerson.isManager == true)),
+                                           db.submit(select(test::tabPerson.id).from(test::tabPerson).unconditionally()),
+                                           db.submit(insert_into(test::tabPerson)
+                                                         .set(test::tabPerson.isManager = false, test::tabPerson.name = "b")))
+                                           .get();
+      assert_true(managers.size() == 3 and all.size() >= 10 and inserted > 10, "when_all");
+      const std::string& name = managers.front().name;
+      assert_true(name.compare("a") == 0, "materialized text");
+
+      // Concurrency limit per pool
+      auto active = std::atomic<int>{0};
+      auto max_active = std::atomic<int>{0};
+      auto tasks = std::vector<std::future<void>>{};
+      for (auto i = 0; i < 12; ++i)
+      {
+        tasks.push_back(db.submit([&](auto&) {
+          const auto now = ++active;
+          auto max = max_active.load();
+          while (max < now and not max_active.compare_exchange_weak(max, now))
+          {
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(2));
+          --active;
+        }));
+      }
+      assert_true(::sqlpp::when_all(std::move(tasks)).get().size() == 12, "vector when_all");
+      assert_true(max_active.load() <= 2, "max concurrency");
+    }
+
+    {
+      auto executor = ::sqlpp::executor_t{{1, 2}};
+      auto db = executor.bind(pool, 1);
+
+      auto release = std::promise<void>{};
+      auto blocker = db.submit([released = release.get_future().share()](auto&) { released.wait(); });
+
+      // Tasks that cannot start before their deadline fail
+      auto late = db.submit(select(test::tabPerson.id).from(test::tabPerson).unconditionally(),
+                            ::sqlpp::deadline_clock::now() + std::chrono::milliseconds(10));
+      auto count = db.submit([](auto& connection) {
+        return ::sqlpp::materialize(connection(select(test::tabPerson.id).from(test::tabPerson).unconditionally())).size();
+      });
+
+      // Backpressure: the queue is full
+      while (executor.pending() < 2)
+      {
+        std::this_thread::yield();
+      }
+      auto submitted = std::atomic<bool>{false};
+      auto producer = std::thread{[&] {
+        db.submit([](auto&) {}).get();
+        submitted = true;
+      }};
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      assert_true(not submitted.load(), "backpressure");
+
+      release.set_value();
+      blocker.get();
+      producer.join();
+      assert_true(submitted.load(), "submitted after release");
+
+      auto timed_out = false;
+      try
+      {
+        late.get();
+      }
+      catch (const ::sqlpp::timeout_exception&)
+      {
+        timed_out = true;
+      }
+      assert_true(timed_out, "deadline");
+      assert_true(count.get() == 11, "count");
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    std::filesystem::remove(path);
+    return 1;
+  }
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,90 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <sstream>
+
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/explain.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3_test/get_config.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::sqlite3::test::get_memory_config;
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{get_memory_config()};
+    db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+       "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+    db("CREATE INDEX idx_person_name ON tab_person (name)");
+
+    const auto by_id = explain(db, select(test::tabPerson.name).from(test::tabPerson).where(test::tabPerson.id == 17));
+    assert_true(by_id.nodes.size() == 1, "by id nodes");
+    assert_true(by_id.nodes.front().relation.compare("tab_person") == 0, "by id relation");
+    assert_true(by_id.uses_index("INTEGER PRIMARY KEY") and not by_id.has_full_scan(), "by id index");
+    assert_true(by_id.sql.find("SELECT tab_person.name FROM tab_person") == 0, "by id sql");
+
+    const auto by_name =
+        explain(db, select(test::tabPerson.id).from(test::tabPerson).where(test::tabPerson.name == "hansi"));
+    assert_true(by_name.uses_index("idx_person_name") and not by_name.has_full_scan(), "by name");
+
+    const auto by_address = explain(db, select(test::tabPerson.id)
+                                            .from(test::tabPerson)
+                                            .where(test::tabPerson.address == "Berlin")
+                                            .order_by(asc(test::tabPerson.language)));
+    assert_true(by_address.has_full_scan(), "by address");
+    assert_true(by_address.any_node([](const auto& node) { return node.operation.find("TEMP B-TREE") != node.operation.npos; }),
+                "temp b-tree");
+
+    auto os = std::ostringstream{};
+    write_query_plan(os, by_address);
+    assert_true(os.str().find("SCAN tab_person\n") == 0, "text");
+
+    try
+    {
+      [[maybe_unused]] const auto plan =
+          explain(db, select(test::tabPerson.id).from(test::tabPerson).unconditionally(), ::sqlpp::explain_mode::analyze);
+      assert_true(false, "analyze is not supported");
+    }
+    catch (const ::sqlpp::exception& e)
+    {
+      assert_true(std::string_view{e.what()}.find("analyze") != std::string_view::npos, "analyze");
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/flight_recorder.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3_test/get_config.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+
+using ::sqlpp::sqlite3::test::get_memory_config;
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  using connection_t = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none, ::sqlpp::flight_recorder_instrumentation>;
+
+  auto records_of(const connection_t& db) -> std::vector<::sqlpp::flight_record>
+  {
+    auto records = ::sqlpp::flight_recorder_snapshot();
+    records.erase(std::remove_if(records.begin(), records.end(),
+                                 [&db](const auto& record) { return record.connection != db.get(); }),
+                  records.end());
+    return records;
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    auto db = connection_t{get_memory_config()};
+    db("CREATE TABLE tab_department (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, division TEXT NOT NULL DEFAULT 'engineering')");
+    db(insert_into(test::tabDepartment).set(test::tabDepartment.name = "hansi"));
+    for (const auto& row : db(select(test::tabDepartment.id).from(test::tabDepartment).unconditionally()))
+    {
+      [[maybe_unused]] const auto id = row.id;
+    }
+
+    auto prepared_insert = db.prepare(insert_into(test::tabDepartment).set(test::tabDepartment.name = "jane"));
+    execute(prepared_insert);
+    execute(prepared_insert);
+
+    try
+    {
+      db("SELECT * FROM no_such_table");
+    }
+    catch (const ::sqlpp::exception&)
+    {
+    }
+
+    db("SELECT '" + std::string(200, 'x') + "'");
+
+    auto records = records_of(db);
+    assert_true(records.size() == 7, "record count");
+    assert_true(records[1].statement_hash == ::sqlpp::type_hash(insert_into(test::tabDepartment).set(
+                                                 test::tabDepartment.name = "hansi")),
+                "insert hash");
+    assert_true(records[1].outcome == ::sqlpp::flight_outcome::succeeded and records[1].rows == 1u, "insert outcome");
+    assert_true(records[1].sql_text().find("INSERT INTO tab_department") == 0, "insert sql");
+    assert_true(records[2].rows == 1u and records[2].fetch_time.count() > 0, "select rows");
+    // Both executions of the prepared statement report its text, only the first one includes the preparation
+    assert_true(records[3].prepare_time.count() > 0 and records[4].prepare_time.count() == 0, "prepared insert");
+    assert_true(records[4].sql_text().compare(records[3].sql_text()) == 0, "prepared insert sql");
+    assert_true(records[5].outcome == ::sqlpp::flight_outcome::failed, "error outcome");
+    assert_true(records[6].sql_truncated and records[6].sql_size == ::sqlpp::flight_record::sql_capacity,
+                "truncated sql");
+
+    // Each thread records into its own ring, the snapshot contains all of them
+    auto other_thread_records = std::size_t{};
+    std::thread([&other_thread_records] {
+      auto other_db = connection_t{get_memory_config()};
+      other_db("SELECT 1");
+      other_thread_records = records_of(other_db).size();
+    }).join();
+    assert_true(other_thread_records == 1, "other thread");
+
+    // Only the most recent statements are kept
+    for (auto i = 0u; i < ::sqlpp::flight_recorder_capacity; ++i)
+    {
+      db("SELECT 2");
+    }
+    records = records_of(db);
+    assert_true(records.size() == ::sqlpp::flight_recorder_capacity, "capacity");
+    assert_true(records.front().sql_text().compare("SELECT 2") == 0, "oldest record");
+
+    auto os = std::ostringstream{};
+    write_flight_records(os, records);
+    assert_true(os.str().find("sql=\"SELECT 2\"\n") != std::string::npos, "text");
+
+    if (auto* file = std::tmpfile())
+    {
+      ::sqlpp::dump_flight_recorder(fileno(file));
+      assert_true(std::ftell(file) > 0, "dump");
+      std::fclose(file);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,143 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/function.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3/group_commit.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  constexpr auto thread_count = 8;
+  constexpr auto writes_per_thread = 100;
+}  // namespace
+
+int main()
+{
+  const auto path = std::filesystem::temp_directory_path() / "sqlpp17_sqlite3_usage_group_commit.db";
+  std::filesystem::remove(path);
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = path.string();
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+       "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+
+    {
+      auto writer = ::sqlpp::sqlite3::group_commit_writer<::sqlpp::debug::none>{config};
+
+      // Many threads submit small writes
+      auto threads = std::vector<std::thread>{};
+      for (auto t = 0; t < thread_count; ++t)
+      {
+        threads.emplace_back([&writer] {
+          auto futures = std::vector<std::future<sqlite3_int64>>{};
+          for (auto i = 0; i < writes_per_thread; ++i)
+          {
+            futures.push_back(
+                writer.submit(insert_into(test::tabPerson).set(test::tabPerson.isManager = false, test::tabPerson.name = "a")));
+          }
+          for (auto& future : futures)
+          {
+            future.get();
+          }
+        });
+      }
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      const auto stats = writer.stats();
+      assert_true(stats.writes == thread_count * writes_per_thread and stats.failures == 0, "writes");
+      assert_true(stats.batches < stats.writes, "batches");
+
+      // Failing writes do not affect the others in their batch
+      auto good = writer.submit([](auto& connection) {
+        connection(insert_into(test::tabPerson).set(test::tabPerson.isManager = true, test::tabPerson.name = "b"));
+      });
+      auto bad = writer.submit([](auto& connection) {
+        connection(insert_into(test::tabPerson).set(test::tabPerson.isManager = true, test::tabPerson.name = "c"));
+        connection("INSERT INTO no_such_table VALUES (1)");
+      });
+      auto value = writer.submit([](auto&) { return 17; });
+      good.get();
+      assert_true(value.get() == 17, "value");
+      auto failed = false;
+      try
+      {
+        bad.get();
+      }
+      catch (const ::sqlpp::exception&)
+      {
+        failed = true;
+      }
+      assert_true(failed, "failed write");
+
+      // Selects are materialized, their rows do not refer to the connection of the writer
+      const auto selected =
+          writer.submit(select(test::tabPerson.name).from(test::tabPerson).where(test::tabPerson.isManager == true))
+              .get();
+      assert_true(selected.size() == 1, "selected rows");
+      const std::string& name = selected.front().name;
+      assert_true(name.compare("b") == 0, "materialized text");
+    }
+
+    // Everything has been committed, except the failed write
+    auto rows = 0;
+    auto managers = 0;
+    for (const auto& row : db(select(test::tabPerson.isManager).from(test::tabPerson).unconditionally()))
+    {
+      ++rows;
+      managers += row.isManager ? 1 : 0;
+    }
+    assert_true(rows == thread_count * writes_per_thread + 1 and managers == 1, "committed rows");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    std::filesystem::remove(path);
+    return 1;
+  }
+  std::filesystem::remove(path);
+}
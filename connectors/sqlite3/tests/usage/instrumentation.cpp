@@ -0,0 +1,159 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <variant>
+#include <vector>
+
+#include <sqlpp17/clause/delete_from.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/instrumentation.h>
+#include <sqlpp17/type_hash.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3/connection_pool.h>
+#include <sqlpp17/sqlite3_test/get_config.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+
+using ::sqlpp::sqlite3::test::get_memory_config;
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  using event_t = std::variant<::sqlpp::prepare_start_event,
+                               ::sqlpp::prepare_end_event,
+                               ::sqlpp::execute_start_event,
+                               ::sqlpp::execute_end_event,
+                               ::sqlpp::fetch_end_event,
+                               ::sqlpp::error_event>;
+
+  struct recording_instrumentation
+  {
+    std::vector<event_t>* events = nullptr;
+
+    template <typename Event>
+    auto operator()(const Event& event) -> void
+    {
+      events->push_back(event);
+    }
+  };
+
+  template <typename... Events>
+  auto assert_events(std::vector<event_t>& events, std::string_view message) -> void
+  {
+    assert_true(events.size() == sizeof...(Events), message);
+    auto index = std::size_t{};
+    (..., assert_true(std::holds_alternative<Events>(events[index++]), message));
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    auto events = std::vector<event_t>{};
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none, recording_instrumentation>{
+        get_memory_config(), recording_instrumentation{&events}};
+    static_assert(decltype(db)::is_instrumented());
+    static_assert(not ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>::is_instrumented());
+
+    db("CREATE TABLE tab_department (id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, division TEXT NOT NULL DEFAULT 'engineering')");
+    assert_events<::sqlpp::prepare_start_event, ::sqlpp::prepare_end_event, ::sqlpp::execute_start_event,
+                  ::sqlpp::execute_end_event>(events, "string query");
+    events.clear();
+
+    // Direct execution reports the statement type and the number of affected rows
+    const auto insert = insert_into(test::tabDepartment).set(test::tabDepartment.name = "hansi");
+    db(insert);
+    db(insert);
+    assert_events<::sqlpp::prepare_start_event, ::sqlpp::prepare_end_event, ::sqlpp::execute_start_event,
+                  ::sqlpp::execute_end_event, ::sqlpp::prepare_start_event, ::sqlpp::prepare_end_event,
+                  ::sqlpp::execute_start_event, ::sqlpp::execute_end_event>(events, "insert");
+    const auto& prepare_start = std::get<::sqlpp::prepare_start_event>(events[0]);
+    assert_true(prepare_start.statement_hash == ::sqlpp::type_hash(insert), "insert hash");
+    assert_true(not prepare_start.sql.empty(), "insert sql");
+    assert_true(std::get<::sqlpp::execute_end_event>(events[3]).rows == std::optional<std::size_t>{1}, "insert rows");
+    assert_true(std::get<::sqlpp::execute_end_event>(events[3]).time >=
+                    std::get<::sqlpp::execute_start_event>(events[2]).time,
+                "monotonic time");
+    events.clear();
+
+    db(update(test::tabDepartment).set(test::tabDepartment.division = "sales").unconditionally());
+    assert_true(std::get<::sqlpp::execute_end_event>(events.back()).rows == std::optional<std::size_t>{2},
+                "update rows");
+    events.clear();
+
+    // Rows of a select are not known when the execution ends, they are reported once the result is exhausted
+    for (const auto& row : db(select(test::tabDepartment.id).from(test::tabDepartment).unconditionally()))
+    {
+      [[maybe_unused]] const auto id = row.id;
+    }
+    assert_events<::sqlpp::prepare_start_event, ::sqlpp::prepare_end_event, ::sqlpp::execute_start_event,
+                  ::sqlpp::execute_end_event, ::sqlpp::fetch_end_event>(events, "select");
+    assert_true(not std::get<::sqlpp::execute_end_event>(events[3]).rows.has_value(), "select rows");
+    assert_true(std::get<::sqlpp::fetch_end_event>(events[4]).rows == 2, "select fetched rows");
+    events.clear();
+
+    // Prepared statements report prepare once and execute for each execution
+    auto prepared_delete = db.prepare(delete_from(test::tabDepartment).unconditionally());
+    execute(prepared_delete);
+    execute(prepared_delete);
+    assert_events<::sqlpp::prepare_start_event, ::sqlpp::prepare_end_event, ::sqlpp::execute_start_event,
+                  ::sqlpp::execute_end_event, ::sqlpp::execute_start_event, ::sqlpp::execute_end_event>(
+        events, "prepared delete");
+    assert_true(std::get<::sqlpp::execute_end_event>(events[3]).rows == std::optional<std::size_t>{2},
+                "prepared delete rows");
+    events.clear();
+
+    // Errors are reported before the exception is thrown
+    try
+    {
+      db("SELECT * FROM no_such_table");
+      assert_true(false, "missing exception");
+    }
+    catch (const ::sqlpp::exception&)
+    {
+    }
+    assert_events<::sqlpp::prepare_start_event, ::sqlpp::error_event>(events, "error");
+    assert_true(not std::get<::sqlpp::error_event>(events[1]).message.empty(), "error message");
+    events.clear();
+
+    // Pools hand their instrumentation to each connection
+    auto pool = ::sqlpp::sqlite3::connection_pool_t<::sqlpp::debug::none, recording_instrumentation>{
+        2, get_memory_config(), recording_instrumentation{&events}};
+    pool.get()("SELECT 1");
+    assert_true(events.size() == 4, "pool");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
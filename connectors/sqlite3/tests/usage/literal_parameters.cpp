@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sqlpp17/clause/create_table.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabFloat.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  auto count_statements(::sqlite3* db) -> int
+  {
+    auto count = 0;
+    for (auto* statement = sqlite3_next_stmt(db, nullptr); statement; statement = sqlite3_next_stmt(db, statement))
+    {
+      ++count;
+    }
+    return count;
+  }
+
+  template <typename Where>
+  auto count_floats(::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>& db, const Where& where) -> int
+  {
+    auto count = 0;
+    for ([[maybe_unused]] const auto& row : db(select(test::tabFloat.id).from(test::tabFloat).where(where)))
+    {
+      ++count;
+    }
+    return count;
+  }
+
+  // Rows found for the same float literals, with or without parameterization
+  auto select_floats(bool parameterize_literals) -> std::vector<int>
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    config.parameterize_literals = parameterize_literals;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db(create_table(test::tabFloat));
+    db(insert_into(test::tabFloat)
+           .set(test::tabFloat.valueFloat = 0.1f, test::tabFloat.valueDouble = 0.1, test::tabFloat.valueInt = 1));
+
+    return {count_floats(db, test::tabFloat.valueFloat == 0.1f), count_floats(db, test::tabFloat.valueFloat == 0.1),
+            count_floats(db, test::tabFloat.valueDouble == 0.1f), count_floats(db, test::tabFloat.valueDouble == 0.1)};
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    config.parameterize_literals = true;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    // Only inserts, updates, deletes and selects are parameterized, DEFAULT 'C++' must stay in the text
+    db(create_table(test::tabPerson));
+
+    // Inserts with different values share a prepared statement
+    const auto names = std::vector<std::string>{"a", "it's", "c", "d"};
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+      const auto id = db(insert_into(test::tabPerson).set(test::tabPerson.isManager = i % 2 == 0,
+                                                          test::tabPerson.name = names[i]));
+      assert_true(id == static_cast<sqlite3_int64>(i + 1), "insert id");
+    }
+    assert_true(count_statements(db.get()) == 1, "cached insert");
+
+    assert_true(db(update(test::tabPerson).set(test::tabPerson.address = "x").where(test::tabPerson.id > 2)) == 2,
+                "update");
+
+    // Text literals are copied, they have to outlive the call
+    for (const auto& name : names)
+    {
+      auto found = 0;
+      for (const auto& row : db(select(test::tabPerson.id, test::tabPerson.name)
+                                    .from(test::tabPerson)
+                                    .where(test::tabPerson.name == std::string(name))))
+      {
+        const std::string_view found_name = row.name;
+        assert_true(found_name == name, "selected name");
+        ++found;
+      }
+      assert_true(found == 1, "selected row");
+    }
+    assert_true(count_statements(db.get()) == 3, "cached select");
+
+    // Results that are still open keep their statement, a second one is prepared meanwhile
+    {
+      auto managers = db(select(test::tabPerson.id).from(test::tabPerson).where(test::tabPerson.isManager == true));
+      auto others = db(select(test::tabPerson.id).from(test::tabPerson).where(test::tabPerson.isManager == false));
+      auto manager_count = 0;
+      auto other_count = 0;
+      for (auto manager = managers.begin(), other = others.begin(); manager != managers.end(); ++manager, ++other)
+      {
+        ++manager_count;
+        other_count += other != others.end() ? 1 : 0;
+      }
+      assert_true(manager_count == 2 and other_count == 2, "interleaved results");
+    }
+    assert_true(count_statements(db.get()) == 5, "open results");
+
+    // Floats are bound as the value their text form represents
+    const auto text_rows = select_floats(false);
+    assert_true(text_rows == std::vector<int>{1, 1, 1, 1}, "float literals as text");
+    assert_true(select_floats(true) == text_rows, "float literals as parameters");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
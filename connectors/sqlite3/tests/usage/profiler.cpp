@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/operator.h>
+#include <sqlpp17/type_hash.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3/profiler.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  auto find_profile(const std::vector<::sqlpp::sqlite3::statement_profile>& profiles, std::uint32_t statement_hash)
+      -> const ::sqlpp::sqlite3::statement_profile&
+  {
+    for (const auto& profile : profiles)
+    {
+      if (profile.statement_hash == statement_hash)
+        return profile;
+    }
+    throw ::sqlpp::exception("Profiler: missing profile");
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    auto profiler = ::sqlpp::sqlite3::statement_profiler{};
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    config.profiler = &profiler;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+       "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+    for (const auto* name : {"a", "b", "c", "d"})
+    {
+      db(insert_into(test::tabPerson).set(test::tabPerson.isManager = false, test::tabPerson.name = name));
+    }
+
+    // Full scans and sorts show up in the counters of the statement type
+    const auto full_scan =
+        select(test::tabPerson.id).from(test::tabPerson).where(test::tabPerson.name == "c").order_by(asc(test::tabPerson.address));
+    for (auto i = 0; i < 2; ++i)
+    {
+      for (const auto& row : db(full_scan))
+      {
+        [[maybe_unused]] const auto id = row.id;
+      }
+    }
+
+    auto profiles = profiler.snapshot();
+    const auto& scan_profile = find_profile(profiles, ::sqlpp::type_hash(full_scan));
+    assert_true(scan_profile.status.runs == 2, "runs");
+    assert_true(scan_profile.status.fullscan_steps >= 2 * 3, "fullscan steps");
+    assert_true(scan_profile.status.sorts == 2, "sorts");
+    assert_true(scan_profile.status.vm_steps > 0 and scan_profile.status.memory_used > 0, "vm steps and memory");
+    assert_true(scan_profile.sql.find("WHERE tab_person.name = ?") != std::string::npos, "normalized sql");
+
+    const auto& insert_profile = find_profile(
+        profiles, ::sqlpp::type_hash(insert_into(test::tabPerson).set(test::tabPerson.isManager = false,
+                                                                       test::tabPerson.name = "a")));
+    assert_true(insert_profile.status.runs == 4 and insert_profile.status.fullscan_steps == 0, "insert");
+
+    // Lookups by primary key do not scan
+    auto by_id = db.prepare(select(test::tabPerson.name).from(test::tabPerson).where(test::tabPerson.id == 2));
+    for (const auto& row : execute(by_id))
+    {
+      [[maybe_unused]] const auto name = row.name;
+    }
+    assert_true(by_id.status().fullscan_steps == 0 and by_id.status().runs == 0, "prepared statement status");
+    const auto& by_id_profile = find_profile(profiler.snapshot(), ::sqlpp::type_hash(select(test::tabPerson.name)
+                                                                                         .from(test::tabPerson)
+                                                                                         .where(test::tabPerson.id == 2)));
+    assert_true(by_id_profile.status.runs == 1 and by_id_profile.status.fullscan_steps == 0, "by id profile");
+
+    // String queries are identified by their normalized text
+    db("SELECT COUNT(*) FROM tab_person WHERE name = 'a'");
+    db("SELECT COUNT(*) FROM tab_person WHERE name = 'b'");
+    profiles = profiler.snapshot();
+    auto string_query_runs = std::uint64_t{};
+    for (const auto& profile : profiles)
+    {
+      if (profile.sql.compare("SELECT COUNT(*) FROM tab_person WHERE name = ?") == 0)
+        string_query_runs += profile.status.runs;
+    }
+    assert_true(string_query_runs == 2, "string queries");
+
+    profiler.reset();
+    assert_true(profiler.snapshot().empty(), "reset");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,135 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/operator.h>
+#include <sqlpp17/retry.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  const auto path = std::filesystem::temp_directory_path() / "sqlpp17_sqlite3_usage_retry.db";
+  std::filesystem::remove(path);
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = path.string();
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    auto writer = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    writer("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+           "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+
+    auto metrics = ::sqlpp::retry_metrics{};
+    auto policy = ::sqlpp::retry_policy{};
+    policy.max_attempts = 100;
+    policy.initial_backoff = std::chrono::milliseconds{1};
+    policy.max_backoff = std::chrono::milliseconds{10};
+    policy.metrics = &metrics;
+
+    const auto insert = [](auto& connection) {
+      return connection(insert_into(test::tabPerson).set(test::tabPerson.isManager = false, test::tabPerson.name = "a"));
+    };
+
+    // Busy databases are classified as transient errors
+    writer("BEGIN IMMEDIATE");
+    auto busy = false;
+    try
+    {
+      db(insert_into(test::tabPerson).set(test::tabPerson.isManager = false, test::tabPerson.name = "a"));
+    }
+    catch (const ::sqlpp::exception& e)
+    {
+      busy = e.code() == ::sqlpp::error_code::busy and e.is_transient();
+    }
+    assert_true(busy, "busy error code");
+
+    // Retries succeed once the competing writer is done
+    auto competitor = std::thread{[&writer] {
+      std::this_thread::sleep_for(std::chrono::milliseconds{30});
+      writer("COMMIT");
+    }};
+    const auto id = ::sqlpp::with_retry(db, policy, insert);
+    competitor.join();
+    auto snapshot = metrics.snapshot();
+    assert_true(id > 0, "result");
+    assert_true(snapshot.calls == 1 and snapshot.retries > 0 and snapshot.attempts == snapshot.retries + 1, "retries");
+    assert_true(snapshot.recovered == 1 and snapshot.exhausted == 0, "recovered");
+
+    // The number of attempts is bounded
+    metrics.reset();
+    policy.max_attempts = 3;
+    writer("BEGIN IMMEDIATE");
+    auto exhausted = false;
+    try
+    {
+      ::sqlpp::with_retry(db, policy, insert);
+    }
+    catch (const ::sqlpp::exception& e)
+    {
+      exhausted = e.code() == ::sqlpp::error_code::busy;
+    }
+    writer("COMMIT");
+    snapshot = metrics.snapshot();
+    assert_true(exhausted and snapshot.attempts == 3 and snapshot.exhausted == 1, "exhausted");
+
+    // Other errors are not retried
+    metrics.reset();
+    auto failed = false;
+    try
+    {
+      ::sqlpp::with_retry(db, policy, [](auto& connection) { connection("INSERT INTO no_such_table VALUES (1)"); });
+    }
+    catch (const ::sqlpp::exception& e)
+    {
+      failed = not e.is_transient();
+    }
+    assert_true(failed and metrics.snapshot().attempts == 1, "permanent error");
+
+    // The connection is left without open transaction
+    ::sqlpp::with_retry(db, policy, [](auto& connection) { connection("DELETE FROM tab_person"); });
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    std::filesystem::remove(path);
+    return 1;
+  }
+  std::filesystem::remove(path);
+}
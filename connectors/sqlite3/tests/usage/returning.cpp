@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sqlpp17/clause/delete_from.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/operator.h>
+#include <sqlpp17/parameter.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::test::tabPerson;
+
+SQLPP_CREATE_NAME_TAG(personName);
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+       "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+
+    // Generated keys and defaults come back with the insert
+    auto ids = std::vector<std::int64_t>{};
+    for (const auto* name : {"Ada", "Bjarne", "Herb"})
+    {
+      for (const auto& row : db(insert_into(tabPerson)
+                                    .set(tabPerson.isManager = false, tabPerson.name = name)
+                                    .returning(tabPerson.id, tabPerson.language)))
+      {
+        ids.push_back(row.id);
+        assert_true(std::string_view{row.language} == "C++", "default value");
+      }
+    }
+    assert_true(ids == std::vector<std::int64_t>{1, 2, 3}, "generated keys");
+
+    // Updated values, also under another name
+    auto updated = 0;
+    for (const auto& row : db(update(tabPerson)
+                                  .set(tabPerson.isManager = true)
+                                  .where(tabPerson.id > 1)
+                                  .returning(tabPerson.id, tabPerson.isManager, tabPerson.name.as(personName))))
+    {
+      assert_true(row.isManager, "updated value");
+      assert_true(std::string_view{row.personName} != "Ada", "renamed column");
+      ++updated;
+    }
+    assert_true(updated == 2, "updated rows");
+
+    // Prepared statements with RETURNING
+    auto prepared_delete = db.prepare(delete_from(tabPerson)
+                                          .where(tabPerson.id == ::sqlpp::parameter<std::int64_t>(tabPerson.id))
+                                          .returning(tabPerson.name));
+    for (const auto id : ids)
+    {
+      prepared_delete.parameters.id = id;
+      auto names = std::vector<std::string>{};
+      for (const auto& row : execute(prepared_delete))
+      {
+        names.emplace_back(row.name);
+      }
+      assert_true(names.size() == 1, "deleted row");
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
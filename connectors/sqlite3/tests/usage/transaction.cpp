@@ -24,12 +24,34 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <cstdlib>
 #include <iostream>
 
+#include <sqlpp17/exception.h>
 #include <sqlpp17/transaction.h>
 
 #include <sqlpp17/sqlite3/connection.h>
 #include <sqlpp17/sqlite3_test/get_config.h>
+#include <sqlpp17_test/assert_true.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  auto count_rows(::sqlite3* handle) -> int
+  {
+    auto count = 0;
+    sqlite3_exec(
+        handle, "SELECT COUNT(*) FROM tx_test",
+        [](void* result, int, char** values, char**) {
+          *static_cast<int*>(result) = std::atoi(values[0]);
+          return 0;
+        },
+        &count, nullptr);
+    return count;
+  }
+
+}  // namespace
 
 int main()
 {
@@ -58,6 +80,102 @@ int main()
       // ...
       // tx' destructor will auto-rollback the transaction
     }
+
+    db("CREATE TABLE IF NOT EXISTS tx_test (id INTEGER)");
+    db("DELETE FROM tx_test");
+
+    // nested transactions
+    {
+      auto tx = start_transaction(
+          db, {::sqlpp::read_write, ::sqlpp::isolation_level::current, false, ::sqlpp::begin_mode::immediate});
+      db("INSERT INTO tx_test VALUES (1)");
+      {
+        auto inner = start_transaction(db);
+        db("INSERT INTO tx_test VALUES (2)");
+        inner.rollback();
+      }
+      {
+        auto inner = start_transaction(db);
+        db("INSERT INTO tx_test VALUES (3)");
+        {
+          auto innermost = start_transaction(db);
+          db("INSERT INTO tx_test VALUES (4)");
+          // innermost's destructor rolls back to its savepoint
+        }
+        inner.commit();
+      }
+      assert_true(db.transaction_depth() == 1, "depth");
+      tx.commit();
+    }
+    assert_true(count_rows(db.get()) == 2 and db.transaction_depth() == 0, "nested transactions");
+
+    // begin modes
+    for (const auto mode : {::sqlpp::begin_mode::deferred, ::sqlpp::begin_mode::immediate, ::sqlpp::begin_mode::exclusive})
+    {
+      auto options = ::sqlpp::transaction_options{};
+      options.begin = mode;
+      auto tx = start_transaction(db, options);
+      db("INSERT INTO tx_test VALUES (5)");
+      tx.commit();
+    }
+    assert_true(count_rows(db.get()) == 5, "begin modes");
+
+    // read only transactions
+    {
+      auto tx = start_transaction(db, {::sqlpp::read_only, ::sqlpp::isolation_level::repeatable_read});
+      assert_true(count_rows(db.get()) == 5, "read in read only transaction");
+      auto rejected = false;
+      try
+      {
+        db("INSERT INTO tx_test VALUES (6)");
+      }
+      catch (const ::sqlpp::exception&)
+      {
+        rejected = true;
+      }
+      assert_true(rejected, "write in read only transaction");
+      tx.commit();
+    }
+    db("INSERT INTO tx_test VALUES (6)");
+    assert_true(count_rows(db.get()) == 6, "write after read only transaction");
+    db("DROP TABLE tx_test");
+
+    // failed commits, here due to a deferred foreign key violation, leave the transaction open
+    db("PRAGMA foreign_keys = ON");
+    db("DROP TABLE IF EXISTS tx_child");
+    db("DROP TABLE IF EXISTS tx_parent");
+    db("CREATE TABLE tx_parent (id INTEGER PRIMARY KEY)");
+    db("CREATE TABLE tx_child (parent INTEGER REFERENCES tx_parent(id) DEFERRABLE INITIALLY DEFERRED)");
+    {
+      auto tx = start_transaction(db);
+      db("INSERT INTO tx_child VALUES (1)");
+      {
+        auto inner = start_transaction(db);
+        inner.commit();
+      }
+      assert_true(db.transaction_depth() == 1, "depth after nested commit");
+      auto failed = false;
+      try
+      {
+        tx.commit();
+      }
+      catch (const ::sqlpp::exception&)
+      {
+        failed = true;
+      }
+      assert_true(failed and db.transaction_depth() == 1 and not sqlite3_get_autocommit(db.get()), "failed commit");
+      tx.rollback();
+      assert_true(db.transaction_depth() == 0 and sqlite3_get_autocommit(db.get()), "rollback after failed commit");
+    }
+    db("INSERT INTO tx_parent VALUES (1)");
+    {
+      auto tx = start_transaction(db);
+      db("INSERT INTO tx_child VALUES (1)");
+      tx.commit();
+    }
+    assert_true(db.transaction_depth() == 0, "commit after failed commit");
+    db("DROP TABLE tx_child");
+    db("DROP TABLE tx_parent");
   }
   catch (const std::exception& e)
   {
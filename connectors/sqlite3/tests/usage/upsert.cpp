@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/operator.h>
+#include <sqlpp17/parameter.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabSetting.h>
+
+using ::test::tabSetting;
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  template <typename Db>
+  auto setting_of(Db& db, std::string_view name) -> std::pair<std::string, std::int64_t>
+  {
+    auto setting = std::pair<std::string, std::int64_t>{};
+    for (const auto& row : db(select(tabSetting.value, tabSetting.revision)
+                                  .from(tabSetting)
+                                  .where(tabSetting.name == std::string(name))))
+    {
+      setting = {std::string(row.value.value()), row.revision};
+    }
+    return setting;
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db("CREATE TABLE tab_setting (name TEXT PRIMARY KEY, value TEXT, revision INTEGER NOT NULL DEFAULT 0)");
+
+    db(insert_into(tabSetting).set(tabSetting.name = "theme", tabSetting.value = "dark"));
+
+    // Conflicting rows are left alone
+    db(insert_into(tabSetting)
+           .set(tabSetting.name = "theme", tabSetting.value = "light")
+           .on_conflict(tabSetting.name)
+           .do_nothing());
+    assert_true(setting_of(db, "theme") == std::pair<std::string, std::int64_t>{"dark", 0}, "do nothing");
+
+    // Conflicting rows are updated, new rows are inserted
+    const auto upsert = [&db](const auto& values) {
+      auto revisions = std::vector<std::int64_t>{};
+      for (const auto& row : db(insert_into(tabSetting)
+                                    .multiset(values)
+                                    .on_conflict(tabSetting.name)
+                                    .do_update(tabSetting.value = ::sqlpp::excluded(tabSetting.value),
+                                               tabSetting.revision = tabSetting.revision + 1)
+                                    .returning(tabSetting.revision)))
+      {
+        revisions.push_back(row.revision);
+      }
+      return revisions;
+    };
+    const auto revisions =
+        upsert(std::vector{std::tuple{tabSetting.name = "theme", tabSetting.value = std::string("light")},
+                           std::tuple{tabSetting.name = "font", tabSetting.value = std::string("mono")}});
+    assert_true(revisions == std::vector<std::int64_t>{1, 0}, "returned revisions");
+    assert_true(setting_of(db, "theme") == std::pair<std::string, std::int64_t>{"light", 1}, "updated row");
+    assert_true(setting_of(db, "font") == std::pair<std::string, std::int64_t>{"mono", 0}, "inserted row");
+
+    // Prepared upserts
+    auto prepared_upsert = db.prepare(insert_into(tabSetting)
+                                          .set(tabSetting.name = ::sqlpp::parameter<std::string>(tabSetting.name),
+                                               tabSetting.value = "sans")
+                                          .on_conflict(tabSetting.name)
+                                          .do_update(tabSetting.value = ::sqlpp::excluded(tabSetting.value)));
+    for (const auto* name : {"font", "font", "size"})
+    {
+      prepared_upsert.parameters.name = name;
+      execute(prepared_upsert);
+    }
+    assert_true(setting_of(db, "font") == std::pair<std::string, std::int64_t>{"sans", 0}, "prepared update");
+    assert_true(setting_of(db, "size") == std::pair<std::string, std::int64_t>{"sans", 0}, "prepared insert");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/function.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  SQLPP_CREATE_NAME_TAG(personCount);
+
+  template <typename Db, typename Condition>
+  auto count_persons(Db& db, const Condition& condition) -> std::int64_t
+  {
+    auto result = std::int64_t{-1};
+    for (const auto& row : db(select(::sqlpp::count(1).as(personCount)).from(test::tabPerson).where(condition)))
+    {
+      result = row.personCount;
+    }
+    return result;
+  }
+
+  auto test_value_lists(bool parameterize_literals) -> void
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = ":memory:";
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    config.parameterize_literals = parameterize_literals;
+
+    auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+    db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, name TEXT NOT NULL, "
+       "address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+
+    for (auto i = 0; i < 3000; ++i)
+    {
+      db(insert_into(test::tabPerson)
+             .set(test::tabPerson.isManager = i % 2 == 0, test::tabPerson.name = "person \"" + std::to_string(i) + "'"));
+    }
+
+    auto ids = std::vector<std::int64_t>{};
+    for (auto id = 1; id <= 3000; id += 2)
+    {
+      ids.push_back(id);
+    }
+    assert_true(count_persons(db, test::tabPerson.id.in(ids)) == 1500, "in");
+    assert_true(count_persons(db, test::tabPerson.id.not_in(ids)) == 1500, "not in");
+    assert_true(count_persons(db, test::tabPerson.id.in(std::vector<int>{2, 4, 4, 5000})) == 2, "duplicates");
+
+    const auto names = std::vector<std::string>{"person \"7'", "person \"8'", "nobody"};
+    assert_true(count_persons(db, in(test::tabPerson.name, names)) == 2, "text");
+
+    assert_true(count_persons(db, test::tabPerson.id.in(std::vector<std::int64_t>{})) == 0, "empty in");
+    assert_true(count_persons(db, test::tabPerson.id.not_in(std::vector<std::int64_t>{})) == 3000, "empty not in");
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    test_value_lists(false);
+    test_value_lists(true);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2018 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <vector>
+
+#include <sqlpp17/clause/delete_from.h>
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17/sqlite3/connection.h>
+#include <sqlpp17/sqlite3/worker.h>
+#include <sqlpp17_test/assert_true.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  constexpr auto write_count = 20;
+}  // namespace
+
+int main()
+{
+  const auto path = std::filesystem::temp_directory_path() / "sqlpp17_sqlite3_usage_worker.db";
+  std::filesystem::remove(path);
+  try
+  {
+    auto config = ::sqlpp::sqlite3::connection_config_t{};
+    config.path_to_database = path.string();
+    config.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+
+    {
+      auto db = ::sqlpp::sqlite3::connection_t<::sqlpp::debug::none>{config};
+      db("CREATE TABLE tab_person (id INTEGER PRIMARY KEY, is_manager BOOLEAN NOT NULL, "
+         "name TEXT NOT NULL CHECK (name <> 'bad'), address TEXT, language TEXT NOT NULL DEFAULT 'C++')");
+    }
+
+    auto worker = ::sqlpp::sqlite3::worker_t<::sqlpp::debug::none>{config};
+
+    // Keep the worker busy, so that the writes below queue up
+    auto release = std::promise<void>{};
+    auto blocker = worker.submit([released = release.get_future().share()](auto&) { released.wait(); });
+
+    auto inserts = std::vector<std::future<sqlite3_int64>>{};
+    for (auto i = 0; i < write_count; ++i)
+    {
+      inserts.push_back(
+          worker.submit(insert_into(test::tabPerson).set(test::tabPerson.isManager = i % 2 == 0, test::tabPerson.name = "a")));
+    }
+    auto bad = worker.submit(insert_into(test::tabPerson).set(test::tabPerson.isManager = true, test::tabPerson.name = "bad"));
+
+    // Selects are materialized: Their text fields own their memory
+    auto rows = worker.submit(select(test::tabPerson.id, test::tabPerson.name).from(test::tabPerson).unconditionally());
+
+    // Handlers are called on the worker thread
+    auto handled = std::promise<std::size_t>{};
+    worker.submit(select(test::tabPerson.isManager).from(test::tabPerson).where(test::tabPerson.isManager == true),
+                  [&handled](std::exception_ptr error, auto managers) {
+                    handled.set_value(error ? 0 : managers.size());
+                  });
+
+    assert_true(worker.stats().queue_depth >= write_count, "queue depth");
+    release.set_value();
+    blocker.get();
+
+    for (auto& insert : inserts)
+    {
+      insert.get();
+    }
+
+    auto failed = false;
+    try
+    {
+      bad.get();
+    }
+    catch (const ::sqlpp::exception&)
+    {
+      failed = true;
+    }
+    assert_true(failed, "failed write");
+
+    const auto selected = rows.get();
+    assert_true(selected.size() == write_count, "selected rows");
+    for (const auto& row : selected)
+    {
+      const std::string& name = row.name;
+      assert_true(name.compare("a") == 0, "materialized text");
+    }
+    assert_true(handled.get_future().get() == write_count / 2, "handler");
+
+    const auto stats = worker.stats();
+    assert_true(stats.tasks == write_count + 4 and stats.failures == 1, "tasks");
+    assert_true(stats.batches == 1 and stats.max_queue_depth >= write_count + 1, "batches");
+    assert_true(stats.queue_depth == 0, "empty queue");
+
+    // Functions run in order with the statements
+    auto deleted = worker.submit(delete_from(test::tabPerson).unconditionally());
+    auto count = worker.submit([](auto& connection) {
+      return ::sqlpp::materialize(connection(select(test::tabPerson.id).from(test::tabPerson).unconditionally())).size();
+    });
+    assert_true(deleted.get() == write_count and count.get() == 0, "delete");
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+    std::filesystem::remove(path);
+    return 1;
+  }
+  std::filesystem::remove(path);
+}
@@ -72,7 +72,9 @@ namespace sqlpp
   template <typename Context, typename L, typename Operator, typename R>
   [[nodiscard]] auto to_sql_string(Context& context, const binary_t<L, Operator, R>& t)
   {
-    return to_sql_string(context, embrace(t._l)) + Operator::symbol + to_sql_string(context, embrace(t._r));
+    auto ret = to_sql_string(context, embrace(t._l));
+    ret += Operator::symbol;
+    return ret + to_sql_string(context, embrace(t._r));
   }
 
   template <typename Context, typename Operator, typename R>
@@ -0,0 +1,460 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sqlpp17/exception.h>
+
+namespace sqlpp
+{
+  using deadline_clock = std::chrono::steady_clock;
+
+  enum class interrupt_reason
+  {
+    none,
+    deadline,
+    cancelled
+  };
+
+  namespace detail
+  {
+    class interrupt_guard;
+
+    [[noreturn]] inline auto throw_interrupted(interrupt_reason reason, const std::string& message) -> void
+    {
+      if (reason == interrupt_reason::deadline)
+      {
+        throw ::sqlpp::timeout_exception(message + ": deadline exceeded");
+      }
+      throw ::sqlpp::cancelled_exception(message + ": cancelled");
+    }
+  }  // namespace detail
+
+  // Cancels the statements of all connections it is set on, see execution_limits.
+  // Copies share their state. Tokens can be cancelled from any thread, but cannot be reset.
+  class cancellation_token
+  {
+    struct state
+    {
+      std::atomic<bool> _cancelled = false;
+      std::mutex _mutex;
+      std::uint64_t _next_id = 0;
+      std::vector<std::pair<std::uint64_t, std::function<void()>>> _interrupts;
+    };
+
+    std::shared_ptr<state> _state = std::make_shared<state>();
+
+    friend class detail::interrupt_guard;
+
+    auto add_interrupt(std::function<void()> interrupt) const -> std::uint64_t
+    {
+      const auto lock = std::lock_guard{_state->_mutex};
+      const auto id = ++_state->_next_id;
+      _state->_interrupts.emplace_back(id, std::move(interrupt));
+      return id;
+    }
+
+    auto remove_interrupt(std::uint64_t id) const -> void
+    {
+      const auto lock = std::lock_guard{_state->_mutex};
+      auto& interrupts = _state->_interrupts;
+      for (std::size_t i = 0; i < interrupts.size(); ++i)
+      {
+        if (interrupts[i].first == id)
+        {
+          interrupts.erase(interrupts.begin() + static_cast<std::ptrdiff_t>(i));
+          return;
+        }
+      }
+    }
+
+  public:
+    auto cancel() const -> void
+    {
+      _state->_cancelled = true;
+      const auto lock = std::lock_guard{_state->_mutex};
+      for (std::size_t i = 0; i < _state->_interrupts.size(); ++i)
+      {
+        _state->_interrupts[i].second();
+      }
+    }
+
+    [[nodiscard]] auto is_cancelled() const -> bool
+    {
+      return _state->_cancelled;
+    }
+  };
+
+  // Deadline, per statement timeout and cancellation token of a connection.
+  // Connectors call begin_statement() before each statement and interrupt it natively once a limit is hit.
+  class execution_limits
+  {
+    std::optional<deadline_clock::duration> _statement_timeout;
+    std::optional<deadline_clock::time_point> _deadline;
+    std::optional<cancellation_token> _token;
+
+    // Limits of the statement currently running (or being fetched) on the connection
+    bool _active = false;
+    std::optional<deadline_clock::time_point> _active_deadline;
+    interrupt_reason _reason = interrupt_reason::none;
+
+  public:
+    // Applies to each statement separately, from its execution up to fetching the last row
+    template <typename Rep, typename Period>
+    auto set_statement_timeout(std::chrono::duration<Rep, Period> timeout) -> void
+    {
+      _statement_timeout = std::chrono::ceil<deadline_clock::duration>(timeout);
+    }
+
+    auto clear_statement_timeout() -> void
+    {
+      _statement_timeout.reset();
+    }
+
+    // Applies to all statements until cleared
+    auto set_deadline(deadline_clock::time_point deadline) -> void
+    {
+      _deadline = deadline;
+    }
+
+    auto clear_deadline() -> void
+    {
+      _deadline.reset();
+    }
+
+    auto set_cancellation_token(cancellation_token token) -> void
+    {
+      _token = std::move(token);
+    }
+
+    auto clear_cancellation_token() -> void
+    {
+      _token.reset();
+    }
+
+    [[nodiscard]] auto is_limited() const -> bool
+    {
+      return _statement_timeout.has_value() or _deadline.has_value() or _token.has_value();
+    }
+
+    // Throws if the statement must not start at all. Returns true if the statement is limited.
+    auto begin_statement() -> bool
+    {
+      _reason = interrupt_reason::none;
+      _active = is_limited();
+      _active_deadline = _deadline;
+      if (not _active)
+      {
+        return false;
+      }
+
+      if (_statement_timeout)
+      {
+        const auto end = deadline_clock::now() + *_statement_timeout;
+        if (not _active_deadline or std::less<>{}(end, *_active_deadline))
+        {
+          _active_deadline = end;
+        }
+      }
+
+      if (const auto reason = check(); reason != interrupt_reason::none)
+      {
+        detail::throw_interrupted(reason, "Statement not started");
+      }
+      return true;
+    }
+
+    // Cheap enough to be called from progress handlers while a statement is running
+    auto check() -> interrupt_reason
+    {
+      if (_active and _reason == interrupt_reason::none)
+      {
+        if (_token and _token->is_cancelled())
+        {
+          _reason = interrupt_reason::cancelled;
+        }
+        else if (_active_deadline and not std::less<>{}(deadline_clock::now(), *_active_deadline))
+        {
+          _reason = interrupt_reason::deadline;
+        }
+      }
+      return _reason;
+    }
+
+    [[nodiscard]] auto reason() const -> interrupt_reason
+    {
+      return _reason;
+    }
+
+    [[nodiscard]] auto active_deadline() const -> const std::optional<deadline_clock::time_point>&
+    {
+      return _active_deadline;
+    }
+
+    [[nodiscard]] auto active_token() const -> const cancellation_token*
+    {
+      return (_active and _token) ? &*_token : nullptr;
+    }
+  };
+
+  // Connections inherit this privately. The limits live on the heap, so that prepared statements and
+  // results can refer to them while the connection is moved.
+  class execution_limits_base
+  {
+    std::unique_ptr<execution_limits> _execution_limits = std::make_unique<execution_limits>();
+
+  public:
+    template <typename Rep, typename Period>
+    auto set_statement_timeout(std::chrono::duration<Rep, Period> timeout) -> void
+    {
+      _execution_limits->set_statement_timeout(timeout);
+    }
+
+    auto clear_statement_timeout() -> void
+    {
+      _execution_limits->clear_statement_timeout();
+    }
+
+    auto set_deadline(deadline_clock::time_point deadline) -> void
+    {
+      _execution_limits->set_deadline(deadline);
+    }
+
+    auto clear_deadline() -> void
+    {
+      _execution_limits->clear_deadline();
+    }
+
+    auto set_cancellation_token(cancellation_token token) -> void
+    {
+      _execution_limits->set_cancellation_token(std::move(token));
+    }
+
+    auto clear_cancellation_token() -> void
+    {
+      _execution_limits->clear_cancellation_token();
+    }
+
+    [[nodiscard]] auto limits() const -> execution_limits*
+    {
+      return _execution_limits.get();
+    }
+  };
+
+  namespace detail
+  {
+    // A single thread firing the interrupts of statements whose deadline passed.
+    // It is started with the first limited statement of connectors that cannot check deadlines themselves.
+    class deadline_watchdog
+    {
+      struct entry
+      {
+        std::uint64_t id;
+        deadline_clock::time_point deadline;
+        std::function<void()> fire;
+      };
+
+      std::mutex _mutex;
+      std::condition_variable _wakeup;
+      std::condition_variable _fired;
+      std::vector<entry> _entries;
+      std::uint64_t _next_id = 0;
+      std::uint64_t _firing = 0;
+      bool _stop = false;
+      std::thread _thread;
+
+      deadline_watchdog() = default;
+
+      auto run() -> void
+      {
+        auto lock = std::unique_lock{_mutex};
+        while (not _stop)
+        {
+          if (_entries.empty())
+          {
+            _wakeup.wait(lock);
+            continue;
+          }
+
+          std::size_t next = 0;
+          for (std::size_t i = 1; i < _entries.size(); ++i)
+          {
+            if (std::less<>{}(_entries[i].deadline, _entries[next].deadline))
+              next = i;
+          }
+
+          if (std::less<>{}(deadline_clock::now(), _entries[next].deadline))
+          {
+            _wakeup.wait_until(lock, _entries[next].deadline);
+            continue;
+          }
+
+          auto fire = std::move(_entries[next].fire);
+          _firing = _entries[next].id;
+          _entries.erase(_entries.begin() + static_cast<std::ptrdiff_t>(next));
+
+          // Interrupting might involve network round trips, so do it without blocking other statements
+          lock.unlock();
+          fire();
+          lock.lock();
+
+          _firing = 0;
+          _fired.notify_all();
+        }
+      }
+
+    public:
+      deadline_watchdog(const deadline_watchdog&) = delete;
+      deadline_watchdog& operator=(const deadline_watchdog&) = delete;
+
+      ~deadline_watchdog()
+      {
+        {
+          const auto lock = std::lock_guard{_mutex};
+          _stop = true;
+        }
+        _wakeup.notify_all();
+        if (_thread.joinable())
+          _thread.join();
+      }
+
+      static auto instance() -> deadline_watchdog&
+      {
+        static auto watchdog = deadline_watchdog{};
+        return watchdog;
+      }
+
+      auto add(deadline_clock::time_point deadline, std::function<void()> fire) -> std::uint64_t
+      {
+        const auto lock = std::lock_guard{_mutex};
+        if (not _thread.joinable())
+        {
+          _thread = std::thread{[this] { run(); }};
+        }
+        const auto id = ++_next_id;
+        _entries.push_back(entry{id, deadline, std::move(fire)});
+        _wakeup.notify_all();
+        return id;
+      }
+
+      // Returns once the entry is guaranteed not to fire anymore
+      auto remove(std::uint64_t id) -> void
+      {
+        auto lock = std::unique_lock{_mutex};
+        for (std::size_t i = 0; i < _entries.size(); ++i)
+        {
+          if (_entries[i].id == id)
+          {
+            _entries.erase(_entries.begin() + static_cast<std::ptrdiff_t>(i));
+            return;
+          }
+        }
+        _fired.wait(lock, [&] { return _firing != id; });
+      }
+    };
+
+    // Interrupts a blocking call of a connector from another thread, if the deadline of the running statement
+    // passes or its cancellation token is cancelled while the guard is alive.
+    // Interrupts that arrive while the connection is idle are expected to be ignored by the server.
+    class interrupt_guard
+    {
+      std::function<void()> _interrupt;
+      std::atomic<interrupt_reason> _reason = interrupt_reason::none;
+      const cancellation_token* _token = nullptr;
+      std::uint64_t _token_id = 0;
+      std::uint64_t _deadline_id = 0;
+
+      auto fire(interrupt_reason reason) -> void
+      {
+        auto expected = interrupt_reason::none;
+        if (_reason.compare_exchange_strong(expected, reason))
+        {
+          _interrupt();
+        }
+      }
+
+    public:
+      interrupt_guard(const execution_limits& limits, std::function<void()> interrupt)
+          : _interrupt(std::move(interrupt))
+      {
+        if (const auto* token = limits.active_token())
+        {
+          _token = token;
+          _token_id = token->add_interrupt([this] { fire(interrupt_reason::cancelled); });
+          if (token->is_cancelled())
+          {
+            token->remove_interrupt(_token_id);
+            throw_interrupted(interrupt_reason::cancelled, "Statement not started");
+          }
+        }
+
+        if (const auto& deadline = limits.active_deadline())
+        {
+          try
+          {
+            _deadline_id = deadline_watchdog::instance().add(*deadline, [this] { fire(interrupt_reason::deadline); });
+          }
+          catch (...)
+          {
+            // The destructor does not run, the token must not keep calling into this guard
+            if (_token)
+              _token->remove_interrupt(_token_id);
+            throw;
+          }
+        }
+      }
+
+      interrupt_guard(const interrupt_guard&) = delete;
+      interrupt_guard& operator=(const interrupt_guard&) = delete;
+
+      ~interrupt_guard()
+      {
+        if (_deadline_id)
+          deadline_watchdog::instance().remove(_deadline_id);
+        if (_token)
+          _token->remove_interrupt(_token_id);
+      }
+
+      [[nodiscard]] auto reason() const -> interrupt_reason
+      {
+        return _reason;
+      }
+    };
+  }  // namespace detail
+}  // namespace sqlpp
@@ -0,0 +1,319 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sqlpp17/clause_fwd.h>
+#include <sqlpp17/free_column.h>
+#include <sqlpp17/statement.h>
+#include <sqlpp17/to_sql_string.h>
+#include <sqlpp17/type_traits.h>
+#include <sqlpp17/wrapped_static_assert.h>
+
+namespace sqlpp
+{
+  namespace clause
+  {
+    struct bulk_update
+    {
+    };
+  }  // namespace clause
+
+  // Updates Columns of the rows identified by Key, each with its own values. Rows are tuples of the key value
+  // followed by the values of Columns.
+  template <typename Table, typename Key, typename Row, typename... Columns>
+  struct bulk_update_t
+  {
+    Table _table;
+    std::vector<Row> _rows;
+  };
+
+  template <typename Table, typename Key, typename Row, typename... Columns>
+  struct nodes_of<bulk_update_t<Table, Key, Row, Columns...>>
+  {
+    using type = type_vector<Table>;
+  };
+
+  template <typename Table, typename Key, typename Row, typename... Columns>
+  constexpr auto clause_tag<bulk_update_t<Table, Key, Row, Columns...>> = clause::bulk_update{};
+
+  template <typename Table, typename Key, typename Row, typename... Columns, typename Statement>
+  class clause_base<bulk_update_t<Table, Key, Row, Columns...>, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    clause_base(const clause_base<bulk_update_t<Table, Key, Row, Columns...>, OtherStatement>& s)
+        : _table(s._table), _rows(s._rows)
+    {
+    }
+
+    clause_base(const bulk_update_t<Table, Key, Row, Columns...>& f) : _table(f._table), _rows(f._rows)
+    {
+    }
+
+    // Splits the rows into statements of at most max_rows rows each
+    [[nodiscard]] auto chunks(std::size_t max_rows) const
+    {
+      max_rows = std::max<std::size_t>(max_rows, 1);
+      auto statements = std::vector<Statement>{};
+      statements.reserve((_rows.size() + max_rows - 1) / max_rows);
+      for (std::size_t begin = 0; begin < _rows.size(); begin += max_rows)
+      {
+        const auto end = std::min(begin + max_rows, _rows.size());
+        statements.push_back(Statement{bulk_update_t<Table, Key, Row, Columns...>{
+            _table, std::vector<Row>(_rows.begin() + static_cast<std::ptrdiff_t>(begin),
+                                     _rows.begin() + static_cast<std::ptrdiff_t>(end))}});
+      }
+      return statements;
+    }
+
+    Table _table;
+    std::vector<Row> _rows;
+  };
+
+  template <typename Table, typename Key, typename Row, typename... Columns>
+  constexpr auto is_result_clause_v<bulk_update_t<Table, Key, Row, Columns...>> = true;
+
+  template <typename Table, typename Key, typename Row, typename... Columns>
+  struct clause_result_type<bulk_update_t<Table, Key, Row, Columns...>>
+  {
+    using type = update_result;
+  };
+
+  namespace detail
+  {
+    // Without rows, nothing is to be updated, but the statement should still be valid
+    template <typename Context, typename Table, typename Key, typename Row, typename... Columns, typename Statement>
+    [[nodiscard]] auto empty_bulk_update_to_sql_string(
+        Context& context, const clause_base<bulk_update_t<Table, Key, Row, Columns...>, Statement>& t)
+    {
+      auto ret = "UPDATE " + to_sql_string(context, t._table);
+      ret += " SET ";
+      ret += to_sql_string(context, free_column_t<Key>{});
+      ret += " = ";
+      return ret + to_sql_string(context, free_column_t<Key>{}) + " WHERE 1 = 0";
+    }
+
+    // Column = CASE key WHEN key_0 THEN value_0 WHEN ... ELSE column END
+    template <std::size_t Index, typename Context, typename Key, typename Column, typename Rows>
+    [[nodiscard]] auto bulk_update_case_to_sql_string(Context& context, const Key& key, const Column& column,
+                                                      const Rows& rows)
+    {
+      auto ret = to_sql_string(context, free_column_t<Column>{});
+      ret += " = CASE ";
+      ret += to_sql_string(context, key);
+      for (const auto& row : rows)
+      {
+        ret += " WHEN ";
+        ret += to_sql_string(context, std::get<0>(row));
+        ret += " THEN ";
+        ret += to_sql_string(context, std::get<Index + 1>(row));
+      }
+      ret += " ELSE ";
+      return ret + to_sql_string(context, column) + " END";
+    }
+
+    template <typename Context, typename Key, typename Rows, typename... Columns, std::size_t... Is>
+    [[nodiscard]] auto bulk_update_cases_to_sql_string(Context& context, const Key& key, const Rows& rows,
+                                                       std::index_sequence<Is...>)
+    {
+      auto ret = std::string{};
+      ((ret += (Is ? ", " : "") + bulk_update_case_to_sql_string<Is>(context, key, Columns{}, rows)), ...);
+      return ret;
+    }
+  }  // namespace detail
+
+  // Portable form, e.g. UPDATE t SET c = CASE t.k WHEN 1 THEN 'a' WHEN 2 THEN 'b' ELSE t.c END WHERE t.k IN (1, 2)
+  template <typename Context, typename Table, typename Key, typename Row, typename... Columns, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context,
+                                   const clause_base<bulk_update_t<Table, Key, Row, Columns...>, Statement>& t)
+  {
+    if (t._rows.empty())
+    {
+      return detail::empty_bulk_update_to_sql_string(context, t);
+    }
+
+    auto ret = "UPDATE " + to_sql_string(context, t._table);
+    ret += " SET ";
+    ret += detail::bulk_update_cases_to_sql_string<Context, Key, std::vector<Row>, Columns...>(
+        context, Key{}, t._rows, std::index_sequence_for<Columns...>{});
+    ret += " WHERE ";
+    ret += to_sql_string(context, Key{});
+    ret += " IN (";
+    for (std::size_t i = 0; i < t._rows.size(); ++i)
+    {
+      if (i)
+        ret += ", ";
+      ret += to_sql_string(context, std::get<0>(t._rows[i]));
+    }
+    return ret + ")";
+  }
+
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_rows_match_columns,
+                              "rows() must be tuples of the key value followed by one value per column");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_key_value_is_not_optional, "rows() key values must not be optional");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_row_values_are_compatible,
+                              "rows() values must be compatible with the key and the columns");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_optional_values_for_nullable_columns_only,
+                              "rows() values must not be optional for columns that cannot be NULL");
+
+  template <typename Key, typename... Columns>
+  struct bulk_update_row_check
+  {
+    template <typename KeyValue, typename... Values>
+    static constexpr auto check(type_t<std::tuple<KeyValue, Values...>>)
+    {
+      if constexpr (sizeof...(Values) != sizeof...(Columns))
+      {
+        return failed<assert_bulk_update_rows_match_columns>{};
+      }
+      else if constexpr (is_optional_v<KeyValue>)
+      {
+        return failed<assert_bulk_update_key_value_is_not_optional>{};
+      }
+      else if constexpr (not(values_are_compatible_v<Key, KeyValue> and ... and
+                             values_are_compatible_v<Columns, remove_optional_t<Values>>))
+      {
+        return failed<assert_bulk_update_row_values_are_compatible>{};
+      }
+      else if constexpr ((false or ... or (is_optional_v<Values> and not can_be_null_v<Columns>)))
+      {
+        return failed<assert_bulk_update_optional_values_for_nullable_columns_only>{};
+      }
+      else
+        return succeeded{};
+    }
+
+    static constexpr auto check(...)
+    {
+      return failed<assert_bulk_update_rows_match_columns>{};
+    }
+  };
+
+  template <typename Table, typename Key, typename... Columns>
+  struct bulk_update_columns_t
+  {
+    Table _table;
+
+    template <typename Row>
+    [[nodiscard]] auto rows(std::vector<Row> rows) const
+    {
+      if constexpr (constexpr auto _check = bulk_update_row_check<Key, Columns...>::check(type_v<Row>); _check)
+      {
+        return statement<bulk_update_t<Table, Key, Row, Columns...>>{
+            bulk_update_t<Table, Key, Row, Columns...>{_table, std::move(rows)}};
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+  };
+
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_arg_is_table, "bulk_update() first arg has to be a table");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_at_least_one_column,
+                              "bulk_update() requires at least one column to update");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_args_are_columns_of_table,
+                              "bulk_update() key and columns must be columns of the table");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_args_contain_no_duplicates,
+                              "bulk_update() key and columns must not contain duplicates");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_bulk_update_columns_are_not_read_only,
+                              "at least one column of bulk_update() is read-only");
+
+  template <typename Table, typename Key, typename... Columns>
+  constexpr auto check_bulk_update_args()
+  {
+    if constexpr (!is_table_v<Table> or is_join_v<Table> or is_cte_v<Table>)
+    {
+      return failed<assert_bulk_update_arg_is_table>{};
+    }
+    else if constexpr (sizeof...(Columns) == 0)
+    {
+      return failed<assert_bulk_update_at_least_one_column>{};
+    }
+    else if constexpr (!(is_column_v<Key> and ... and is_column_v<Columns>))
+    {
+      return failed<assert_bulk_update_args_are_columns_of_table>{};
+    }
+    else if constexpr (!(std::is_same_v<table_spec_of_t<Key>, table_spec_of_t<Table>> and ... and
+                         std::is_same_v<table_spec_of_t<Columns>, table_spec_of_t<Table>>))
+    {
+      return failed<assert_bulk_update_args_are_columns_of_table>{};
+    }
+    else if constexpr (!names_are_unique<Key, Columns...>())
+    {
+      return failed<assert_bulk_update_args_contain_no_duplicates>{};
+    }
+    else if constexpr ((false || ... || is_read_only_v<Columns>))
+    {
+      return failed<assert_bulk_update_columns_are_not_read_only>{};
+    }
+    else
+      return succeeded{};
+  }
+
+  template <typename Table, typename Key, typename... Columns>
+  [[nodiscard]] constexpr auto bulk_update(Table table, Key, Columns...)
+  {
+    if constexpr (constexpr auto _check = check_bulk_update_args<Table, Key, Columns...>(); _check)
+    {
+      return bulk_update_columns_t<Table, Key, Columns...>{table};
+    }
+    else
+    {
+      return ::sqlpp::bad_expression_t{_check};
+    }
+  }
+
+  // Rows per statement of execute_bulk_update(), keeps CASE expressions and statement texts at a moderate size
+  constexpr auto bulk_update_max_rows = std::size_t{1000};
+
+  // Executes the bulk update with as many statements as the parameter limit of the connection and max_rows
+  // require, see connection_t::max_statement_parameters(). Returns the number of affected rows.
+  template <typename Connection, typename Table, typename Key, typename Row, typename... Columns>
+  auto execute_bulk_update(Connection& connection,
+                           const statement<bulk_update_t<Table, Key, Row, Columns...>>& bulk,
+                           std::size_t max_rows = bulk_update_max_rows) -> std::size_t
+  {
+    // The CASE form uses most parameters: the key for every column and in the IN list, plus the values
+    constexpr auto parameters_per_row = 2 * sizeof...(Columns) + 1;
+    const auto rows = std::min(max_rows, connection.max_statement_parameters() / parameters_per_row);
+
+    auto affected_rows = std::size_t{};
+    for (const auto& chunk : bulk.chunks(rows))
+    {
+      affected_rows += static_cast<std::size_t>(connection(chunk));
+    }
+    return affected_rows;
+  }
+}  // namespace sqlpp
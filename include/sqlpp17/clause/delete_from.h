@@ -27,6 +27,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <sqlpp17/clause/from.h>
+#include <sqlpp17/clause/returning.h>
 #include <sqlpp17/clause/where.h>
 #include <sqlpp17/clause_fwd.h>
 #include <sqlpp17/type_traits.h>
@@ -125,7 +126,7 @@ namespace sqlpp
   {
     if constexpr (constexpr auto _check = check_delete_from_arg<Table>(); _check)
     {
-      return statement<delete_from_t<Table>>{table} << statement<no_where_t>{};
+      return statement<delete_from_t<Table>>{table} << statement<no_where_t, no_returning_t>{};
     }
     else
     {
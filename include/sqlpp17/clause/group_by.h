@@ -61,8 +61,8 @@ namespace sqlpp
     static constexpr auto value = type_set<Columns...>();
   };
 
-  template <typename Table>
-  constexpr auto clause_tag<group_by_t<Table>> = clause::group_by{};
+  template <typename... Columns>
+  constexpr auto clause_tag<group_by_t<Columns...>> = clause::group_by{};
 
   template <typename... Columns, typename Statement>
   class clause_base<group_by_t<Columns...>, Statement>
@@ -27,6 +27,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <sqlpp17/clause/insert_values.h>
+#include <sqlpp17/clause/on_conflict.h>
+#include <sqlpp17/clause/returning.h>
 #include <sqlpp17/clause_fwd.h>
 #include <sqlpp17/statement.h>
 #include <sqlpp17/type_traits.h>
@@ -120,7 +122,7 @@ namespace sqlpp
     constexpr auto _check = check_insert_into_arg(t);
     if constexpr (_check)
     {
-      return statement<insert_into_t<Table>>{t} << statement<no_insert_values_t>{};
+      return statement<insert_into_t<Table>>{t} << statement<no_insert_values_t, no_on_conflict_t, no_returning_t>{};
     }
     else
     {
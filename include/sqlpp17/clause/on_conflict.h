@@ -0,0 +1,425 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <tuple>
+
+#include <sqlpp17/clause/update_set.h>
+#include <sqlpp17/clause_fwd.h>
+#include <sqlpp17/excluded.h>
+#include <sqlpp17/free_column.h>
+#include <sqlpp17/statement.h>
+#include <sqlpp17/tuple_to_sql_string.h>
+#include <sqlpp17/type_traits.h>
+#include <sqlpp17/wrapped_static_assert.h>
+
+namespace sqlpp
+{
+  namespace clause
+  {
+    struct on_conflict
+    {
+    };
+  }  // namespace clause
+
+  // conflict target, requires do_nothing() or do_update() to become a complete clause
+  template <typename... Columns>
+  struct on_conflict_t
+  {
+    std::tuple<Columns...> _columns;
+  };
+
+  template <typename Target>
+  struct on_conflict_do_nothing_t
+  {
+    Target _target;
+  };
+
+  template <typename Target, typename... Assignments>
+  struct on_conflict_do_update_t
+  {
+    Target _target;
+    std::tuple<Assignments...> _assignments;
+  };
+
+  template <typename... Assignments>
+  struct on_duplicate_key_update_t
+  {
+    std::tuple<Assignments...> _assignments;
+  };
+
+  template <typename... Columns>
+  struct nodes_of<on_conflict_t<Columns...>>
+  {
+    using type = type_vector<Columns...>;
+  };
+
+  template <typename Target>
+  struct nodes_of<on_conflict_do_nothing_t<Target>>
+  {
+    using type = type_vector<Target>;
+  };
+
+  template <typename Target, typename... Assignments>
+  struct nodes_of<on_conflict_do_update_t<Target, Assignments...>>
+  {
+    using type = type_vector<Target, Assignments...>;
+  };
+
+  template <typename... Assignments>
+  struct nodes_of<on_duplicate_key_update_t<Assignments...>>
+  {
+    using type = type_vector<Assignments...>;
+  };
+
+  template <typename... Columns>
+  constexpr auto clause_tag<on_conflict_t<Columns...>> = clause::on_conflict{};
+
+  template <typename Target>
+  constexpr auto clause_tag<on_conflict_do_nothing_t<Target>> = clause::on_conflict{};
+
+  template <typename Target, typename... Assignments>
+  constexpr auto clause_tag<on_conflict_do_update_t<Target, Assignments...>> = clause::on_conflict{};
+
+  template <typename... Assignments>
+  constexpr auto clause_tag<on_duplicate_key_update_t<Assignments...>> = clause::on_conflict{};
+
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_do_update_has_target,
+                              "do_update() requires at least one conflict target column in on_conflict()");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_update_at_least_one_arg, "at least one assignment required");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_update_args_are_assignments,
+                              "at least one argument is not an assignment");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_update_args_contain_no_duplicates,
+                              "at least one duplicate column detected in assignments");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_update_assignments_are_allowed,
+                              "at least one assignment is prohibited by its column definition");
+
+  template <typename... Assignments>
+  constexpr auto check_on_conflict_update_args()
+  {
+    if constexpr (sizeof...(Assignments) == 0)
+    {
+      return failed<assert_on_conflict_update_at_least_one_arg>{};
+    }
+    else if constexpr (!(true && ... && is_assignment_v<remove_optional_t<Assignments>>))
+    {
+      return failed<assert_on_conflict_update_args_are_assignments>{};
+    }
+    else if constexpr (!names_are_unique<column_of_t<remove_optional_t<Assignments>>...>())
+    {
+      return failed<assert_on_conflict_update_args_contain_no_duplicates>{};
+    }
+    else if constexpr ((false || ... || is_read_only_v<column_of_t<remove_optional_t<Assignments>>>))
+    {
+      return failed<assert_on_conflict_update_assignments_are_allowed>{};
+    }
+    else
+      return succeeded{};
+  }
+
+  template <typename... Columns, typename Statement>
+  class clause_base<on_conflict_t<Columns...>, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    clause_base(const clause_base<on_conflict_t<Columns...>, OtherStatement>& s) : _columns(s._columns)
+    {
+    }
+
+    clause_base(const on_conflict_t<Columns...>& f) : _columns(f._columns)
+    {
+    }
+
+    [[nodiscard]] constexpr auto do_nothing() const
+    {
+      return new_statement(*this, on_conflict_do_nothing_t<on_conflict_t<Columns...>>{{_columns}});
+    }
+
+    template <typename... Assignments>
+    [[nodiscard]] constexpr auto do_update(Assignments... assignments) const
+    {
+      if constexpr (sizeof...(Columns) == 0)
+      {
+        return ::sqlpp::bad_expression_t{failed<assert_on_conflict_do_update_has_target>{}};
+      }
+      else if constexpr (constexpr auto _check = check_on_conflict_update_args<Assignments...>(); _check)
+      {
+        return new_statement(*this, on_conflict_do_update_t<on_conflict_t<Columns...>, Assignments...>{
+                                        {_columns}, std::tuple{assignments...}});
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+
+    std::tuple<Columns...> _columns;
+  };
+
+  template <typename Target, typename Statement>
+  class clause_base<on_conflict_do_nothing_t<Target>, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    clause_base(const clause_base<on_conflict_do_nothing_t<Target>, OtherStatement>& s) : _target(s._target)
+    {
+    }
+
+    clause_base(const on_conflict_do_nothing_t<Target>& f) : _target(f._target)
+    {
+    }
+
+    Target _target;
+  };
+
+  template <typename Target, typename... Assignments, typename Statement>
+  class clause_base<on_conflict_do_update_t<Target, Assignments...>, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    clause_base(const clause_base<on_conflict_do_update_t<Target, Assignments...>, OtherStatement>& s)
+        : _target(s._target), _assignments(s._assignments)
+    {
+    }
+
+    clause_base(const on_conflict_do_update_t<Target, Assignments...>& f)
+        : _target(f._target), _assignments(f._assignments)
+    {
+    }
+
+    Target _target;
+    std::tuple<Assignments...> _assignments;
+  };
+
+  template <typename... Assignments, typename Statement>
+  class clause_base<on_duplicate_key_update_t<Assignments...>, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    clause_base(const clause_base<on_duplicate_key_update_t<Assignments...>, OtherStatement>& s)
+        : _assignments(s._assignments)
+    {
+    }
+
+    clause_base(const on_duplicate_key_update_t<Assignments...>& f) : _assignments(f._assignments)
+    {
+    }
+
+    std::tuple<Assignments...> _assignments;
+  };
+
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_has_action, "on_conflict() requires do_nothing() or do_update()");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_target_is_primary_key,
+                              "on_conflict() columns must match the primary key of the table inserted into");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_update_columns_are_of_insert_table,
+                              "upsert assignments must only change columns of the table inserted into");
+
+  template <typename Table, typename... Columns>
+  constexpr auto check_on_conflict_target(const type_t<on_conflict_t<Columns...>>&)
+  {
+    using _table_spec_t = table_spec_of_t<Table>;
+    if constexpr (sizeof...(Columns) == 0)
+    {
+      return succeeded{};
+    }
+    else if constexpr (not((sizeof...(Columns) == 1) and ... and
+                           (std::is_same_v<table_spec_of_t<Columns>, _table_spec_t> and
+                            std::is_same_v<column_spec_of_t<Columns>, typename _table_spec_t::primary_key>)))
+    {
+      return failed<assert_on_conflict_target_is_primary_key>{};
+    }
+    else
+      return succeeded{};
+  }
+
+  template <typename Table, typename... Assignments>
+  constexpr auto check_on_conflict_update_columns()
+  {
+    using _table_spec_t = table_spec_of_t<Table>;
+    if constexpr (not(true and ... and
+                      std::is_same_v<table_spec_of_t<column_of_t<remove_optional_t<Assignments>>>, _table_spec_t>))
+    {
+      return failed<assert_on_conflict_update_columns_are_of_insert_table>{};
+    }
+    else
+      return succeeded{};
+  }
+
+  template <typename Db, typename... Columns, typename Statement>
+  constexpr auto check_clause_preparable(const type_t<clause_base<on_conflict_t<Columns...>, Statement>>&)
+  {
+    return failed<assert_on_conflict_has_action>{};
+  }
+
+  template <typename Db, typename Target, typename Statement>
+  constexpr auto check_clause_preparable(const type_t<clause_base<on_conflict_do_nothing_t<Target>, Statement>>&)
+  {
+    return check_on_conflict_target<typename Statement::insert_into_table_t>(type_v<Target>);
+  }
+
+  template <typename Db, typename Target, typename... Assignments, typename Statement>
+  constexpr auto check_clause_preparable(
+      const type_t<clause_base<on_conflict_do_update_t<Target, Assignments...>, Statement>>&)
+  {
+    using _table_t = typename Statement::insert_into_table_t;
+    return check_on_conflict_target<_table_t>(type_v<Target>) and
+           check_on_conflict_update_columns<_table_t, Assignments...>();
+  }
+
+  template <typename Db, typename... Assignments, typename Statement>
+  constexpr auto check_clause_preparable(
+      const type_t<clause_base<on_duplicate_key_update_t<Assignments...>, Statement>>&)
+  {
+    return check_on_conflict_update_columns<typename Statement::insert_into_table_t, Assignments...>();
+  }
+
+  template <typename Context, typename... Columns>
+  [[nodiscard]] auto to_sql_string(Context& context, const on_conflict_t<Columns...>& t)
+  {
+    if constexpr (sizeof...(Columns) == 0)
+    {
+      return std::string{" ON CONFLICT"};
+    }
+    else
+    {
+      return " ON CONFLICT (" + tuple_to_sql_string(context, ", ", std::tuple(free_column_t<Columns>{}...)) + ")";
+    }
+  }
+
+  template <typename Context, typename... Columns, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context, const clause_base<on_conflict_t<Columns...>, Statement>& t)
+  {
+    return to_sql_string(context, on_conflict_t<Columns...>{t._columns});
+  }
+
+  template <typename Context, typename Target, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context, const clause_base<on_conflict_do_nothing_t<Target>, Statement>& t)
+  {
+    return to_sql_string(context, t._target) + " DO NOTHING";
+  }
+
+  template <typename Context, typename Target, typename... Assignments, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context,
+                                   const clause_base<on_conflict_do_update_t<Target, Assignments...>, Statement>& t)
+  {
+    auto ret = to_sql_string(context, t._target);
+    ret += " DO UPDATE SET ";
+    return ret + tuple_to_sql_string(context, ", ",
+                                     std::tuple(update_assignment_t<Assignments>{
+                                         std::get<Assignments>(t._assignments)}...));
+  }
+
+  template <typename Context, typename... Assignments, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context,
+                                   const clause_base<on_duplicate_key_update_t<Assignments...>, Statement>& t)
+  {
+    return " ON DUPLICATE KEY UPDATE " +
+           tuple_to_sql_string(context, ", ",
+                               std::tuple(update_assignment_t<Assignments>{std::get<Assignments>(t._assignments)}...));
+  }
+
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_args_are_columns, "on_conflict() args must be columns");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_on_conflict_args_contain_no_duplicates,
+                              "at least one duplicate column detected in on_conflict()");
+
+  template <typename... Columns>
+  constexpr auto check_on_conflict_args()
+  {
+    if constexpr (!(true && ... && is_column_v<Columns>))
+    {
+      return failed<assert_on_conflict_args_are_columns>{};
+    }
+    else if constexpr (!names_are_unique<Columns...>())
+    {
+      return failed<assert_on_conflict_args_contain_no_duplicates>{};
+    }
+    else
+      return succeeded{};
+  }
+
+  struct no_on_conflict_t
+  {
+  };
+
+  template <typename Statement>
+  class clause_base<no_on_conflict_t, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    constexpr clause_base(const clause_base<no_on_conflict_t, OtherStatement>& s)
+    {
+    }
+
+    constexpr clause_base() = default;
+
+    // postgresql and sqlite3
+    template <typename... Columns>
+    [[nodiscard]] constexpr auto on_conflict(Columns... columns) const
+    {
+      if constexpr (constexpr auto _check = check_on_conflict_args<Columns...>(); _check)
+      {
+        return new_statement(*this, on_conflict_t<Columns...>{std::tuple{columns...}});
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+
+    // mysql
+    template <typename... Assignments>
+    [[nodiscard]] constexpr auto on_duplicate_key_update(Assignments... assignments) const
+    {
+      if constexpr (constexpr auto _check = check_on_conflict_update_args<Assignments...>(); _check)
+      {
+        return new_statement(*this, on_duplicate_key_update_t<Assignments...>{std::tuple{assignments...}});
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+  };
+
+  template <typename Context, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context, const clause_base<no_on_conflict_t, Statement>&)
+  {
+    return std::string{};
+  }
+
+  template <typename... Columns>
+  [[nodiscard]] constexpr auto on_conflict(Columns&&... columns)
+  {
+    return statement<no_on_conflict_t>{}.on_conflict(std::forward<Columns>(columns)...);
+  }
+
+  template <typename... Assignments>
+  [[nodiscard]] constexpr auto on_duplicate_key_update(Assignments&&... assignments)
+  {
+    return statement<no_on_conflict_t>{}.on_duplicate_key_update(std::forward<Assignments>(assignments)...);
+  }
+}  // namespace sqlpp
@@ -57,8 +57,8 @@ namespace sqlpp
     using type = type_vector<Columns...>;
   };
 
-  template <typename Table>
-  constexpr auto clause_tag<order_by_t<Table>> = clause::order_by{};
+  template <typename... Columns>
+  constexpr auto clause_tag<order_by_t<Columns...>> = clause::order_by{};
 
   template <typename... Columns, typename Statement>
   class clause_base<order_by_t<Columns...>, Statement>
@@ -0,0 +1,186 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <tuple>
+#include <utility>
+
+#include <sqlpp17/clause/select_columns.h>
+#include <sqlpp17/clause_fwd.h>
+#include <sqlpp17/column_spec.h>
+#include <sqlpp17/result_row.h>
+#include <sqlpp17/statement.h>
+#include <sqlpp17/tuple_to_sql_string.h>
+#include <sqlpp17/type_traits.h>
+#include <sqlpp17/wrapped_static_assert.h>
+
+namespace sqlpp
+{
+  namespace clause
+  {
+    struct returning
+    {
+    };
+  }  // namespace clause
+
+  template <typename... Columns>
+  struct returning_t
+  {
+    std::tuple<Columns...> _columns;
+  };
+
+  template <typename... Columns>
+  struct nodes_of<returning_t<Columns...>>
+  {
+    using type = type_vector<Columns...>;
+  };
+
+  template <typename... Columns>
+  constexpr auto clause_tag<returning_t<Columns...>> = clause::returning{};
+
+  template <typename... Columns, typename Statement>
+  class clause_base<returning_t<Columns...>, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    clause_base(const clause_base<returning_t<Columns...>, OtherStatement>& s) : _columns(s._columns)
+    {
+    }
+
+    clause_base(const returning_t<Columns...>& f) : _columns(f._columns)
+    {
+    }
+
+    std::tuple<select_column_t<Columns>...> _columns;
+  };
+
+  // Inserts, updates and deletes with RETURNING yield rows like selects do
+  template <typename... Columns>
+  constexpr auto is_result_clause_v<returning_t<Columns...>> = true;
+
+  template <typename... Columns>
+  struct clause_result_type<returning_t<Columns...>>
+  {
+    using type = select_result;
+  };
+
+  template <typename... Columns, typename Statement>
+  struct result_row_of<clause_base<returning_t<Columns...>, Statement>>
+  {
+    using type = result_row_t<make_column_spec_t<Statement, Columns>...>;
+  };
+
+  template <typename Context, typename... Columns, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context, const clause_base<returning_t<Columns...>, Statement>& t)
+  {
+    return " RETURNING " + tuple_to_sql_string(context, ", ", t._columns);
+  }
+
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_returning_args_not_empty, "returning() must be called with at least one argument");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_returning_args_are_selectable,
+                              "returning() args must be selectable (i.e. named expressions)");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_returning_args_have_unique_names, "returning() args must have unique names");
+  SQLPP_WRAPPED_STATIC_ASSERT(assert_returning_args_contain_no_aggregate,
+                              "returning() args must not contain aggregate expressions (e.g. max or count)");
+
+  template <typename... T>
+  constexpr auto check_returning_arg()
+  {
+    if constexpr (sizeof...(T) == 0)
+    {
+      return failed<assert_returning_args_not_empty>{};
+    }
+    else if constexpr (!(true && ... && is_selectable_v<T>))
+    {
+      return failed<assert_returning_args_are_selectable>{};
+    }
+    else if constexpr (!names_are_unique<T...>())
+    {
+      return failed<assert_returning_args_have_unique_names>{};
+    }
+    else if constexpr ((false || ... || recursive_contains_aggregate<type_set_t<>, T>()))
+    {
+      return failed<assert_returning_args_contain_no_aggregate>{};
+    }
+    else
+      return succeeded{};
+  }
+
+  struct no_returning_t
+  {
+  };
+
+  template <typename Statement>
+  class clause_base<no_returning_t, Statement>
+  {
+  public:
+    template <typename OtherStatement>
+    constexpr clause_base(const clause_base<no_returning_t, OtherStatement>& s)
+    {
+    }
+
+    constexpr clause_base() = default;
+
+    template <typename... Columns>
+    [[nodiscard]] constexpr auto returning(Columns... columns) const
+    {
+      if constexpr (constexpr auto _check = check_returning_arg<remove_optional_t<Columns>...>(); _check)
+      {
+        return new_statement(*this, returning_t<Columns...>{std::tuple(columns...)});
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+
+    template <typename... Columns>
+    [[nodiscard]] constexpr auto returning(std::tuple<Columns...> columns) const
+    {
+      if constexpr (constexpr auto _check = check_returning_arg<remove_optional_t<Columns>...>(); _check)
+      {
+        return new_statement(*this, returning_t<Columns...>{columns});
+      }
+      else
+      {
+        return ::sqlpp::bad_expression_t{_check};
+      }
+    }
+  };
+
+  template <typename Context, typename Statement>
+  [[nodiscard]] auto to_sql_string(Context& context, const clause_base<no_returning_t, Statement>& t)
+  {
+    return std::string{};
+  }
+
+  template <typename... Columns>
+  [[nodiscard]] constexpr auto returning(Columns&&... columns)
+  {
+    return statement<no_returning_t>{}.returning(std::forward<Columns>(columns)...);
+  }
+}  // namespace sqlpp
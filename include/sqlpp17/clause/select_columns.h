@@ -163,7 +163,7 @@ namespace sqlpp
     {
       return failed<assert_select_columns_args_are_selectable>{};
     }
-    else if constexpr (type_set<char_sequence_of_t<T>...>().size() != sizeof...(T))
+    else if constexpr (!names_are_unique<T...>())
     {
       return failed<assert_select_columns_args_have_unique_names>{};
     }
@@ -55,8 +55,8 @@ namespace sqlpp
     using type = type_vector<Flags...>;
   };
 
-  template <typename Table>
-  constexpr auto clause_tag<select_flags_t<Table>> = clause::select_flags{};
+  template <typename... Flags>
+  constexpr auto clause_tag<select_flags_t<Flags...>> = clause::select_flags{};
 
   template <typename... Flags, typename Statement>
   class clause_base<select_flags_t<Flags...>, Statement>
@@ -77,7 +77,9 @@ namespace sqlpp
   template <typename Context, typename... Flags, typename Statement>
   [[nodiscard]] auto to_sql_string(Context& context, const clause_base<select_flags_t<Flags...>, Statement>& t)
   {
-    return (std::string{} + ... + to_sql_string(context, std::get<Flags>(t._flags)));
+    auto ret = std::string{};
+    ((ret += to_sql_string(context, std::get<Flags>(t._flags))), ...);
+    return ret;
   }
 
   SQLPP_WRAPPED_STATIC_ASSERT(assert_select_flags_args_are_valid, "select flags() args must be valid select_flags");
@@ -26,6 +26,7 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <sqlpp17/clause/returning.h>
 #include <sqlpp17/clause/update_set.h>
 #include <sqlpp17/clause/where.h>
 #include <sqlpp17/clause_fwd.h>
@@ -111,7 +112,7 @@ namespace sqlpp
   {
     if constexpr (constexpr auto _check = check_update_arg<Table>(); _check)
     {
-      return statement<update_t<Table>>{table} << statement<no_update_set_t, no_where_t>{};
+      return statement<update_t<Table>>{table} << statement<no_update_set_t, no_where_t, no_returning_t>{};
     }
     else
     {
@@ -108,10 +108,9 @@ namespace sqlpp
                                    const clause_base<with_t<Mode, CommonTableExpressions...>, Statement>& t)
   {
     int index = -1;
-    return std::string{"WITH "} + to_sql_string(context, Mode) +
-           (std::string() + ... +
-            ((++index ? ", " : "") + to_full_sql_string(context, std::get<CommonTableExpressions>(t._ctes)))) +
-           " ";
+    auto ret = std::string{"WITH "} + to_sql_string(context, Mode);
+    ((ret += (++index ? ", " : "") + to_full_sql_string(context, std::get<CommonTableExpressions>(t._ctes))), ...);
+    return ret + " ";
   }
 
   SQLPP_WRAPPED_STATIC_ASSERT(assert_with_args_are_ctes, "with() args must be CTEs");
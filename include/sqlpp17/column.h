@@ -56,13 +56,13 @@ namespace sqlpp
     template <typename... Exprs>
     [[nodiscard]] constexpr auto in(Exprs... exprs) const
     {
-      return ::sqlpp::in(*this, exprs...);
+      return ::sqlpp::in(*this, std::move(exprs)...);
     }
 
     template <typename... Exprs>
     [[nodiscard]] constexpr auto not_in(Exprs... exprs) const
     {
-      return ::sqlpp::not_in(*this, exprs...);
+      return ::sqlpp::not_in(*this, std::move(exprs)...);
     }
 
     [[nodiscard]] constexpr auto is_null() const
@@ -116,6 +116,9 @@ namespace sqlpp
     static constexpr auto value = ColumnSpec::can_be_null;
   };
 
+  template <typename TableSpec, typename ColumnSpec>
+  constexpr auto is_column_v<column_t<TableSpec, ColumnSpec>> = true;
+
   template <typename TableSpec, typename ColumnSpec>
   constexpr auto is_read_only_v<column_t<TableSpec, ColumnSpec>> =
       is_read_only_v<std::decay_t<decltype(ColumnSpec::default_value)>>;
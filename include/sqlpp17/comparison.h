@@ -74,6 +74,9 @@ namespace sqlpp
   template <typename Context, typename L, typename Operator, typename R>
   [[nodiscard]] auto to_sql_string(Context& context, const comparison_t<L, Operator, R>& t)
   {
-    return to_sql_string(context, embrace(t.l)) + Operator::symbol + to_sql_string(context, embrace(t.r));
+    // Operands are serialized left to right, numbered parameters (e.g. ?1, $1) depend on it
+    auto ret = to_sql_string(context, embrace(t.l));
+    ret += Operator::symbol;
+    return ret + to_sql_string(context, embrace(t.r));
   }
 }  // namespace sqlpp
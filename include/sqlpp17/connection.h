@@ -29,6 +29,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string_view>
 #include <functional>
 
+#include <sqlpp17/instrumentation.h>
+
 namespace sqlpp
 {
   struct connection
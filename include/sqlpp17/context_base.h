@@ -26,10 +26,54 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
 namespace sqlpp
 {
+  // A literal value of a statement that is sent as a parameter instead of SQL text, see literal_parameters.h
+  using literal_value = std::variant<bool, std::int64_t, double, std::string>;
+
   struct context_base
   {
+    // If set, literal values are collected here and serialized as markers, see parameterize()
+    std::vector<literal_value>* literals = nullptr;
   };
 
+  namespace detail
+  {
+    // Literals are serialized as their index, enclosed in markers
+    constexpr auto literal_marker = '\0';
+
+    template <typename Context>
+    auto collects_literals(const Context& context) -> bool
+    {
+      if constexpr (std::is_base_of_v<context_base, Context>)
+      {
+        return context.literals != nullptr;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    // Only to be called if collects_literals(context)
+    template <typename Context>
+    auto add_literal(Context& context, literal_value value) -> std::string
+    {
+      if constexpr (std::is_base_of_v<context_base, Context>)
+      {
+        context.literals->push_back(std::move(value));
+        return literal_marker + std::to_string(context.literals->size() - 1) + literal_marker;
+      }
+      else
+      {
+        return {};
+      }
+    }
+  }  // namespace detail
 }  // namespace sqlpp
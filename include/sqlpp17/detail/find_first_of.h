@@ -0,0 +1,97 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <string_view>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sqlpp::detail
+{
+  // Returns a pointer to the first character in [begin, end) that equals one of Chars, or end if there is none.
+  // Long runs of uninteresting characters are skipped in blocks of 32 (AVX2) or 16 (SSE2) bytes.
+  template <char... Chars>
+  [[nodiscard]] inline auto find_first_of(const char* begin, const char* const end) -> const char*
+  {
+#if defined(__AVX2__)
+    for (; end - begin >= 32; begin += 32)
+    {
+      const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+      auto matches = _mm256_setzero_si256();
+      (..., (matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(Chars)))));
+      if (const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(matches)); mask)
+      {
+        return begin + __builtin_ctz(mask);
+      }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; end - begin >= 16; begin += 16)
+    {
+      const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+      auto matches = _mm_setzero_si128();
+      (..., (matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(Chars)))));
+      if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches)); mask)
+      {
+        return begin + __builtin_ctz(mask);
+      }
+    }
+#endif
+    for (; begin != end; ++begin)
+    {
+      if ((... or (*begin == Chars)))
+      {
+        return begin;
+      }
+    }
+    return end;
+  }
+
+  // Appends s to target, replacing each of Chars by whatever escape appends instead.
+  // Clean spans between two such characters are copied in one go.
+  template <char... Chars, typename Escape>
+  auto append_escaped(std::string& target, const std::string_view& s, const Escape& escape) -> void
+  {
+    const auto end = s.data() + s.size();
+    for (auto begin = s.data(); begin != end;)
+    {
+      const auto hit = find_first_of<Chars...>(begin, end);
+      target.append(begin, hit);
+      if (hit == end)
+      {
+        break;
+      }
+      escape(target, *hit);
+      begin = hit + 1;
+    }
+  }
+}  // namespace sqlpp::detail
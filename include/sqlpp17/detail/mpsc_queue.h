@@ -0,0 +1,91 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace sqlpp::detail
+{
+  // Unbounded lock-free queue for many producers and a single consumer (intrusive node design by Dmitry Vyukov).
+  // push() can be called from any thread, try_pop() only from the consumer thread.
+  // try_pop() may miss an element while its push() is still in progress, but never loses one.
+  template <typename T>
+  class mpsc_queue
+  {
+    struct node
+    {
+      std::atomic<node*> _next = nullptr;
+      std::optional<T> _value;
+    };
+
+    std::atomic<node*> _head;  // most recently pushed, shared by producers
+    node* _tail;               // stub whose successor is the next to pop, consumer only
+
+  public:
+    mpsc_queue() : _head{new node{}}, _tail{_head.load()}
+    {
+    }
+    mpsc_queue(const mpsc_queue&) = delete;
+    mpsc_queue(mpsc_queue&&) = delete;
+    mpsc_queue& operator=(const mpsc_queue&) = delete;
+    mpsc_queue& operator=(mpsc_queue&&) = delete;
+    ~mpsc_queue()
+    {
+      while (_tail)
+      {
+        auto* const next = _tail->_next.load(std::memory_order_relaxed);
+        delete _tail;
+        _tail = next;
+      }
+    }
+
+    auto push(T value) -> void
+    {
+      auto* const added = new node{};
+      added->_value.emplace(std::move(value));
+      auto* const previous = _head.exchange(added, std::memory_order_acq_rel);
+      previous->_next.store(added, std::memory_order_release);
+    }
+
+    auto try_pop() -> std::optional<T>
+    {
+      auto* const next = _tail->_next.load(std::memory_order_acquire);
+      if (not next)
+      {
+        return std::nullopt;
+      }
+      // next becomes the new stub
+      auto value = std::move(next->_value);
+      next->_value.reset();
+      delete _tail;
+      _tail = next;
+      return value;
+    }
+  };
+}  // namespace sqlpp::detail
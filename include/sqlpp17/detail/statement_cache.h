@@ -0,0 +1,134 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace sqlpp::detail
+{
+  // Prepared statements of a connection by SQL text, see literal_parameters.h.
+  //
+  // Statements taken from the cache are owned by whoever took them (e.g. a result) until they are handed back
+  // via release(). If the cache is gone by then, release() cannot be called and the owner finalizes them.
+  // Traits::reset(Handle*) prepares statements for reuse, Traits::finalize(Handle*) destroys them.
+  template <typename Handle, typename Traits>
+  class statement_cache
+  {
+    struct entry
+    {
+      std::string sql;
+      Handle* handle;
+      bool in_use;
+    };
+
+    std::size_t _capacity;
+    std::vector<entry> _entries;  // oldest first
+
+  public:
+    statement_cache(std::size_t capacity) : _capacity(capacity)
+    {
+    }
+
+    statement_cache(const statement_cache&) = delete;
+    statement_cache(statement_cache&&) = delete;
+    statement_cache& operator=(const statement_cache&) = delete;
+    statement_cache& operator=(statement_cache&&) = delete;
+
+    ~statement_cache()
+    {
+      for (const auto& entry : _entries)
+      {
+        if (not entry.in_use)
+        {
+          Traits::finalize(entry.handle);
+        }
+      }
+    }
+
+    // Returns nullptr if there is no idle statement for the SQL text
+    [[nodiscard]] auto take(const std::string& sql) -> Handle*
+    {
+      for (auto& entry : _entries)
+      {
+        if (not entry.in_use and entry.sql == sql)
+        {
+          entry.in_use = true;
+          return entry.handle;
+        }
+      }
+      return nullptr;
+    }
+
+    // Adds a statement that was just prepared (and is in use), evicting the oldest idle one if the cache is full.
+    // Returns false if there is no room.
+    auto adopt(const std::string& sql, Handle* handle) -> bool
+    {
+      if (_capacity == 0)
+      {
+        return false;
+      }
+      if (_entries.size() == _capacity)
+      {
+        auto idle = std::size_t{0};
+        while (idle < _entries.size() and _entries[idle].in_use)
+        {
+          ++idle;
+        }
+        if (idle == _entries.size())
+        {
+          return false;
+        }
+        Traits::finalize(_entries[idle].handle);
+        _entries.erase(_entries.begin() + static_cast<std::ptrdiff_t>(idle));
+      }
+      _entries.push_back(entry{sql, handle, true});
+      return true;
+    }
+
+    // Returns false if the statement is not part of the cache
+    auto release(Handle* handle) -> bool
+    {
+      for (auto& entry : _entries)
+      {
+        if (entry.handle == handle)
+        {
+          Traits::reset(handle);
+          entry.in_use = false;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+      return _entries.size();
+    }
+  };
+}  // namespace sqlpp::detail
@@ -30,8 +30,62 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace sqlpp
 {
+  // Connector independent classification of database errors
+  enum class error_code
+  {
+    unspecified,
+    busy,                   // e.g. SQLITE_BUSY or SQLITE_LOCKED
+    deadlock,               // e.g. MySQL error 1213 or SQLSTATE 40P01
+    serialization_failure,  // e.g. SQLSTATE 40001
+    lock_timeout,           // e.g. MySQL error 1205 or SQLSTATE 55P03
+  };
+
+  // Transient errors are likely to disappear when the transaction is run again, see retry.h
+  constexpr auto is_transient(error_code code) -> bool
+  {
+    switch (code)
+    {
+      case error_code::busy:
+      case error_code::deadlock:
+      case error_code::serialization_failure:
+      case error_code::lock_timeout:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   class exception : public std::runtime_error
   {
+    error_code _code = error_code::unspecified;
+
+  public:
     using runtime_error::runtime_error;
+
+    exception(const std::string& message, error_code code) : runtime_error(message), _code(code)
+    {
+    }
+
+    [[nodiscard]] auto code() const -> error_code
+    {
+      return _code;
+    }
+
+    [[nodiscard]] auto is_transient() const -> bool
+    {
+      return ::sqlpp::is_transient(_code);
+    }
+  };
+
+  // Thrown when a statement was interrupted via a cancellation_token, see cancellation.h
+  class cancelled_exception : public exception
+  {
+    using exception::exception;
+  };
+
+  // Thrown when a statement was interrupted because its deadline or timeout expired
+  class timeout_exception : public cancelled_exception
+  {
+    using cancelled_exception::cancelled_exception;
   };
 }
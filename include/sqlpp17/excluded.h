@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sqlpp17/free_column.h>
+#include <sqlpp17/type_traits.h>
+
+namespace sqlpp
+{
+  // The value that an upsert tried to insert into Column, e.g. excluded.name
+  template <typename Column>
+  struct excluded_t
+  {
+  };
+
+  template <typename Column>
+  struct nodes_of<excluded_t<Column>>
+  {
+    using type = type_vector<Column>;
+  };
+
+  template <typename Column>
+  constexpr auto excluded(Column) -> std::enable_if_t<is_column_v<Column>, excluded_t<Column>>
+  {
+    return excluded_t<Column>{};
+  }
+
+  template <typename Column>
+  struct value_type_of<excluded_t<Column>>
+  {
+    using type = value_type_of_t<Column>;
+  };
+
+  template <typename Column>
+  struct can_be_null<excluded_t<Column>>
+  {
+    static constexpr auto value = can_be_null_v<Column>;
+  };
+
+  template <typename Context, typename Column>
+  [[nodiscard]] auto to_sql_string(Context& context, const excluded_t<Column>&)
+  {
+    return "excluded." + to_sql_string(context, free_column_t<Column>{});
+  }
+}  // namespace sqlpp
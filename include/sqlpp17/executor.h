@@ -0,0 +1,529 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <sqlpp17/cancellation.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/materialize.h>
+#include <sqlpp17/statement.h>
+
+namespace sqlpp
+{
+  struct executor_config_t
+  {
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t queue_capacity = 1024;  // tasks submitted, but not yet started; submit() blocks beyond that
+  };
+
+  class executor_t;
+
+  template <typename Pool>
+  class pool_executor_t;
+}  // namespace sqlpp
+
+namespace sqlpp::detail
+{
+  class executor_gate;
+
+  class executor_task
+  {
+  public:
+    virtual ~executor_task() = default;
+
+    // Must not throw, errors are handed to whoever waits for the task
+    virtual auto run() noexcept -> void = 0;
+
+    std::shared_ptr<executor_gate> _gate;
+  };
+
+  // Limits the number of tasks of a pool that run at the same time. Tasks beyond the limit wait here instead
+  // of occupying executor threads.
+  class executor_gate
+  {
+    std::mutex _mutex;
+    std::size_t _limit;
+    std::size_t _active = 0;
+    std::deque<std::unique_ptr<executor_task>> _waiting;
+
+  public:
+    executor_gate(std::size_t limit) : _limit(limit)
+    {
+    }
+
+    // Returns the task if it may run now
+    auto admit(std::unique_ptr<executor_task> task) -> std::unique_ptr<executor_task>
+    {
+      const auto lock = std::lock_guard{_mutex};
+      if (_active < _limit)
+      {
+        ++_active;
+        return task;
+      }
+      _waiting.push_back(std::move(task));
+      return nullptr;
+    }
+
+    // Called when a task finished, returns the next task to run in its place, if any
+    auto release() -> std::unique_ptr<executor_task>
+    {
+      const auto lock = std::lock_guard{_mutex};
+      if (_waiting.empty())
+      {
+        --_active;
+        return nullptr;
+      }
+      auto task = std::move(_waiting.front());
+      _waiting.pop_front();
+      return task;
+    }
+  };
+
+  // Gets a connection from the pool, runs work(connection) and hands out the result via the promise
+  template <typename Pool, typename Work>
+  class executor_call final : public executor_task
+  {
+  public:
+    using connection_type = decltype(std::declval<Pool&>().get());
+    using value_type = std::invoke_result_t<Work&, connection_type&>;
+
+  private:
+    Pool& _pool;
+    Work _work;
+    std::optional<deadline_clock::time_point> _deadline;
+    std::promise<value_type> _promise;
+
+    auto call() -> value_type
+    {
+      if (_deadline and not std::less<>{}(deadline_clock::now(), *_deadline))
+      {
+        throw ::sqlpp::timeout_exception("Executor: task not started: deadline exceeded");
+      }
+      auto connection = _pool.get();
+      if (_deadline)
+      {
+        connection.set_deadline(*_deadline);
+      }
+      return _work(connection);
+    }
+
+  public:
+    executor_call(Pool& pool, Work work, std::optional<deadline_clock::time_point> deadline)
+        : _pool(pool), _work(std::move(work)), _deadline(deadline)
+    {
+    }
+
+    auto get_future()
+    {
+      return _promise.get_future();
+    }
+
+    auto run() noexcept -> void override
+    {
+      try
+      {
+        if constexpr (std::is_void_v<value_type>)
+        {
+          call();
+          _promise.set_value();
+        }
+        else
+        {
+          _promise.set_value(call());
+        }
+      }
+      catch (...)
+      {
+        _promise.set_exception(std::current_exception());
+      }
+    }
+  };
+
+  template <typename T>
+  using future_value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+  template <typename T>
+  auto get_future_value(std::future<T>& future) -> future_value_t<T>
+  {
+    if constexpr (std::is_void_v<T>)
+    {
+      future.get();
+      return {};
+    }
+    else
+    {
+      return future.get();
+    }
+  }
+}  // namespace sqlpp::detail
+
+namespace sqlpp
+{
+  // A work stealing thread pool for running statements of connection pools concurrently, see pool_executor_t.
+  //
+  // Each thread has its own queue. Tasks submitted from other threads are distributed round robin, tasks
+  // submitted from within a task go to the queue of the current thread. Idle threads steal from the others.
+  //
+  // The number of tasks that were submitted, but not started yet, is bounded by queue_capacity: submit() blocks
+  // until there is room (except on the executor's own threads, which must not wait for themselves).
+  //
+  // The destructor runs all tasks submitted so far.
+  class executor_t
+  {
+    template <typename Pool>
+    friend class pool_executor_t;
+
+    using _task_ptr = std::unique_ptr<detail::executor_task>;
+
+    struct worker_queue
+    {
+      std::mutex _mutex;
+      std::deque<_task_ptr> _tasks;
+    };
+
+    executor_config_t _config;
+    std::vector<std::unique_ptr<worker_queue>> _queues;
+    std::atomic<std::size_t> _next_queue = 0;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _work;   // tasks got queued or the executor is done
+    std::condition_variable _space;  // tasks got started
+    std::size_t _queued = 0;         // tasks in _queues, not claimed by a thread yet
+    std::size_t _pending = 0;        // tasks not started yet, including those waiting at a gate
+    std::size_t _outstanding = 0;    // tasks not finished yet
+    bool _stop = false;
+
+    std::vector<std::thread> _threads;
+
+    // The executor and queue index of the current thread
+    static auto current() -> std::pair<const executor_t*, std::size_t>&
+    {
+      static thread_local auto current = std::pair<const executor_t*, std::size_t>{nullptr, 0};
+      return current;
+    }
+
+    auto is_own_thread() const -> bool
+    {
+      return current().first == this;
+    }
+
+    auto schedule(_task_ptr task) -> void
+    {
+      const auto index =
+          is_own_thread() ? current().second : _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+      {
+        auto& queue = *_queues[index];
+        const auto lock = std::lock_guard{queue._mutex};
+        queue._tasks.push_back(std::move(task));
+      }
+      {
+        const auto lock = std::lock_guard{_mutex};
+        ++_queued;
+      }
+      _work.notify_one();
+    }
+
+    // Newest task of the own queue first, oldest tasks of the other queues next
+    auto take(std::size_t index) -> _task_ptr
+    {
+      for (;;)
+      {
+        {
+          auto& queue = *_queues[index];
+          const auto lock = std::lock_guard{queue._mutex};
+          if (not queue._tasks.empty())
+          {
+            auto task = std::move(queue._tasks.back());
+            queue._tasks.pop_back();
+            return task;
+          }
+        }
+        for (std::size_t i = 1; i < _queues.size(); ++i)
+        {
+          auto& queue = *_queues[(index + i) % _queues.size()];
+          const auto lock = std::lock_guard{queue._mutex};
+          if (not queue._tasks.empty())
+          {
+            auto task = std::move(queue._tasks.front());
+            queue._tasks.pop_front();
+            return task;
+          }
+        }
+        // The task claimed by this thread is still being pushed
+        std::this_thread::yield();
+      }
+    }
+
+    auto run(std::size_t index) -> void
+    {
+      current() = {this, index};
+      for (;;)
+      {
+        {
+          auto lock = std::unique_lock{_mutex};
+          _work.wait(lock, [this] { return _queued > 0 or (_stop and _outstanding == 0); });
+          if (_queued == 0)
+          {
+            _work.notify_all();
+            return;
+          }
+          --_queued;
+          --_pending;
+        }
+        _space.notify_one();
+
+        auto task = take(index);
+        auto gate = std::move(task->_gate);
+        task->run();
+        task.reset();
+
+        if (gate)
+        {
+          if (auto next = gate->release())
+          {
+            next->_gate = std::move(gate);
+            schedule(std::move(next));
+          }
+        }
+
+        const auto lock = std::lock_guard{_mutex};
+        if (--_outstanding == 0 and _stop)
+        {
+          _work.notify_all();
+        }
+      }
+    }
+
+    auto submit(_task_ptr task, std::shared_ptr<detail::executor_gate> gate) -> void
+    {
+      {
+        auto lock = std::unique_lock{_mutex};
+        if (not is_own_thread())
+        {
+          _space.wait(lock, [this] { return _pending < _config.queue_capacity or _stop; });
+        }
+        if (_stop)
+        {
+          throw ::sqlpp::exception("Executor: shutting down");
+        }
+        ++_pending;
+        ++_outstanding;
+      }
+
+      task->_gate = gate;
+      if (auto admitted = gate->admit(std::move(task)))
+      {
+        schedule(std::move(admitted));
+      }
+    }
+
+  public:
+    executor_t(executor_config_t config = {}) : _config(config)
+    {
+      if (_config.threads == 0 or _config.queue_capacity == 0)
+      {
+        throw ::sqlpp::exception("Executor: threads and queue_capacity must be > 0");
+      }
+      for (std::size_t i = 0; i < _config.threads; ++i)
+      {
+        _queues.push_back(std::make_unique<worker_queue>());
+      }
+      for (std::size_t i = 0; i < _config.threads; ++i)
+      {
+        _threads.emplace_back([this, i] { run(i); });
+      }
+    }
+
+    executor_t(const executor_t&) = delete;
+    executor_t(executor_t&&) = delete;
+    executor_t& operator=(const executor_t&) = delete;
+    executor_t& operator=(executor_t&&) = delete;
+
+    ~executor_t()
+    {
+      {
+        const auto lock = std::lock_guard{_mutex};
+        _stop = true;
+      }
+      _work.notify_all();
+      _space.notify_all();
+      for (auto& thread : _threads)
+      {
+        thread.join();
+      }
+    }
+
+    // At most max_concurrency statements of the pool run at the same time (and use a connection of it).
+    // The pool has to outlive all tasks submitted via the returned pool_executor_t.
+    template <typename Pool>
+    [[nodiscard]] auto bind(Pool& pool, std::size_t max_concurrency) -> pool_executor_t<Pool>
+    {
+      if (max_concurrency == 0)
+      {
+        throw ::sqlpp::exception("Executor: max_concurrency must be > 0");
+      }
+      return pool_executor_t<Pool>{*this, pool, std::make_shared<detail::executor_gate>(max_concurrency)};
+    }
+
+    // Tasks submitted, but not started yet
+    [[nodiscard]] auto pending() const -> std::size_t
+    {
+      const auto lock = std::lock_guard{_mutex};
+      return _pending;
+    }
+  };
+
+  // Runs statements with connections of a pool on an executor_t. Copies share the concurrency limit.
+  //
+  //   auto db = executor.bind(pool, 4);
+  //   auto [users, orders] = sqlpp::when_all(db.submit(select(...)), db.submit(select(...))).get();
+  //
+  // Selects are materialized, see owned_row_t. Other statements hand out what the connection returns for them.
+  //
+  // Tasks with a deadline fail with a timeout_exception if they cannot be started before it. Otherwise, the
+  // deadline is set on the connection, see execution_limits.
+  template <typename Pool>
+  class pool_executor_t
+  {
+    friend class executor_t;
+
+    using _connection_t = decltype(std::declval<Pool&>().get());
+
+    executor_t* _executor;
+    Pool* _pool;
+    std::shared_ptr<detail::executor_gate> _gate;
+
+    pool_executor_t(executor_t& executor, Pool& pool, std::shared_ptr<detail::executor_gate> gate)
+        : _executor(&executor), _pool(&pool), _gate(std::move(gate))
+    {
+    }
+
+    template <typename... Clauses>
+    static auto statement_work(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      using Statement = ::sqlpp::statement<Clauses...>;
+      return [statement](_connection_t& connection) {
+        if constexpr (std::is_same_v<result_type_of_t<Statement>, select_result>)
+        {
+          return ::sqlpp::materialize(connection(statement));
+        }
+        else
+        {
+          return connection(statement);
+        }
+      };
+    }
+
+    template <typename Work>
+    auto submit_work(Work work, std::optional<deadline_clock::time_point> deadline)
+    {
+      auto task = std::make_unique<detail::executor_call<Pool, Work>>(*_pool, std::move(work), deadline);
+      auto future = task->get_future();
+      _executor->submit(std::move(task), _gate);
+      return future;
+    }
+
+  public:
+    // work is called with a connection of the pool, its result is handed out via the future.
+    // The result must not refer to the connection.
+    template <typename Work, typename = std::enable_if_t<std::is_invocable_v<Work&, _connection_t&>>>
+    [[nodiscard]] auto submit(Work work)
+    {
+      return submit_work(std::move(work), std::nullopt);
+    }
+
+    template <typename Work, typename = std::enable_if_t<std::is_invocable_v<Work&, _connection_t&>>>
+    [[nodiscard]] auto submit(Work work, deadline_clock::time_point deadline)
+    {
+      return submit_work(std::move(work), deadline);
+    }
+
+    template <typename... Clauses>
+    [[nodiscard]] auto submit(const ::sqlpp::statement<Clauses...>& statement)
+    {
+      return submit_work(statement_work(statement), std::nullopt);
+    }
+
+    template <typename... Clauses>
+    [[nodiscard]] auto submit(const ::sqlpp::statement<Clauses...>& statement, deadline_clock::time_point deadline)
+    {
+      return submit_work(statement_work(statement), deadline);
+    }
+  };
+
+  // Combines futures into one that hands out all of their values (std::monostate for std::future<void>).
+  // Waits for all of them before rethrowing the first exception in argument order.
+  // The returned future is deferred: it does not block before get() or wait() are called on it.
+  template <typename... Values>
+  [[nodiscard]] auto when_all(std::future<Values>... futures)
+      -> std::future<std::tuple<detail::future_value_t<Values>...>>
+  {
+    return std::async(
+        std::launch::deferred,
+        [](std::future<Values>... futures) {
+          (..., futures.wait());
+          return std::tuple<detail::future_value_t<Values>...>{detail::get_future_value(futures)...};
+        },
+        std::move(futures)...);
+  }
+
+  template <typename Value>
+  [[nodiscard]] auto when_all(std::vector<std::future<Value>> futures)
+      -> std::future<std::vector<detail::future_value_t<Value>>>
+  {
+    return std::async(std::launch::deferred, [futures = std::move(futures)]() mutable {
+      for (auto& future : futures)
+      {
+        future.wait();
+      }
+      auto values = std::vector<detail::future_value_t<Value>>{};
+      values.reserve(futures.size());
+      for (auto& future : futures)
+      {
+        values.push_back(detail::get_future_value(future));
+      }
+      return values;
+    });
+  }
+}  // namespace sqlpp
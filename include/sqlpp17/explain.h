@@ -0,0 +1,128 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sqlpp
+{
+  enum class explain_mode
+  {
+    plan,     // estimates only, the statement is not executed
+    analyze,  // executes the statement and adds actual rows and times (not supported by sqlite3)
+  };
+
+  struct plan_node
+  {
+    std::string operation;  // as reported by the database, e.g. "Index Scan" or "SCAN tab_person"
+    std::string relation;   // table, if any
+    std::string index;      // index used to access the table, if any
+    bool full_scan = false;  // the whole table is read
+    std::optional<double> estimated_cost;
+    std::optional<double> estimated_rows;
+    std::optional<double> actual_rows;     // explain_mode::analyze only
+    std::optional<double> actual_time_ms;  // explain_mode::analyze only
+    std::vector<plan_node> children;
+  };
+
+  struct query_plan
+  {
+    std::string sql;        // the explained statement
+    std::string raw;        // the plan as returned by the database
+    std::vector<plan_node> nodes;
+
+    // True if the predicate holds for any node of the plan
+    template <typename Predicate>
+    [[nodiscard]] auto any_node(const Predicate& predicate) const -> bool
+    {
+      return any_node(nodes, predicate);
+    }
+
+    [[nodiscard]] auto has_full_scan() const -> bool
+    {
+      return any_node([](const plan_node& node) { return node.full_scan; });
+    }
+
+    [[nodiscard]] auto uses_index(std::string_view index) const -> bool
+    {
+      return any_node([index](const plan_node& node) { return node.index.compare(index) == 0; });
+    }
+
+  private:
+    template <typename Predicate>
+    static auto any_node(const std::vector<plan_node>& nodes, const Predicate& predicate) -> bool
+    {
+      for (const auto& node : nodes)
+      {
+        if (predicate(node) or any_node(node.children, predicate))
+          return true;
+      }
+      return false;
+    }
+  };
+
+  // Asks the database how it would execute the statement, see explain_mode
+  template <typename Connection, typename Statement>
+  [[nodiscard]] auto explain(Connection& connection, const Statement& statement, explain_mode mode = explain_mode::plan)
+  {
+    return connection.explain(statement, mode);
+  }
+
+  namespace detail
+  {
+    inline auto write_plan_node(std::ostream& os, const plan_node& node, std::size_t depth) -> void
+    {
+      os << std::string(2 * depth, ' ') << node.operation;
+      if (node.estimated_cost)
+        os << " cost=" << *node.estimated_cost;
+      if (node.estimated_rows)
+        os << " rows=" << *node.estimated_rows;
+      if (node.actual_rows)
+        os << " actual_rows=" << *node.actual_rows;
+      if (node.actual_time_ms)
+        os << " actual_time=" << *node.actual_time_ms << "ms";
+      os << '\n';
+      for (const auto& child : node.children)
+      {
+        write_plan_node(os, child, depth + 1);
+      }
+    }
+  }  // namespace detail
+
+  // One line per node, children are indented
+  inline auto write_query_plan(std::ostream& os, const query_plan& plan) -> void
+  {
+    for (const auto& node : plan.nodes)
+    {
+      detail::write_plan_node(os, node, 0);
+    }
+  }
+}  // namespace sqlpp
@@ -0,0 +1,413 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <sqlpp17/instrumentation.h>
+
+namespace sqlpp
+{
+  // The flight recorder keeps the most recent statements of each thread in a fixed-size ring buffer.
+  // Recording is lock-free and does not allocate. The records can be read at any time,
+  // e.g. via flight_recorder_snapshot(), or via dump_flight_recorder() from a signal handler.
+  constexpr auto flight_recorder_capacity = std::size_t{64};
+
+  enum class flight_outcome : std::uint8_t
+  {
+    running,
+    succeeded,
+    failed
+  };
+
+  struct flight_record
+  {
+    static constexpr auto sql_capacity = std::size_t{128};
+
+    std::uint32_t statement_hash = 0;
+    flight_outcome outcome = flight_outcome::running;
+    bool sql_truncated = false;
+    std::uint8_t sql_size = 0;
+    const void* connection = nullptr;  // native handle, e.g. sqlite3*
+    instrumentation_clock::time_point start = {};
+    instrumentation_clock::duration serialization_time = {};
+    instrumentation_clock::duration prepare_time = {};
+    instrumentation_clock::duration execute_time = {};
+    instrumentation_clock::duration fetch_time = {};
+    std::optional<std::uint64_t> rows;
+    std::array<char, sql_capacity> sql = {};
+
+    [[nodiscard]] auto sql_text() const -> std::string_view
+    {
+      return std::string_view{sql.data(), sql_size};
+    }
+  };
+
+  namespace detail
+  {
+    // Each slot is guarded by a sequence lock: The owning thread increments the sequence before and after
+    // modifying the record, readers discard copies that were taken during a modification.
+    struct flight_slot
+    {
+      std::atomic<std::uint64_t> sequence = 0;
+      flight_record record;
+    };
+
+    struct flight_ring
+    {
+      std::array<flight_slot, flight_recorder_capacity> slots;
+      std::atomic<std::uint64_t> next = 0;
+      std::atomic<bool> in_use = true;
+      flight_ring* next_ring = nullptr;
+    };
+
+    // Rings are never freed, rings of finished threads are reused by new threads
+    inline std::atomic<flight_ring*> flight_rings = nullptr;
+
+    [[nodiscard]] inline auto acquire_flight_ring() -> flight_ring*
+    {
+      for (auto* ring = flight_rings.load(std::memory_order_acquire); ring; ring = ring->next_ring)
+      {
+        auto expected = false;
+        if (ring->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+          return ring;
+        }
+      }
+
+      auto* ring = new flight_ring{};
+      ring->next_ring = flight_rings.load(std::memory_order_relaxed);
+      while (not flight_rings.compare_exchange_weak(ring->next_ring, ring, std::memory_order_release,
+                                                     std::memory_order_relaxed))
+      {
+      }
+      return ring;
+    }
+
+    struct flight_ring_owner
+    {
+      flight_ring* ring = acquire_flight_ring();
+
+      ~flight_ring_owner()
+      {
+        ring->in_use.store(false, std::memory_order_release);
+      }
+    };
+
+    [[nodiscard]] inline auto this_thread_flight_ring() -> flight_ring&
+    {
+      thread_local auto owner = flight_ring_owner{};
+      return *owner.ring;
+    }
+
+    template <typename Update>
+    auto write_flight_slot(flight_slot& slot, const Update& update) -> void
+    {
+      const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+      slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      update(slot.record);
+      slot.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Returns false if the slot is unused or being modified
+    inline auto read_flight_slot(const flight_slot& slot, flight_record& record) -> bool
+    {
+      const auto before = slot.sequence.load(std::memory_order_acquire);
+      if (before == 0 or (before & 1))
+      {
+        return false;
+      }
+      std::memcpy(static_cast<void*>(&record), static_cast<const void*>(&slot.record), sizeof(flight_record));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return slot.sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    inline auto copy_flight_sql(flight_record& record, std::string_view sql) -> void
+    {
+      const auto size = std::min(sql.size(), flight_record::sql_capacity);
+      std::memcpy(record.sql.data(), sql.data(), size);
+      record.sql_size = static_cast<std::uint8_t>(size);
+      record.sql_truncated = size < sql.size();
+    }
+
+    // Formatting without allocations, see dump_flight_recorder
+    class flight_line
+    {
+      std::array<char, 512> _buffer;
+      std::size_t _size = 0;
+
+    public:
+      auto append(std::string_view text) -> flight_line&
+      {
+        const auto size = std::min(text.size(), _buffer.size() - _size);
+        std::memcpy(_buffer.data() + _size, text.data(), size);
+        _size += size;
+        return *this;
+      }
+
+      auto append(std::uint64_t value, unsigned base = 10) -> flight_line&
+      {
+        auto digits = std::array<char, 20>{};
+        auto count = std::size_t{0};
+        do
+        {
+          digits[count++] = "0123456789abcdef"[value % base];
+          value /= base;
+        } while (value);
+        while (count)
+        {
+          append(std::string_view{&digits[--count], 1});
+        }
+        return *this;
+      }
+
+      auto append(instrumentation_clock::duration duration) -> flight_line&
+      {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        return append(static_cast<std::uint64_t>(ns < 0 ? 0 : ns)).append("ns");
+      }
+
+      [[nodiscard]] auto view() const -> std::string_view
+      {
+        return std::string_view{_buffer.data(), _size};
+      }
+    };
+
+    // Format, one line per record:
+    //   start=123456789ns hash=0x1234abcd connection=0x55d0c2a8 outcome=succeeded rows=1 serialize=900ns
+    //   prepare=12000ns execute=3000ns fetch=0ns sql="INSERT INTO tab_department (name) VALUES('hansi')"
+    inline auto format_flight_record(flight_line& line, const flight_record& record) -> void
+    {
+      const auto outcome = record.outcome == flight_outcome::running
+                               ? "running"
+                               : record.outcome == flight_outcome::succeeded ? "succeeded" : "failed";
+      line.append("start=")
+          .append(record.start.time_since_epoch())
+          .append(" hash=0x")
+          .append(record.statement_hash, 16)
+          .append(" connection=0x")
+          .append(reinterpret_cast<std::uintptr_t>(record.connection), 16)
+          .append(" outcome=")
+          .append(outcome);
+      if (record.rows)
+      {
+        line.append(" rows=").append(*record.rows);
+      }
+      line.append(" serialize=")
+          .append(record.serialization_time)
+          .append(" prepare=")
+          .append(record.prepare_time)
+          .append(" execute=")
+          .append(record.execute_time)
+          .append(" fetch=")
+          .append(record.fetch_time)
+          .append(" sql=\"")
+          .append(record.sql_text())
+          .append(record.sql_truncated ? "...\"\n" : "\"\n");
+    }
+  }  // namespace detail
+
+  // Records of all threads, ordered by start time
+  [[nodiscard]] inline auto flight_recorder_snapshot() -> std::vector<flight_record>
+  {
+    auto records = std::vector<flight_record>{};
+    for (auto* ring = detail::flight_rings.load(std::memory_order_acquire); ring; ring = ring->next_ring)
+    {
+      for (const auto& slot : ring->slots)
+      {
+        auto record = flight_record{};
+        if (detail::read_flight_slot(slot, record))
+        {
+          records.push_back(record);
+        }
+      }
+    }
+    std::sort(records.begin(), records.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.start < rhs.start; });
+    return records;
+  }
+
+  inline auto write_flight_records(std::ostream& os, const std::vector<flight_record>& records) -> void
+  {
+    for (const auto& record : records)
+    {
+      auto line = detail::flight_line{};
+      detail::format_flight_record(line, record);
+      os << line.view();
+    }
+  }
+
+#if __has_include(<unistd.h>)
+  // Async-signal-safe: Writes the records of each thread from oldest to newest to the file descriptor
+  inline auto dump_flight_recorder(int fd) noexcept -> void
+  {
+    for (auto* ring = detail::flight_rings.load(std::memory_order_acquire); ring; ring = ring->next_ring)
+    {
+      const auto next = ring->next.load(std::memory_order_relaxed);
+      for (auto position = next; position < next + flight_recorder_capacity; ++position)
+      {
+        auto record = flight_record{};
+        if (detail::read_flight_slot(ring->slots[position % flight_recorder_capacity], record))
+        {
+          auto line = detail::flight_line{};
+          detail::format_flight_record(line, record);
+          const auto text = line.view();
+          [[maybe_unused]] const auto written = ::write(fd, text.data(), text.size());
+        }
+      }
+    }
+  }
+#endif
+
+  // Instrumentation policy (see instrumentation.h) that writes to the flight recorder.
+  // Each connection and prepared statement has its own copy, which tracks the record of its current statement.
+  class flight_recorder_instrumentation
+  {
+    const void* _connection = nullptr;
+    detail::flight_ring* _ring = nullptr;
+    std::uint64_t _position = 0;
+    instrumentation_clock::time_point _execute_start = {};
+    bool _prepared = false;  // prepared, but not executed yet
+
+    // Text of the prepared statement, used for records of its executions
+    std::array<char, flight_record::sql_capacity> _sql = {};
+    std::uint8_t _sql_size = 0;
+    bool _sql_truncated = false;
+
+    auto begin(std::uint32_t statement_hash,
+               std::string_view sql,
+               instrumentation_clock::duration serialization_time,
+               instrumentation_clock::time_point time) -> void
+    {
+      auto& ring = detail::this_thread_flight_ring();
+      _ring = &ring;
+      _position = ring.next.load(std::memory_order_relaxed);
+      ring.next.store(_position + 1, std::memory_order_relaxed);
+      detail::write_flight_slot(ring.slots[_position % flight_recorder_capacity], [&](flight_record& record) {
+        record.statement_hash = statement_hash;
+        record.outcome = flight_outcome::running;
+        record.connection = _connection;
+        record.start = time;
+        record.serialization_time = serialization_time;
+        record.prepare_time = {};
+        record.execute_time = {};
+        record.fetch_time = {};
+        record.rows.reset();
+        if (sql.empty())
+        {
+          std::memcpy(record.sql.data(), _sql.data(), _sql_size);
+          record.sql_size = _sql_size;
+          record.sql_truncated = _sql_truncated;
+        }
+        else
+        {
+          detail::copy_flight_sql(record, sql);
+        }
+      });
+    }
+
+    // Records are only updated by the thread that started them, as long as they have not been overwritten
+    template <typename Update>
+    auto update(const Update& update) -> void
+    {
+      if (_ring and _ring == &detail::this_thread_flight_ring() and
+          _ring->next.load(std::memory_order_relaxed) - _position <= flight_recorder_capacity)
+      {
+        detail::write_flight_slot(_ring->slots[_position % flight_recorder_capacity], update);
+      }
+    }
+
+  public:
+    auto attach_connection(const void* native_handle) -> void
+    {
+      _connection = native_handle;
+    }
+
+    auto operator()(const prepare_start_event& event) -> void
+    {
+      begin(event.statement_hash, event.sql, event.serialization_time, event.time);
+      const auto size = std::min(event.sql.size(), flight_record::sql_capacity);
+      std::memcpy(_sql.data(), event.sql.data(), size);
+      _sql_size = static_cast<std::uint8_t>(size);
+      _sql_truncated = size < event.sql.size();
+      _prepared = true;
+    }
+
+    auto operator()(const prepare_end_event& event) -> void
+    {
+      update([&](flight_record& record) { record.prepare_time = event.time - record.start; });
+    }
+
+    auto operator()(const execute_start_event& event) -> void
+    {
+      if (not _prepared or _ring != &detail::this_thread_flight_ring())
+      {
+        begin(event.statement_hash, event.sql, event.serialization_time, event.time);
+      }
+      _prepared = false;
+      _execute_start = event.time;
+    }
+
+    auto operator()(const execute_end_event& event) -> void
+    {
+      update([&](flight_record& record) {
+        record.execute_time = event.time - _execute_start;
+        record.outcome = flight_outcome::succeeded;
+        if (event.rows)
+          record.rows = *event.rows;
+      });
+    }
+
+    auto operator()(const fetch_end_event& event) -> void
+    {
+      update([&](flight_record& record) {
+        record.fetch_time = event.fetch_time;
+        record.rows = event.rows;
+      });
+    }
+
+    auto operator()(const error_event&) -> void
+    {
+      _prepared = false;
+      update([&](flight_record& record) { record.outcome = flight_outcome::failed; });
+    }
+  };
+}  // namespace sqlpp
@@ -0,0 +1,273 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace sqlpp
+{
+  using instrumentation_clock = std::chrono::steady_clock;
+
+  // Events reported to instrumentation policies.
+  // statement_hash is the type_hash of the statement, or the djb2_hash of the query text for string queries.
+  // String views are only valid during the call.
+
+  // serialization_time is the time spent serializing the statement into sql
+  struct prepare_start_event
+  {
+    std::uint32_t statement_hash;
+    std::string_view sql;
+    instrumentation_clock::duration serialization_time;
+    instrumentation_clock::time_point time;
+  };
+
+  struct prepare_end_event
+  {
+    std::uint32_t statement_hash;
+    instrumentation_clock::time_point time;
+  };
+
+  // sql is empty and serialization_time is zero for the execution of prepared statements
+  struct execute_start_event
+  {
+    std::uint32_t statement_hash;
+    std::string_view sql;
+    instrumentation_clock::duration serialization_time;
+    instrumentation_clock::time_point time;
+  };
+
+  // rows is empty if the number of rows is not known without fetching them
+  struct execute_end_event
+  {
+    std::uint32_t statement_hash;
+    std::optional<std::size_t> rows;
+    instrumentation_clock::time_point time;
+  };
+
+  // Reported once the rows of a select have been fetched completely, see instrumented_result_handle
+  struct fetch_end_event
+  {
+    std::uint32_t statement_hash;
+    std::size_t rows;
+    instrumentation_clock::duration fetch_time;
+    instrumentation_clock::time_point time;
+  };
+
+  struct error_event
+  {
+    std::uint32_t statement_hash;
+    std::string_view message;
+    instrumentation_clock::time_point time;
+  };
+
+  // Instrumentation policies are callables that accept all of the events above, e.g.
+  //   struct my_instrumentation { template <typename Event> void operator()(const Event&); };
+  // They are copied into prepared statements and should therefore be cheap handles to the actual sink.
+  // Policies may also provide attach_connection(const void* native_handle), which connections call once connected.
+  struct no_instrumentation
+  {
+  };
+
+  namespace detail
+  {
+    template <typename Instrumentation, typename = void>
+    struct has_attach_connection : std::false_type
+    {
+    };
+
+    template <typename Instrumentation>
+    struct has_attach_connection<
+        Instrumentation,
+        std::void_t<decltype(std::declval<Instrumentation&>().attach_connection(std::declval<const void*>()))>>
+        : std::true_type
+    {
+    };
+  }  // namespace detail
+
+  // Avoids reading the clock if instrumentation is disabled
+  template <bool Enabled>
+  auto instrumentation_now() -> instrumentation_clock::time_point
+  {
+    if constexpr (Enabled)
+    {
+      return instrumentation_clock::now();
+    }
+    else
+    {
+      return {};
+    }
+  }
+
+  template <typename Instrumentation>
+  class instrumentation_base
+  {
+    mutable Instrumentation _instrumentation;
+
+  public:
+    instrumentation_base() = default;
+    instrumentation_base(Instrumentation instrumentation) : _instrumentation(std::move(instrumentation))
+    {
+    }
+
+    static constexpr auto is_instrumented()
+    {
+      return true;
+    }
+
+    [[nodiscard]] auto& instrumentation() const
+    {
+      return _instrumentation;
+    }
+
+    template <typename Event>
+    auto instrument(const Event& event) const -> void
+    {
+      _instrumentation(event);
+    }
+
+    auto attach_connection([[maybe_unused]] const void* native_handle) -> void
+    {
+      if constexpr (detail::has_attach_connection<Instrumentation>::value)
+      {
+        _instrumentation.attach_connection(native_handle);
+      }
+    }
+  };
+
+  template <>
+  class instrumentation_base<no_instrumentation>
+  {
+  public:
+    instrumentation_base() = default;
+    instrumentation_base(no_instrumentation)
+    {
+    }
+
+    static constexpr auto is_instrumented()
+    {
+      return false;
+    }
+
+    [[nodiscard]] auto instrumentation() const
+    {
+      return no_instrumentation{};
+    }
+
+    template <typename Event>
+    auto instrument(const Event&) const -> void
+    {
+    }
+
+    auto attach_connection(const void*) -> void
+    {
+    }
+  };
+
+  // Wraps the result handle of a select to report the time and rows of fetching the result
+  template <typename ResultHandle, typename Instrumentation>
+  class instrumented_result_handle : private instrumentation_base<Instrumentation>
+  {
+    using _instrumentation_base = instrumentation_base<Instrumentation>;
+
+    ResultHandle _handle;
+    std::uint32_t _statement_hash = 0;
+    std::size_t _rows = 0;
+    instrumentation_clock::time_point _fetch_start = {};
+    bool _fetching = false;
+    bool _reported = false;
+
+  public:
+    using row_type = typename ResultHandle::row_type;
+
+    instrumented_result_handle() = default;
+    instrumented_result_handle(ResultHandle&& handle, Instrumentation instrumentation, std::uint32_t statement_hash)
+        : _instrumentation_base{std::move(instrumentation)}, _handle{std::move(handle)}, _statement_hash{statement_hash}
+    {
+    }
+
+    auto get_next_row() -> void
+    {
+      if (_reported)
+      {
+        return _handle.get_next_row();
+      }
+
+      if (not _fetching)
+      {
+        _fetching = true;
+        _fetch_start = instrumentation_clock::now();
+      }
+
+      _handle.get_next_row();
+
+      if (_handle)
+      {
+        ++_rows;
+      }
+      else
+      {
+        _reported = true;
+        const auto now = instrumentation_clock::now();
+        this->instrument(fetch_end_event{_statement_hash, _rows, now - _fetch_start, now});
+      }
+    }
+
+    [[nodiscard]] auto& row() const
+    {
+      return _handle.row();
+    }
+
+    [[nodiscard]] operator bool() const
+    {
+      return static_cast<bool>(_handle);
+    }
+  };
+
+  // Wraps result handles if instrumentation is enabled
+  template <typename Instrumentation, typename ResultHandle>
+  auto make_result_handle(ResultHandle&& handle,
+                          [[maybe_unused]] const instrumentation_base<Instrumentation>& instrumented,
+                          [[maybe_unused]] std::uint32_t statement_hash)
+  {
+    if constexpr (instrumentation_base<Instrumentation>::is_instrumented())
+    {
+      return instrumented_result_handle<ResultHandle, Instrumentation>{std::move(handle), instrumented.instrumentation(),
+                                                                       statement_hash};
+    }
+    else
+    {
+      return std::move(handle);
+    }
+  }
+
+}  // namespace sqlpp
@@ -50,6 +50,13 @@ namespace sqlpp
     using type = type_vector<Lhs, Rhs, Condition>;
   };
 
+  template <typename Lhs, typename JoinType, typename Rhs, typename Condition>
+  [[nodiscard]] constexpr auto required_tables_of([[maybe_unused]] type_t<join_t<Lhs, JoinType, Rhs, Condition>>)
+  {
+    // The condition refers to the joined tables, which are provided by the join itself
+    return required_tables_of(type_vector<Lhs, Rhs>{});
+  }
+
   template <typename Context, typename Lhs, typename JoinType, typename Rhs, typename Condition>
   [[nodiscard]] auto to_sql_string(Context& context, const join_t<Lhs, JoinType, Rhs, Condition>& t)
   {
@@ -56,7 +56,7 @@ namespace sqlpp
       {
         return failed<assert_conditionless_join_rhs_table>{};
       }
-      else if constexpr (!table_names_of_v<Lhs>.is_disjoint_from(table_names_of_v<remove_optional_t<Rhs>>))
+      else if constexpr (!names_are_disjoint(table_names_of_v<Lhs>, table_names_of_v<remove_optional_t<Rhs>>))
       {
         return failed<assert_conditionless_join_unique_names>{};
       }
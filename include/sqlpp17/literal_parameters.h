@@ -0,0 +1,88 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <sqlpp17/context_base.h>
+#include <sqlpp17/parameter.h>
+#include <sqlpp17/to_sql_string.h>
+#include <sqlpp17/type_traits.h>
+
+namespace sqlpp
+{
+  struct parameterized_sql_t
+  {
+    std::string sql;
+    std::vector<literal_value> literals;  // in the order of their placeholders
+  };
+
+  // Only the literals of inserts, updates, deletes and selects are parameterized. Other statements (e.g.
+  // CREATE TABLE with DEFAULT values or transaction control) do not accept parameters everywhere.
+  template <typename Statement>
+  inline constexpr auto is_literal_parameterizable_v =
+      std::is_same_v<result_type_of_t<Statement>, insert_result> or
+      std::is_same_v<result_type_of_t<Statement>, update_result> or
+      std::is_same_v<result_type_of_t<Statement>, delete_result> or
+      std::is_same_v<result_type_of_t<Statement>, select_result>;
+
+  // Serializes the statement with the connector's Context, replacing literal values (e.g. of value(),
+  // comparisons, assignments or limits) by parameters of that Context (e.g. "$1" or "?"). The SQL text then
+  // depends on the shape of the statement only, so that the statement caches of client and server get hits.
+  // NULL, unsigned values beyond int64_t, long double and non-finite values stay in the text.
+  template <typename Context, typename Statement>
+  [[nodiscard]] auto parameterize(const Statement& statement) -> parameterized_sql_t
+  {
+    auto literals = std::vector<literal_value>{};
+    auto context = Context{};
+    context.literals = &literals;
+    const auto marked = to_sql_string(context, statement);
+    context.literals = nullptr;
+
+    // Operands of string concatenations are not necessarily serialized from left to right. Thus, literals are
+    // marked by their index first and get their placeholders once the text is complete.
+    auto result = parameterized_sql_t{};
+    result.sql.reserve(marked.size());
+    result.literals.reserve(literals.size());
+    for (std::size_t i = 0; i < marked.size(); ++i)
+    {
+      if (marked[i] != detail::literal_marker)
+      {
+        result.sql.push_back(marked[i]);
+        continue;
+      }
+      const auto end = marked.find(detail::literal_marker, i + 1);
+      const auto index = std::stoul(marked.substr(i + 1, end - i - 1));
+      result.sql += to_sql_string(context, parameter_t<none_t, none_t>{});
+      result.literals.push_back(std::move(literals[index]));
+      i = end;
+    }
+    return result;
+  }
+}  // namespace sqlpp
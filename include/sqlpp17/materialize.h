@@ -0,0 +1,130 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <sqlpp17/member.h>
+#include <sqlpp17/result_column_base.h>
+#include <sqlpp17/result_row.h>
+#include <sqlpp17/wrong.h>
+
+namespace sqlpp
+{
+  namespace detail
+  {
+    template <typename T>
+    struct owned_value
+    {
+      using type = T;
+    };
+
+    template <>
+    struct owned_value<std::string_view>
+    {
+      using type = std::string;
+    };
+
+    template <typename T>
+    struct owned_value<std::optional<T>>
+    {
+      using type = std::optional<typename owned_value<T>::type>;
+    };
+
+    template <typename ColumnSpec>
+    using owned_column_t = typename owned_value<
+        std::decay_t<decltype(std::declval<const result_column_base<ColumnSpec>&>()())>>::type;
+
+    template <typename T>
+    auto to_owned(const T& value) -> typename owned_value<T>::type
+    {
+      return value;
+    }
+
+    inline auto to_owned(const std::string_view& value) -> std::string
+    {
+      return std::string(value);
+    }
+
+    template <typename T>
+    auto to_owned(const std::optional<T>& value) -> typename owned_value<std::optional<T>>::type
+    {
+      if (value)
+      {
+        return to_owned(*value);
+      }
+      return std::nullopt;
+    }
+  }  // namespace detail
+
+  // A result row that does not refer to memory of the connection or result it was read from: Text fields are
+  // std::string instead of std::string_view. Members are named like those of the original row.
+  template <typename ResultRow>
+  struct owned_row
+  {
+    static_assert(wrong<ResultRow>, "ResultRow must be a result_row_t<...>");
+  };
+
+  template <typename... ColumnSpecs>
+  class owned_result_row_t : public member_t<ColumnSpecs, detail::owned_column_t<ColumnSpecs>>...
+  {
+  public:
+    owned_result_row_t() = default;
+    owned_result_row_t(const result_row_t<ColumnSpecs...>& row)
+    {
+      (...,
+       (static_cast<member_t<ColumnSpecs, detail::owned_column_t<ColumnSpecs>>&>(*this)() =
+            detail::to_owned(static_cast<const result_column_base<ColumnSpecs>&>(row)())));
+    }
+  };
+
+  template <typename... ColumnSpecs>
+  struct owned_row<result_row_t<ColumnSpecs...>>
+  {
+    using type = owned_result_row_t<ColumnSpecs...>;
+  };
+
+  template <typename ResultRow>
+  using owned_row_t = typename owned_row<ResultRow>::type;
+
+  // Reads all rows of a result, e.g. to hand them to another thread
+  template <typename Result>
+  [[nodiscard]] auto materialize(Result&& result)
+  {
+    using _row_t = std::decay_t<decltype(*result.begin())>;
+    auto rows = std::vector<owned_row_t<_row_t>>{};
+    for (const auto& row : result)
+    {
+      rows.emplace_back(row);
+    }
+    return rows;
+  }
+}  // namespace sqlpp
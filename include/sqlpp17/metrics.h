@@ -0,0 +1,482 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sqlpp17/instrumentation.h>
+#include <sqlpp17/normalize_sql.h>
+
+namespace sqlpp
+{
+  namespace detail
+  {
+    [[nodiscard]] inline auto log2_floor(std::uint64_t value) -> unsigned
+    {
+#if defined(__GNUC__)
+      return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+      auto ret = 0u;
+      while (value >>= 1)
+        ++ret;
+      return ret;
+#endif
+    }
+
+    inline auto atomic_max(std::atomic<std::uint64_t>& target, std::uint64_t value) -> void
+    {
+      auto current = target.load(std::memory_order_relaxed);
+      while (current < value and
+             not target.compare_exchange_weak(current, value, std::memory_order_relaxed, std::memory_order_relaxed))
+      {
+      }
+    }
+  }  // namespace detail
+
+  struct histogram_snapshot
+  {
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t count = 0;
+    std::uint64_t total_nanoseconds = 0;
+    std::uint64_t max_nanoseconds = 0;
+
+    [[nodiscard]] auto mean() const -> std::chrono::nanoseconds;
+
+    // Upper bound of the bucket that contains the given quantile (0.0 to 1.0)
+    [[nodiscard]] auto percentile(double quantile) const -> std::chrono::nanoseconds;
+  };
+
+  // Lock-free latency histogram with logarithmic buckets in the style of HdrHistogram:
+  // Each power of two is split into 8 linear sub-buckets, i.e. values are recorded with a relative error below 12.5%.
+  // Values below 8ns are exact, values above ~18 minutes end up in the last bucket.
+  class latency_histogram
+  {
+  public:
+    static constexpr auto sub_bucket_bits = 3u;
+    static constexpr auto sub_bucket_count = 1u << sub_bucket_bits;
+    static constexpr auto max_exponent = 40u;
+    static constexpr auto bucket_count = (max_exponent - 1) * sub_bucket_count;
+
+    [[nodiscard]] static auto bucket_index(std::uint64_t nanoseconds) -> std::size_t
+    {
+      if (nanoseconds < sub_bucket_count)
+      {
+        return static_cast<std::size_t>(nanoseconds);
+      }
+
+      const auto exponent = detail::log2_floor(nanoseconds);
+      if (exponent > max_exponent)
+      {
+        return bucket_count - 1;
+      }
+
+      const auto shift = exponent - sub_bucket_bits;
+      const auto sub_bucket = static_cast<std::size_t>(nanoseconds >> shift) - sub_bucket_count;
+      return (shift + 1) * sub_bucket_count + sub_bucket;
+    }
+
+    [[nodiscard]] static auto bucket_upper_bound(std::size_t index) -> std::uint64_t
+    {
+      if (index < sub_bucket_count)
+      {
+        return index;
+      }
+
+      const auto shift = index / sub_bucket_count - 1;
+      const auto sub_bucket = index % sub_bucket_count;
+      return ((sub_bucket_count + sub_bucket + 1) << shift) - 1;
+    }
+
+    auto record(instrumentation_clock::duration duration) -> void
+    {
+      const auto count = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+      const auto nanoseconds = static_cast<std::uint64_t>(count < 0 ? 0 : count);
+
+      _buckets[bucket_index(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+      _count.fetch_add(1, std::memory_order_relaxed);
+      _total.fetch_add(nanoseconds, std::memory_order_relaxed);
+      detail::atomic_max(_max, nanoseconds);
+    }
+
+    [[nodiscard]] auto snapshot() const -> histogram_snapshot
+    {
+      auto ret = histogram_snapshot{};
+      ret.buckets.reserve(bucket_count);
+      for (const auto& bucket : _buckets)
+      {
+        ret.buckets.push_back(bucket.load(std::memory_order_relaxed));
+      }
+      ret.count = _count.load(std::memory_order_relaxed);
+      ret.total_nanoseconds = _total.load(std::memory_order_relaxed);
+      ret.max_nanoseconds = _max.load(std::memory_order_relaxed);
+      return ret;
+    }
+
+    auto reset() -> void
+    {
+      for (auto& bucket : _buckets)
+      {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+      _count.store(0, std::memory_order_relaxed);
+      _total.store(0, std::memory_order_relaxed);
+      _max.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, bucket_count> _buckets = {};
+    std::atomic<std::uint64_t> _count = 0;
+    std::atomic<std::uint64_t> _total = 0;
+    std::atomic<std::uint64_t> _max = 0;
+  };
+
+  inline auto histogram_snapshot::mean() const -> std::chrono::nanoseconds
+  {
+    return std::chrono::nanoseconds{count ? static_cast<std::int64_t>(total_nanoseconds / count) : 0};
+  }
+
+  inline auto histogram_snapshot::percentile(double quantile) const -> std::chrono::nanoseconds
+  {
+    if (count == 0)
+    {
+      return std::chrono::nanoseconds{0};
+    }
+
+    const auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+    auto seen = std::uint64_t{0};
+    for (auto index = std::size_t{0}; index < buckets.size(); ++index)
+    {
+      seen += buckets[index];
+      if (seen >= rank)
+      {
+        const auto upper_bound = latency_histogram::bucket_upper_bound(index);
+        return std::chrono::nanoseconds{
+            static_cast<std::int64_t>(upper_bound < max_nanoseconds ? upper_bound : max_nanoseconds)};
+      }
+    }
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(max_nanoseconds)};
+  }
+
+  enum class metrics_phase
+  {
+    serialize,
+    prepare,
+    execute,
+    fetch
+  };
+
+  struct statement_metrics_snapshot
+  {
+    std::uint32_t statement_hash = 0;
+    std::string sql;  // normalized, see normalize_sql
+    std::uint64_t calls = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t rows = 0;
+    histogram_snapshot serialize;
+    histogram_snapshot prepare;
+    histogram_snapshot execute;
+    histogram_snapshot fetch;
+  };
+
+  // Metrics per statement type, keyed by statement hash (see instrumentation.h).
+  // All updates are lock-free and may happen from any number of threads.
+  // The registry has a fixed capacity. Updates for statements beyond that capacity are counted as dropped.
+  class metrics_registry
+  {
+    struct entry
+    {
+      enum : std::uint32_t
+      {
+        empty,
+        claimed,
+        ready
+      };
+
+      std::atomic<std::uint32_t> state = empty;
+      std::uint32_t statement_hash = 0;
+      std::atomic<std::string*> sql = nullptr;
+      std::atomic<std::uint64_t> calls = 0;
+      std::atomic<std::uint64_t> errors = 0;
+      std::atomic<std::uint64_t> rows = 0;
+      std::array<latency_histogram, 4> latencies;
+
+      ~entry()
+      {
+        delete sql.load();
+      }
+    };
+
+    std::size_t _capacity;
+    string_escapes _escapes;
+    std::unique_ptr<entry[]> _entries;
+    std::atomic<std::uint64_t> _dropped = 0;
+
+    [[nodiscard]] auto find(std::uint32_t statement_hash) -> entry*
+    {
+      const auto mask = _capacity - 1;
+      for (auto probe = std::size_t{0}; probe < _capacity; ++probe)
+      {
+        auto& e = _entries[(statement_hash + probe) & mask];
+        auto state = e.state.load(std::memory_order_acquire);
+        if (state == entry::empty)
+        {
+          if (e.state.compare_exchange_strong(state, entry::claimed, std::memory_order_acquire))
+          {
+            e.statement_hash = statement_hash;
+            e.state.store(entry::ready, std::memory_order_release);
+            return &e;
+          }
+        }
+        while (state == entry::claimed)
+        {
+          // Another thread is about to publish the hash of this entry
+          state = e.state.load(std::memory_order_acquire);
+        }
+        if (e.statement_hash == statement_hash)
+        {
+          return &e;
+        }
+      }
+
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+  public:
+    // capacity is rounded up to a power of two.
+    // escapes tells normalize_sql how the connector escapes quotes, i.e. string_escapes::backslashes for mysql.
+    explicit metrics_registry(std::size_t capacity = 512, string_escapes escapes = string_escapes::doubled_quotes)
+        : _capacity(1), _escapes(escapes)
+    {
+      while (_capacity < capacity)
+        _capacity <<= 1;
+      _entries = std::make_unique<entry[]>(_capacity);
+    }
+
+    metrics_registry(const metrics_registry&) = delete;
+    metrics_registry(metrics_registry&&) = delete;
+    metrics_registry& operator=(const metrics_registry&) = delete;
+    metrics_registry& operator=(metrics_registry&&) = delete;
+    ~metrics_registry() = default;
+
+    [[nodiscard]] auto has_sql(std::uint32_t statement_hash) -> bool
+    {
+      const auto* e = find(statement_hash);
+      return not e or e->sql.load(std::memory_order_acquire) != nullptr;
+    }
+
+    // Only the first text per statement is kept
+    auto set_sql(std::uint32_t statement_hash, std::string_view sql) -> void
+    {
+      if (auto* e = find(statement_hash))
+      {
+        if (e->sql.load(std::memory_order_acquire))
+          return;
+
+        auto text = std::make_unique<std::string>(normalize_sql(sql, _escapes));
+        auto* expected = static_cast<std::string*>(nullptr);
+        if (e->sql.compare_exchange_strong(expected, text.get(), std::memory_order_acq_rel))
+        {
+          text.release();
+        }
+      }
+    }
+
+    auto record_call(std::uint32_t statement_hash) -> void
+    {
+      if (auto* e = find(statement_hash))
+        e->calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto record_error(std::uint32_t statement_hash) -> void
+    {
+      if (auto* e = find(statement_hash))
+        e->errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto record_rows(std::uint32_t statement_hash, std::size_t rows) -> void
+    {
+      if (auto* e = find(statement_hash))
+        e->rows.fetch_add(rows, std::memory_order_relaxed);
+    }
+
+    auto record_latency(std::uint32_t statement_hash, metrics_phase phase, instrumentation_clock::duration duration)
+        -> void
+    {
+      if (auto* e = find(statement_hash))
+        e->latencies[static_cast<std::size_t>(phase)].record(duration);
+    }
+
+    // Number of updates that did not fit into the registry
+    [[nodiscard]] auto dropped() const -> std::uint64_t
+    {
+      return _dropped.load(std::memory_order_relaxed);
+    }
+
+    // Updates that happen concurrently may or may not be part of the snapshot
+    [[nodiscard]] auto snapshot() const -> std::vector<statement_metrics_snapshot>
+    {
+      auto ret = std::vector<statement_metrics_snapshot>{};
+      for (auto index = std::size_t{0}; index < _capacity; ++index)
+      {
+        const auto& e = _entries[index];
+        if (e.state.load(std::memory_order_acquire) != entry::ready)
+          continue;
+
+        auto& s = ret.emplace_back();
+        s.statement_hash = e.statement_hash;
+        if (const auto* sql = e.sql.load(std::memory_order_acquire))
+          s.sql = *sql;
+        s.calls = e.calls.load(std::memory_order_relaxed);
+        s.errors = e.errors.load(std::memory_order_relaxed);
+        s.rows = e.rows.load(std::memory_order_relaxed);
+        s.serialize = e.latencies[static_cast<std::size_t>(metrics_phase::serialize)].snapshot();
+        s.prepare = e.latencies[static_cast<std::size_t>(metrics_phase::prepare)].snapshot();
+        s.execute = e.latencies[static_cast<std::size_t>(metrics_phase::execute)].snapshot();
+        s.fetch = e.latencies[static_cast<std::size_t>(metrics_phase::fetch)].snapshot();
+      }
+      return ret;
+    }
+
+    // Resets counters and histograms, statement texts are kept
+    auto reset() -> void
+    {
+      for (auto index = std::size_t{0}; index < _capacity; ++index)
+      {
+        auto& e = _entries[index];
+        e.calls.store(0, std::memory_order_relaxed);
+        e.errors.store(0, std::memory_order_relaxed);
+        e.rows.store(0, std::memory_order_relaxed);
+        for (auto& latency : e.latencies)
+        {
+          latency.reset();
+        }
+      }
+      _dropped.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  namespace detail
+  {
+    inline auto write_histogram(std::ostream& os, std::string_view name, const histogram_snapshot& h) -> void
+    {
+      if (h.count == 0)
+        return;
+
+      os << "  " << name << " count=" << h.count << " mean=" << h.mean().count()
+         << "ns p50=" << h.percentile(0.5).count() << "ns p90=" << h.percentile(0.9).count()
+         << "ns p99=" << h.percentile(0.99).count() << "ns max=" << h.max_nanoseconds << "ns\n";
+    }
+  }  // namespace detail
+
+  // Text format, one block per statement:
+  //   statement 0x1234abcd calls=2 errors=0 rows=3
+  //     sql: SELECT tab.id FROM tab WHERE tab.id = ?
+  //     execute count=2 mean=1500ns p50=1535ns p90=1535ns p99=1535ns max=1600ns
+  inline auto write_metrics(std::ostream& os, const std::vector<statement_metrics_snapshot>& metrics) -> void
+  {
+    const auto flags = os.flags();
+    for (const auto& s : metrics)
+    {
+      os << "statement 0x" << std::hex << std::setw(8) << std::setfill('0') << s.statement_hash << std::dec
+         << std::setfill(' ') << " calls=" << s.calls << " errors=" << s.errors << " rows=" << s.rows << '\n';
+      if (not s.sql.empty())
+        os << "  sql: " << s.sql << '\n';
+      detail::write_histogram(os, "serialize", s.serialize);
+      detail::write_histogram(os, "prepare", s.prepare);
+      detail::write_histogram(os, "execute", s.execute);
+      detail::write_histogram(os, "fetch", s.fetch);
+    }
+    os.flags(flags);
+  }
+
+  // Instrumentation policy (see instrumentation.h) that records into a metrics_registry.
+  // Each connection and prepared statement has its own copy, which pairs start and end events.
+  class metrics_instrumentation
+  {
+    metrics_registry* _registry;
+    instrumentation_clock::time_point _prepare_start = {};
+    instrumentation_clock::time_point _execute_start = {};
+
+  public:
+    metrics_instrumentation(metrics_registry& registry) : _registry(&registry)
+    {
+    }
+
+    auto operator()(const prepare_start_event& event) -> void
+    {
+      if (not _registry->has_sql(event.statement_hash))
+        _registry->set_sql(event.statement_hash, event.sql);
+      _registry->record_latency(event.statement_hash, metrics_phase::serialize, event.serialization_time);
+      _prepare_start = event.time;
+    }
+
+    auto operator()(const prepare_end_event& event) -> void
+    {
+      _registry->record_latency(event.statement_hash, metrics_phase::prepare, event.time - _prepare_start);
+    }
+
+    auto operator()(const execute_start_event& event) -> void
+    {
+      if (not event.sql.empty())
+      {
+        if (not _registry->has_sql(event.statement_hash))
+          _registry->set_sql(event.statement_hash, event.sql);
+        _registry->record_latency(event.statement_hash, metrics_phase::serialize, event.serialization_time);
+      }
+      _registry->record_call(event.statement_hash);
+      _execute_start = event.time;
+    }
+
+    auto operator()(const execute_end_event& event) -> void
+    {
+      _registry->record_latency(event.statement_hash, metrics_phase::execute, event.time - _execute_start);
+      if (event.rows)
+        _registry->record_rows(event.statement_hash, *event.rows);
+    }
+
+    auto operator()(const fetch_end_event& event) -> void
+    {
+      _registry->record_latency(event.statement_hash, metrics_phase::fetch, event.fetch_time);
+      _registry->record_rows(event.statement_hash, event.rows);
+    }
+
+    auto operator()(const error_event& event) -> void
+    {
+      _registry->record_error(event.statement_hash);
+    }
+  };
+}  // namespace sqlpp
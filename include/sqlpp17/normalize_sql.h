@@ -0,0 +1,114 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cctype>
+#include <string>
+#include <string_view>
+
+namespace sqlpp
+{
+  // How quotes are escaped within string literals
+  enum class string_escapes
+  {
+    doubled_quotes,  // 'it''s', standard SQL, e.g. postgresql and sqlite3
+    backslashes      // 'it\'s' or 'it''s', mysql unless NO_BACKSLASH_ESCAPES is set
+  };
+
+  // Replaces literal values in serialized SQL by '?', so that statements that only differ in their values
+  // map to the same text, e.g.
+  //   SELECT name FROM tab WHERE id = 17 AND name = 'it''s'  ->  SELECT name FROM tab WHERE id = ? AND name = ?
+  // Identifiers (including quoted ones) and parameters like $1 are kept.
+  [[nodiscard]] inline auto normalize_sql(std::string_view sql,
+                                          string_escapes escapes = string_escapes::doubled_quotes) -> std::string
+  {
+    auto ret = std::string{};
+    ret.reserve(sql.size());
+
+    const auto is_word_char = [](char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) or c == '_' or c == '$';
+    };
+
+    for (auto i = std::size_t{0}; i < sql.size();)
+    {
+      const auto c = sql[i];
+      if (c == '\'')
+      {
+        // String literal, quotes are escaped by doubling them (or by a backslash)
+        for (++i; i < sql.size(); ++i)
+        {
+          if (sql[i] == '\\' and escapes == string_escapes::backslashes)
+          {
+            ++i;
+          }
+          else if (sql[i] == '\'')
+          {
+            if (i + 1 < sql.size() and sql[i + 1] == '\'')
+              ++i;
+            else
+              break;
+          }
+        }
+        ++i;
+        ret.push_back('?');
+      }
+      else if (c == '"' or c == '`')
+      {
+        // Quoted identifier
+        const auto end = sql.find(c, i + 1);
+        const auto length = (end == std::string_view::npos) ? sql.size() - i : end + 1 - i;
+        ret.append(sql.substr(i, length));
+        i += length;
+      }
+      else if (std::isdigit(static_cast<unsigned char>(c)) and (i == 0 or not is_word_char(sql[i - 1])))
+      {
+        // Numeric literal, including decimal points and exponents
+        for (++i; i < sql.size(); ++i)
+        {
+          const auto d = sql[i];
+          if (std::isdigit(static_cast<unsigned char>(d)) or d == '.')
+            continue;
+          if ((d == 'e' or d == 'E') and i + 1 < sql.size())
+          {
+            if (sql[i + 1] == '+' or sql[i + 1] == '-')
+              ++i;
+            continue;
+          }
+          break;
+        }
+        ret.push_back('?');
+      }
+      else
+      {
+        ret.push_back(c);
+        ++i;
+      }
+    }
+
+    return ret;
+  }
+}  // namespace sqlpp
@@ -26,9 +26,13 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <tuple>
+
 #include <sqlpp17/as_base.h>
 #include <sqlpp17/to_sql_string.h>
+#include <sqlpp17/tuple_to_sql_string.h>
 #include <sqlpp17/type_traits.h>
+#include <sqlpp17/value_list.h>
 
 namespace sqlpp
 {
@@ -49,7 +53,15 @@ namespace sqlpp
   constexpr auto in(L l, Args... args)
       -> std::enable_if_t<((sizeof...(Args) > 0) and ... and values_are_compatible_v<L, Args>), in_t<L, Args...>>
   {
-    return in_t<L, Args...>{l, std::tuple{args...}};
+    return in_t<L, Args...>{{}, l, std::tuple{args...}};
+  }
+
+  // Runtime sized, e.g. in(col, ids) with a std::vector<int64_t> ids
+  template <typename L, typename Range>
+  auto in(L l, Range range)
+      -> std::enable_if_t<is_value_range_of_v<L, Range>, in_t<L, value_list_t<range_value_t<Range>>>>
+  {
+    return {{}, l, std::tuple{make_value_list(std::move(range))}};
   }
 
   template <typename L, typename... Args>
@@ -73,4 +85,10 @@ namespace sqlpp
       return to_sql_string(context, embrace(t.l)) + " IN(" + tuple_to_sql_string(context, ", ", t.args) + ")";
     }
   }
+
+  template <typename Context, typename L, typename T>
+  [[nodiscard]] auto to_sql_string(Context& context, const in_t<L, value_list_t<T>>& t)
+  {
+    return detail::value_list_to_sql_string(context, t.l, std::get<0>(t.args), " IN(", " OR ", "1 = 0");
+  }
 }  // namespace sqlpp
@@ -0,0 +1,241 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#ifndef __linux__
+#error "sqlpp17/reactor.h is based on epoll and available on Linux only"
+#endif
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <sqlpp17/exception.h>
+
+namespace sqlpp
+{
+  // Gets notified by the reactor when a watched file descriptor is ready
+  class reactor_watcher
+  {
+  public:
+    virtual ~reactor_watcher() = default;
+    virtual auto on_ready(std::uint32_t events) -> void = 0;
+  };
+
+  // Event loop based on epoll (Linux only). Asynchronous connections register their sockets with a reactor, and
+  // whichever thread calls run() or run_once() drives all of them. To use several threads, use several reactors.
+  //
+  // post(), stop() and wake() can be called from any thread. Everything else, including the callbacks of watchers
+  // and posted functions, happens on the thread running the reactor.
+  class reactor_t
+  {
+    int _epoll = -1;
+    int _wakeup = -1;
+    // Indexed by file descriptor (an unordered_map's iterators would run into the comparison operators of sqlpp)
+    std::vector<reactor_watcher*> _watchers;
+    std::size_t _watched = 0;
+
+    std::mutex _mutex;
+    std::vector<std::function<void()>> _posted;
+    std::atomic<bool> _stopped = false;
+
+    static constexpr auto _max_events = 64;
+
+    auto control(int operation, int fd, std::uint32_t events) -> void
+    {
+      auto event = ::epoll_event{};
+      event.events = events;
+      event.data.fd = fd;
+      if (::epoll_ctl(_epoll, operation, fd, &event) != 0)
+      {
+        throw ::sqlpp::exception(std::string("Reactor: epoll_ctl failed: ") + std::strerror(errno));
+      }
+    }
+
+    auto run_posted() -> std::size_t
+    {
+      auto posted = std::vector<std::function<void()>>{};
+      {
+        const auto lock = std::lock_guard{_mutex};
+        posted.swap(_posted);
+      }
+      for (std::size_t i = 0; i < posted.size(); ++i)
+      {
+        posted[i]();
+      }
+      return posted.size();
+    }
+
+    auto close() noexcept -> void
+    {
+      if (_wakeup >= 0)
+        ::close(_wakeup);
+      if (_epoll >= 0)
+        ::close(_epoll);
+    }
+
+  public:
+    static constexpr std::uint32_t readable = EPOLLIN;
+    static constexpr std::uint32_t writable = EPOLLOUT;
+
+    reactor_t() : _epoll(::epoll_create1(EPOLL_CLOEXEC)), _wakeup(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+      if (_epoll < 0 or _wakeup < 0)
+      {
+        const auto message = std::string("Reactor: could not create epoll instance: ") + std::strerror(errno);
+        close();
+        throw ::sqlpp::exception(message);
+      }
+      control(EPOLL_CTL_ADD, _wakeup, readable);
+    }
+    reactor_t(const reactor_t&) = delete;
+    reactor_t(reactor_t&&) = delete;
+    reactor_t& operator=(const reactor_t&) = delete;
+    reactor_t& operator=(reactor_t&&) = delete;
+    ~reactor_t()
+    {
+      close();
+    }
+
+    // The watcher must stay alive until the file descriptor is unwatched. Watching is level-triggered.
+    auto watch(int fd, std::uint32_t events, reactor_watcher& watcher) -> void
+    {
+      control(EPOLL_CTL_ADD, fd, events);
+      if (static_cast<std::size_t>(fd) >= _watchers.size())
+      {
+        _watchers.resize(fd + 1, nullptr);
+      }
+      _watchers[fd] = &watcher;
+      ++_watched;
+    }
+
+    auto modify(int fd, std::uint32_t events) -> void
+    {
+      control(EPOLL_CTL_MOD, fd, events);
+    }
+
+    // Does not throw, so that it can be used for cleaning up. The file descriptor may have been closed already.
+    auto unwatch(int fd) noexcept -> void
+    {
+      if (fd >= 0 and static_cast<std::size_t>(fd) < _watchers.size() and _watchers[fd])
+      {
+        _watchers[fd] = nullptr;
+        --_watched;
+        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+      }
+    }
+
+    [[nodiscard]] auto watched() const -> std::size_t
+    {
+      return _watched;
+    }
+
+    // Runs the function on the reactor's thread
+    auto post(std::function<void()> function) -> void
+    {
+      {
+        const auto lock = std::lock_guard{_mutex};
+        _posted.push_back(std::move(function));
+      }
+      wake();
+    }
+
+    // Makes a blocked run_once() return
+    auto wake() -> void
+    {
+      const auto one = std::uint64_t{1};
+      [[maybe_unused]] const auto written = ::write(_wakeup, &one, sizeof(one));
+    }
+
+    // Waits for events at most timeout (forever, if there is none) and handles them.
+    // Returns the number of watcher notifications and posted functions handled.
+    auto run_once(std::optional<std::chrono::milliseconds> timeout = std::nullopt) -> std::size_t
+    {
+      ::epoll_event events[_max_events];
+      const auto count = ::epoll_wait(_epoll, events, _max_events, timeout ? static_cast<int>(timeout->count()) : -1);
+      if (count < 0)
+      {
+        if (errno == EINTR)
+          return 0;
+        throw ::sqlpp::exception(std::string("Reactor: epoll_wait failed: ") + std::strerror(errno));
+      }
+
+      auto handled = std::size_t{0};
+      auto woken = false;
+      for (int i = 0; i < count; ++i)
+      {
+        const auto fd = events[i].data.fd;
+        if (fd == _wakeup)
+        {
+          auto value = std::uint64_t{};
+          [[maybe_unused]] const auto read = ::read(_wakeup, &value, sizeof(value));
+          woken = true;
+          continue;
+        }
+        // Earlier notifications might have unwatched the file descriptor
+        if (static_cast<std::size_t>(fd) < _watchers.size() and _watchers[fd])
+        {
+          _watchers[fd]->on_ready(events[i].events);
+          ++handled;
+        }
+      }
+
+      if (woken)
+      {
+        handled += run_posted();
+      }
+      return handled;
+    }
+
+    // Handles events until stop() is called
+    auto run() -> void
+    {
+      while (not _stopped)
+      {
+        run_once();
+      }
+      _stopped = false;
+    }
+
+    auto stop() -> void
+    {
+      _stopped = true;
+      wake();
+    }
+  };
+}  // namespace sqlpp
@@ -91,8 +91,13 @@ namespace sqlpp
         return not _result._handle;
       }
 
-      template <typename T>
-      auto operator!=(const T& rhs) const -> bool
+      // Not templated, so that these are preferred over the expression operators in namespace sqlpp
+      [[nodiscard]] auto operator!=(const iterator& rhs) const -> bool
+      {
+        return not(operator==(rhs));
+      }
+
+      [[nodiscard]] auto operator!=(const result_end_t& rhs) const -> bool
       {
         return not(operator==(rhs));
       }
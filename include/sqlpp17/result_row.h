@@ -53,7 +53,7 @@ namespace sqlpp
       else
       {
         return (true && ... &&
-                (char_sequence_of_t<LeftColumnSpecs>{} == char_sequence_of_t<RightColumnSpecs>{} and
+                (have_same_name<LeftColumnSpecs, RightColumnSpecs>() and
                  std::is_same_v<value_type_of_t<LeftColumnSpecs>, value_type_of_t<RightColumnSpecs>>));
       }
     }
@@ -0,0 +1,225 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <type_traits>
+
+#include <sqlpp17/connection.h>
+#include <sqlpp17/exception.h>
+#include <sqlpp17/transaction.h>
+
+namespace sqlpp
+{
+  struct retry_metrics_snapshot
+  {
+    std::uint64_t calls = 0;      // calls of with_retry
+    std::uint64_t attempts = 0;   // runs of transaction bodies
+    std::uint64_t retries = 0;    // attempts after transient errors
+    std::uint64_t recovered = 0;  // calls that succeeded after at least one retry
+    std::uint64_t exhausted = 0;  // calls that failed with a transient error after max_attempts
+    std::chrono::microseconds backoff = {};
+  };
+
+  // Thread-safe, can be shared by any number of retry policies
+  class retry_metrics
+  {
+    std::atomic<std::uint64_t> _calls = 0;
+    std::atomic<std::uint64_t> _attempts = 0;
+    std::atomic<std::uint64_t> _retries = 0;
+    std::atomic<std::uint64_t> _recovered = 0;
+    std::atomic<std::uint64_t> _exhausted = 0;
+    std::atomic<std::uint64_t> _backoff_us = 0;
+
+  public:
+    auto record_call() -> void
+    {
+      _calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto record_attempt() -> void
+    {
+      _attempts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto record_retry(std::chrono::microseconds backoff) -> void
+    {
+      _retries.fetch_add(1, std::memory_order_relaxed);
+      _backoff_us.fetch_add(static_cast<std::uint64_t>(backoff.count()), std::memory_order_relaxed);
+    }
+
+    auto record_recovered() -> void
+    {
+      _recovered.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto record_exhausted() -> void
+    {
+      _exhausted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto snapshot() const -> retry_metrics_snapshot
+    {
+      return retry_metrics_snapshot{_calls.load(std::memory_order_relaxed),
+                                    _attempts.load(std::memory_order_relaxed),
+                                    _retries.load(std::memory_order_relaxed),
+                                    _recovered.load(std::memory_order_relaxed),
+                                    _exhausted.load(std::memory_order_relaxed),
+                                    std::chrono::microseconds{_backoff_us.load(std::memory_order_relaxed)}};
+    }
+
+    auto reset() -> void
+    {
+      _calls = 0;
+      _attempts = 0;
+      _retries = 0;
+      _recovered = 0;
+      _exhausted = 0;
+      _backoff_us = 0;
+    }
+  };
+
+  struct retry_policy
+  {
+    std::size_t max_attempts = 5;  // including the first one
+    std::chrono::microseconds initial_backoff = std::chrono::milliseconds{2};
+    std::chrono::microseconds max_backoff = std::chrono::milliseconds{200};
+    double backoff_multiplier = 2.0;
+    retry_metrics* metrics = nullptr;
+  };
+
+  namespace detail
+  {
+    // Exponential backoff with "full jitter": Uniformly distributed between zero and the exponential bound,
+    // so that competing writers do not retry in lock step.
+    inline auto retry_backoff(const retry_policy& policy, std::size_t retry) -> std::chrono::microseconds
+    {
+      const auto max_backoff = static_cast<double>(policy.max_backoff.count());
+      auto bound = static_cast<double>(policy.initial_backoff.count());
+      for (std::size_t i = 1; i < retry and bound < max_backoff; ++i)
+      {
+        bound *= policy.backoff_multiplier;
+      }
+      bound = std::min(bound, max_backoff);
+
+      thread_local auto engine = std::minstd_rand{std::random_device{}()};
+      return std::chrono::microseconds{
+          static_cast<std::chrono::microseconds::rep>(std::uniform_real_distribution<double>{0.0, bound}(engine))};
+    }
+
+    template <typename Connection, typename Body>
+    auto run_transaction(Connection& connection, Body& body)
+    {
+      auto transaction = start_transaction(connection);
+      if constexpr (std::is_void_v<std::invoke_result_t<Body&, Connection&>>)
+      {
+        body(connection);
+        transaction.commit();
+      }
+      else
+      {
+        auto result = body(connection);
+        transaction.commit();
+        return result;
+      }
+    }
+
+    template <typename DbOrPool, typename Body>
+    auto run_attempt(DbOrPool& db_or_pool, Body& body)
+    {
+      if constexpr (std::is_base_of_v<::sqlpp::connection, DbOrPool>)
+      {
+        return run_transaction(db_or_pool, body);
+      }
+      else
+      {
+        // Each attempt uses a connection of the pool
+        auto connection = db_or_pool.get();
+        return run_transaction(connection, body);
+      }
+    }
+  }  // namespace detail
+
+  // Runs body(db) in a transaction and runs it again if the transaction fails with a transient error
+  // (see sqlpp::exception::is_transient), e.g. if the database is busy, or a deadlock or serialization failure was
+  // detected. Other errors and the error of the last attempt are rethrown. Returns the result of the body.
+  // The body must not have side effects outside of the transaction, and db must not have an open transaction.
+  template <typename DbOrPool, typename Body>
+  auto with_retry(DbOrPool& db_or_pool, const retry_policy& policy, Body&& body)
+  {
+    if (policy.metrics)
+      policy.metrics->record_call();
+
+    for (std::size_t attempt = 1;; ++attempt)
+    {
+      try
+      {
+        if (policy.metrics)
+          policy.metrics->record_attempt();
+
+        if constexpr (std::is_void_v<decltype(detail::run_attempt(db_or_pool, body))>)
+        {
+          detail::run_attempt(db_or_pool, body);
+          if (policy.metrics and attempt > 1)
+            policy.metrics->record_recovered();
+          return;
+        }
+        else
+        {
+          auto result = detail::run_attempt(db_or_pool, body);
+          if (policy.metrics and attempt > 1)
+            policy.metrics->record_recovered();
+          return result;
+        }
+      }
+      catch (const ::sqlpp::exception& e)
+      {
+        if (not e.is_transient())
+        {
+          throw;
+        }
+        if (attempt >= policy.max_attempts)
+        {
+          if (policy.metrics)
+            policy.metrics->record_exhausted();
+          throw;
+        }
+      }
+
+      const auto backoff = detail::retry_backoff(policy, attempt);
+      if (policy.metrics)
+        policy.metrics->record_retry(backoff);
+      std::this_thread::sleep_for(backoff);
+    }
+  }
+}  // namespace sqlpp
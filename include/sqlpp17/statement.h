@@ -81,7 +81,7 @@ namespace sqlpp
     template <typename... Ts>
     [[nodiscard]] constexpr auto have_unique_names(type_vector<Ts...>)
     {
-      return type_set(char_sequence_of_v<Ts>...).size() == type_vector<Ts...>::size();
+      return names_are_unique<Ts...>();
     }
   }  // namespace detail
 
@@ -194,8 +194,10 @@ namespace sqlpp
   template <typename Context, typename... Clauses>
   [[nodiscard]] auto to_sql_string(Context& context, const statement<Clauses...>& t)
   {
-    return (std::string{} + ... +
-            to_sql_string(context, static_cast<const clause_base<Clauses, statement<Clauses...>>&>(t)));
+    // Clauses are serialized from left to right, numbered parameters (e.g. ?1, $1) depend on it
+    auto ret = std::string{};
+    ((ret += to_sql_string(context, static_cast<const clause_base<Clauses, statement<Clauses...>>&>(t))), ...);
+    return ret;
   }
 
   template <typename... LClauses, typename... RClauses>
@@ -26,7 +26,6 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
-#include <sqlpp17/char_sequence.h>
 #include <sqlpp17/join.h>
 #include <sqlpp17/member.h>
 #include <sqlpp17/table_alias.h>
@@ -88,7 +87,7 @@ namespace sqlpp
   constexpr auto is_table_v<table_t<TableSpec>> = true;
 
   template <typename TableSpec>
-  constexpr auto table_names_of_v<table_t<TableSpec>> = type_set<char_sequence_of_t<table_t<TableSpec>>>();
+  constexpr auto table_names_of_v<table_t<TableSpec>> = type_set<name_tag_of_t<table_t<TableSpec>>>();
 
   template <typename TableSpec>
   [[nodiscard]] constexpr auto column_tuple_of(const table_t<TableSpec>& t)
@@ -26,14 +26,69 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <array>
+#include <charconv>
 #include <cmath>
-#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include <optional>
-#include <sstream>
 #include <string>
+#include <type_traits>
 
+#include <sqlpp17/context_base.h>
+#include <sqlpp17/detail/find_first_of.h>
 #include <sqlpp17/exception.h>
 
+namespace sqlpp::detail
+{
+  // Shortest representation that reads back to the exact same value.
+  // Expects a finite value, NaN and Infinity are handled by the connectors.
+  template <typename T>
+  [[nodiscard]] auto float_to_chars(const T& f) -> std::string
+  {
+    // sign, digits, decimal point and exponent
+    auto buffer = std::array<char, std::numeric_limits<T>::max_digits10 + 16>{};
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), f);
+    return std::string(buffer.data(), end);
+#else
+    // Fallback for standard libraries without floating point to_chars:
+    // Not necessarily the shortest, but it still round-trips.
+    const auto size = [&]() {
+      if constexpr (std::is_same_v<T, long double>)
+        return std::snprintf(buffer.data(), buffer.size(), "%.*Lg", std::numeric_limits<T>::max_digits10, f);
+      else
+        return std::snprintf(buffer.data(), buffer.size(), "%.*g", std::numeric_limits<T>::max_digits10,
+                             static_cast<double>(f));
+    }();
+    return std::string(buffer.data(), static_cast<std::size_t>(size));
+#endif
+  }
+
+  // The double that the database reads from the text written by float_to_chars.
+  // Binding static_cast<double>(f) instead would turn 0.1f into 0.100000001490116...
+  template <typename T>
+  [[nodiscard]] auto float_to_bound_double(const T& f) -> double
+  {
+    if constexpr (std::is_same_v<T, double>)
+    {
+      return f;
+    }
+    else
+    {
+      const auto text = float_to_chars(f);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+      auto value = 0.0;
+      std::from_chars(text.data(), text.data() + text.size(), value);
+      return value;
+#else
+      return std::strtod(text.c_str(), nullptr);
+#endif
+    }
+  }
+}  // namespace sqlpp::detail
+
 namespace sqlpp
 {
   template <typename Context, typename T>
@@ -57,13 +112,16 @@ namespace sqlpp
   template <typename Context>
   [[nodiscard]] auto to_sql_string(Context& context, const std::string_view& s)
   {
-    auto ret = std::string{"'"};
-    for (const auto c : s)
+    if (detail::collects_literals(context))
     {
-      if (c == '\'')
-        ret.push_back(c);  // Escaping
-      ret.push_back(c);
+      return detail::add_literal(context, std::string(s));
     }
+
+    auto ret = std::string{};
+    ret.reserve(s.size() + 2);
+    ret.push_back('\'');
+    // Standard SQL: Quotes are escaped by doubling them
+    detail::append_escaped<'\''>(ret, s, [](std::string& target, char c) { target.append(2, c); });
     ret.push_back('\'');
     return ret;
   }
@@ -71,6 +129,19 @@ namespace sqlpp
   template <typename Context, typename T>
   [[nodiscard]] auto to_sql_string(Context& context, const T& i) -> std::enable_if_t<std::is_integral_v<T>, std::string>
   {
+    if (detail::collects_literals(context))
+    {
+      // Unsigned values beyond int64_t stay in the text
+      if constexpr (std::is_same_v<T, bool>)
+      {
+        return detail::add_literal(context, i);
+      }
+      else if (not std::is_unsigned_v<T> or
+               static_cast<std::uintmax_t>(i) <= static_cast<std::uintmax_t>(std::numeric_limits<std::int64_t>::max()))
+      {
+        return detail::add_literal(context, static_cast<std::int64_t>(i));
+      }
+    }
     return std::to_string(i);
   }
 
@@ -104,12 +175,13 @@ namespace sqlpp
     {
       return f > std::numeric_limits<T>::max() ? inf_to_sql_string(context) : neg_inf_to_sql_string(context);
     }
+    else if (detail::collects_literals(context) and not std::is_same_v<T, long double>)
+    {
+      return detail::add_literal(context, detail::float_to_bound_double(f));
+    }
     else
     {
-      // TODO: Once gcc and clang support to_chars, try that
-      auto oss = std::ostringstream{};
-      oss << std::setprecision(std::numeric_limits<long double>::digits10 + 1) << f;
-      return oss.str();
+      return detail::float_to_chars(f);
     }
   }
 
@@ -26,10 +26,57 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <optional>
+#include <string>
 #include <utility>
 
+#include <sqlpp17/isolation_level.h>
+
 namespace sqlpp
 {
+  // How sqlite3 acquires locks when a transaction starts
+  enum class begin_mode
+  {
+    deferred,   // when first reading or writing
+    immediate,  // write lock right away, avoids lock upgrade deadlocks of writing transactions
+    exclusive   // exclusive lock right away
+  };
+
+  enum class access_mode
+  {
+    read_write,
+    read_only
+  };
+
+  inline constexpr auto read_write = access_mode::read_write;
+  // Read only transactions are cheaper: mysql skips assigning transaction ids and undo logging, postgresql
+  // serializable read only deferrable transactions run on a safe snapshot without serialization checks, and sqlite3
+  // begins deferred and rejects writes (PRAGMA query_only), so that no write locks are taken.
+  inline constexpr auto read_only = access_mode::read_only;
+
+  // Options are ignored by connectors that do not support them, e.g. begin_mode outside of sqlite3.
+  // Nested transactions (savepoints) ignore all options.
+  // Example: start_transaction(db, {::sqlpp::read_only, ::sqlpp::isolation_level::repeatable_read})
+  struct transaction_options
+  {
+    ::sqlpp::access_mode access = ::sqlpp::access_mode::read_write;
+    ::sqlpp::isolation_level isolation = ::sqlpp::isolation_level::current;
+    // postgresql: DEFERRABLE or NOT DEFERRABLE, by default DEFERRABLE for read only serializable transactions
+    std::optional<bool> deferrable = std::nullopt;
+    ::sqlpp::begin_mode begin = ::sqlpp::begin_mode::deferred;
+  };
+
+  namespace detail
+  {
+    // Savepoint of the transaction nested at the given depth (the outermost transaction has depth 0)
+    inline auto savepoint_name(std::size_t depth) -> std::string
+    {
+      return "sqlpp_savepoint_" + std::to_string(depth);
+    }
+  }  // namespace detail
+
+  // Transactions started while another transaction of the same connection is open are nested, i.e. they
+  // use SAVEPOINT, RELEASE and ROLLBACK TO. They must be committed or rolled back before the enclosing one.
   template <typename Connection>
   class transaction_t
   {
@@ -39,9 +86,9 @@ namespace sqlpp
     bool _committed = false;
 
   public:
-    transaction_t(Connection& connection) : _connection(connection)
+    transaction_t(Connection& connection, const transaction_options& options = {}) : _connection(connection)
     {
-      _connection.start_transaction();
+      _connection.start_transaction(options);
     }
 
     transaction_t(const transaction_t&) = delete;
@@ -64,12 +111,13 @@ namespace sqlpp
       }
     }
 
+    // If committing fails, the transaction is still open and the destructor rolls it back
     void commit()
     {
       if (not _committed)
       {
-        _committed = true;
         _connection.commit();
+        _committed = true;
       }
     }
 
@@ -84,9 +132,9 @@ namespace sqlpp
   };
 
   template <typename Connection>
-  auto start_transaction(Connection& connection)
+  auto start_transaction(Connection& connection, const transaction_options& options = {})
   {
-    return transaction_t{connection};
+    return transaction_t{connection, options};
   }
 
 }  // namespace sqlpp
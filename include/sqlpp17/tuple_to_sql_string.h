@@ -39,7 +39,10 @@ namespace sqlpp ::detail
                                               const std::tuple<Ts...>& t,
                                               std::integer_sequence<std::size_t, Is...>)
   {
-    return (std::string{} + ... + ((Is ? separator : "") + to_sql_string(context, std::get<Is>(t))));
+    // The comma operator serializes the elements from left to right, operands of + have no such order
+    auto ret = std::string{};
+    ((ret += (Is ? separator : "") + to_sql_string(context, std::get<Is>(t))), ...);
+    return ret;
   }
 }  // namespace sqlpp::detail
 
@@ -103,7 +103,15 @@ namespace sqlpp
     template <typename... Ls, typename... Rs>
     [[nodiscard]] constexpr auto operator==(_type_set<Ls...> lhs, _type_set<Rs...> rhs)
     {
-      return rhs <= lhs && lhs <= rhs;
+      // Elements are unique, so sets of equal size are equal if one contains the other
+      if constexpr (sizeof...(Ls) != sizeof...(Rs))
+      {
+        return false;
+      }
+      else
+      {
+        return lhs >= rhs;
+      }
     }
 
     template <typename... Ls, typename... Rs>
@@ -112,48 +120,114 @@ namespace sqlpp
       return !(lhs == rhs);
     }
 
+    // Concatenates sets that are known to be disjoint without instantiating the intermediate sets.
+    template <typename... Sets>
+    struct _join
+    {
+      using type = _type_set<>;
+    };
+
+    template <typename... Ts>
+    struct _join<_type_set<Ts...>>
+    {
+      using type = _type_set<Ts...>;
+    };
+
+    template <typename... As, typename... Bs, typename... Sets>
+    struct _join<_type_set<As...>, _type_set<Bs...>, Sets...> : _join<_type_set<As..., Bs...>, Sets...>
+    {
+    };
+
+    template <typename... As, typename... Bs, typename... Cs, typename... Ds, typename... Sets>
+    struct _join<_type_set<As...>, _type_set<Bs...>, _type_set<Cs...>, _type_set<Ds...>, Sets...>
+        : _join<_type_set<As..., Bs..., Cs..., Ds...>, Sets...>
+    {
+    };
+
+    template <typename... Sets>
+    using _join_t = typename _join<Sets...>::type;
+
     template <typename... Ls, typename... Rs>
-    [[nodiscard]] constexpr auto operator|(_type_set<Ls...> lhs, _type_set<Rs...> rhs)
+    [[nodiscard]] constexpr auto operator|(_type_set<Ls...> lhs, _type_set<Rs...>)
     {
-      return (lhs << ... << _base<Rs>{});
+      return _join_t<_type_set<Ls...>,
+                     std::conditional_t<lhs.template count<Rs>(), _type_set<>, _type_set<Rs>>...>{};
     }
 
     template <typename... Ls, typename... Rs>
     [[nodiscard]] constexpr auto operator&(_type_set<Ls...> lhs, _type_set<Rs...>)
     {
-      return (_type_set<>{} | ... | std::conditional_t<lhs.template count<Rs>(), _type_set<Rs>, _type_set<>>{});
+      return _join_t<std::conditional_t<lhs.template count<Rs>(), _type_set<Rs>, _type_set<>>...>{};
     }
 
     template <typename... Ls, typename... Rs>
     [[nodiscard]] constexpr auto operator-(_type_set<Ls...>, _type_set<Rs...> rhs)
     {
-      return (_type_set<>{} | ... | std::conditional_t<rhs.template count<Ls>(), _type_set<>, _type_set<Ls>>{});
+      return _join_t<std::conditional_t<rhs.template count<Ls>(), _type_set<>, _type_set<Ls>>...>{};
     }
 
     template <typename... Ls, typename... Rs>
     [[nodiscard]] constexpr auto operator^(_type_set<Ls...> lhs, _type_set<Rs...> rhs)
     {
-      return (lhs | rhs) - (rhs & rhs);
+      return (lhs | rhs) - (lhs & rhs);
     }
+
+    template <std::size_t I, typename T>
+    struct _indexed : _base<T>
+    {
+    };
+
+    template <typename Indexes, typename... Ts>
+    struct _unique_check;
+
+    // Duplicates make the conversion to _base<T>* ambiguous.
+    template <std::size_t... Is, typename... Ts>
+    struct _unique_check<std::index_sequence<Is...>, Ts...>
+    {
+      struct _impl : _indexed<Is, Ts>...
+      {
+      };
+
+      static constexpr bool value = (true && ... && std::is_convertible_v<_impl*, _base<Ts>*>);
+    };
+
+    template <typename... Ts>
+    constexpr auto _are_unique_v = _unique_check<std::index_sequence_for<Ts...>, Ts...>::value;
   }
 
   template <typename... Ts>
   constexpr auto type_set()
   {
-    return (detail::_type_set<>{} << ... << detail::_base<Ts>{});
+    if constexpr (detail::_are_unique_v<Ts...>)
+    {
+      return detail::_type_set<Ts...>{};
+    }
+    else
+    {
+      return (detail::_type_set<>{} << ... << detail::_base<Ts>{});
+    }
   }
 
   template <typename T, typename... Ts>
   constexpr auto type_set(const T&, const Ts&...)
   {
-    return (detail::_type_set<T>{} << ... << detail::_base<Ts>{});
+    return type_set<T, Ts...>();
   }
 
+  namespace detail
+  {
+    template <typename... Ts>
+    [[nodiscard]] constexpr auto _make_type_set(_type_set<Ts...>)
+    {
+      return type_set<Ts...>();
+    }
+  }  // namespace detail
+
   template <template <typename> typename Condition, typename... Ts>
   constexpr auto type_set_if()
   {
-    return (detail::_type_set<>{} | ... |
-            std::conditional_t<Condition<Ts>::value, detail::_type_set<Ts>, detail::_type_set<>>{});
+    return detail::_make_type_set(
+        detail::_join_t<std::conditional_t<Condition<Ts>::value, detail::_type_set<Ts>, detail::_type_set<>>...>{});
   }
 
   template <template <typename> typename Transform, typename... Ts>
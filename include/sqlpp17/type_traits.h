@@ -753,6 +753,87 @@ namespace sqlpp
   template <typename T>
   constexpr auto char_sequence_of_v = char_sequence_of_t<T>{};
 
+  // Compile-time identity of a name.
+  // Unlike char_sequence, this does not require one template argument per character.
+  template <std::uint32_t Hash>
+  struct name_hash_t
+  {
+  };
+
+  template <typename T>
+  struct name_hash_of
+  {
+    static_assert(not std::is_same_v<name_tag_of_t<T>, none_t>, "Invalid use of name_hash_of");
+    using type = name_hash_t<djb2_hash(name_tag_of_t<T>::name)>;
+  };
+
+  template <typename T>
+  using name_hash_of_t = typename name_hash_of<T>::type;
+
+  template <typename L, typename R>
+  [[nodiscard]] constexpr auto have_same_name() -> bool
+  {
+    if constexpr (std::is_same_v<name_hash_of_t<L>, name_hash_of_t<R>>)
+    {
+      // Make sure that this is not a hash collision
+      return name_tag_of_t<L>::name.compare(name_tag_of_t<R>::name) == 0;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  namespace detail
+  {
+    template <typename T, typename... Ts>
+    [[nodiscard]] constexpr auto name_occurs_in() -> bool
+    {
+      return (false || ... || have_same_name<T, Ts>());
+    }
+
+    template <typename T, typename... Ts>
+    [[nodiscard]] constexpr auto names_are_unique_by_comparison() -> bool
+    {
+      if constexpr (sizeof...(Ts) == 0)
+      {
+        return true;
+      }
+      else
+      {
+        return not name_occurs_in<T, Ts...>() and names_are_unique_by_comparison<Ts...>();
+      }
+    }
+  }  // namespace detail
+
+  template <typename... Ts>
+  [[nodiscard]] constexpr auto names_are_unique() -> bool
+  {
+    if constexpr (type_set<name_hash_of_t<Ts>...>().size() == sizeof...(Ts))
+    {
+      return true;
+    }
+    else
+    {
+      // Either there are duplicate names or there is a hash collision
+      return detail::names_are_unique_by_comparison<Ts...>();
+    }
+  }
+
+  // Name tag sets, e.g. table_names_of_v, are compared by hash first, then by the names of colliding hashes
+  template <typename... Ls, typename... Rs>
+  [[nodiscard]] constexpr auto names_are_disjoint(detail::_type_set<Ls...>, detail::_type_set<Rs...>) -> bool
+  {
+    if constexpr (type_set<name_hash_of_t<Ls>...>().is_disjoint_from(type_set<name_hash_of_t<Rs>...>()))
+    {
+      return true;
+    }
+    else
+    {
+      return (true && ... && not detail::name_occurs_in<Ls, Rs...>());
+    }
+  }
+
   template <typename T>
   struct is_selectable : std::integral_constant<bool,
                                                 not std::is_same_v<value_type_of_t<T>, none_t> and
@@ -0,0 +1,162 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sqlpp17/embrace.h>
+#include <sqlpp17/to_sql_string.h>
+#include <sqlpp17/type_traits.h>
+
+namespace sqlpp
+{
+  // Values of a range that is only known at runtime, e.g. the ids passed to col.in(ids)
+  template <typename T>
+  struct value_list_t
+  {
+    std::vector<T> values;
+  };
+
+  template <typename T>
+  struct value_type_of<value_list_t<T>>
+  {
+    using type = T;
+  };
+
+  namespace detail
+  {
+    template <typename Range, typename Enable = void>
+    struct range_value
+    {
+    };
+
+    template <typename Range>
+    struct range_value<Range,
+                       std::void_t<decltype(std::begin(std::declval<const Range&>())),
+                                   decltype(std::end(std::declval<const Range&>()))>>
+    {
+      using type = std::decay_t<decltype(*std::begin(std::declval<const Range&>()))>;
+    };
+
+    template <typename L, typename Range, typename Enable = void>
+    constexpr auto is_value_range_of_v = false;
+
+    // Strings are values, not ranges of characters
+    template <typename L, typename Range>
+    constexpr auto is_value_range_of_v<L, Range, std::void_t<typename range_value<Range>::type>> =
+        not is_text_v<Range> and not is_optional_v<typename range_value<Range>::type> and
+        values_are_compatible_v<L, typename range_value<Range>::type>;
+  }  // namespace detail
+
+  template <typename Range>
+  using range_value_t = typename detail::range_value<Range>::type;
+
+  template <typename L, typename Range>
+  constexpr auto is_value_range_of_v = detail::is_value_range_of_v<L, Range>;
+
+  template <typename Range>
+  [[nodiscard]] auto make_value_list(Range range)
+  {
+    using T = range_value_t<Range>;
+    if constexpr (std::is_same_v<Range, std::vector<T>>)
+    {
+      return value_list_t<T>{std::move(range)};
+    }
+    else
+    {
+      return value_list_t<T>{std::vector<T>(std::begin(range), std::end(range))};
+    }
+  }
+
+  namespace detail
+  {
+    // Lists are padded to one of these sizes by repeating their last value, and longer lists are split into chunks
+    // of the largest size. The number of distinct SQL texts (and thus prepared statements and plans) stays small,
+    // in particular with parameterized literals, see literal_parameters.h.
+    constexpr auto value_list_bucket_sizes = std::array<std::size_t, 11>{1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024};
+
+    [[nodiscard]] inline auto value_list_bucket_size(std::size_t size) -> std::size_t
+    {
+      for (const auto bucket_size : value_list_bucket_sizes)
+      {
+        if (size <= bucket_size)
+        {
+          return bucket_size;
+        }
+      }
+      return value_list_bucket_sizes.back();
+    }
+
+    // Serializes l IN(...) as a disjunction of chunks, or l NOT IN(...) as a conjunction of chunks.
+    // An empty list is never matched by IN and always matched by NOT IN.
+    template <typename Context, typename L, typename T>
+    [[nodiscard]] auto value_list_to_sql_string(Context& context,
+                                                const L& l,
+                                                const value_list_t<T>& list,
+                                                std::string_view in,
+                                                std::string_view junction,
+                                                std::string_view empty) -> std::string
+    {
+      const auto& values = list.values;
+      if (values.empty())
+      {
+        return std::string{empty};
+      }
+
+      auto ret = std::string{};
+      for (std::size_t chunk = 0; chunk < values.size(); chunk += value_list_bucket_sizes.back())
+      {
+        const auto size = std::min(values.size() - chunk, value_list_bucket_sizes.back());
+        if (chunk > 0)
+        {
+          ret += junction;
+        }
+        ret += to_sql_string(context, embrace(l));
+        ret += in;
+        const auto bucket_size = value_list_bucket_size(size);
+        for (std::size_t i = 0; i < bucket_size; ++i)
+        {
+          if (i > 0)
+          {
+            ret += ", ";
+          }
+          ret += to_sql_string(context, values[chunk + std::min(i, size - 1)]);
+        }
+        ret += ")";
+      }
+      return ret;
+    }
+  }  // namespace detail
+}  // namespace sqlpp
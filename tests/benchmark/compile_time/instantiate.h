@@ -0,0 +1,52 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <utility>
+
+#include <sqlpp17_test/mock_db.h>
+
+#ifndef SQLPP17_COMPILE_TIME_STATEMENTS
+#define SQLPP17_COMPILE_TIME_STATEMENTS 20
+#endif
+
+namespace bench
+{
+  // Checks, executes (i.e. serializes) and prepares one statement per index
+  template <template <int> typename Shape, int... Is>
+  auto instantiate(std::integer_sequence<int, Is...>) -> void
+  {
+    auto db = ::sqlpp::test::mock_db{};
+    (..., (db(Shape<Is>::make()), db.prepare(Shape<Is>::make())));
+  }
+
+  template <template <int> typename Shape>
+  auto instantiate() -> void
+  {
+    instantiate<Shape>(std::make_integer_sequence<int, SQLPP17_COMPILE_TIME_STATEMENTS>{});
+  }
+}  // namespace bench
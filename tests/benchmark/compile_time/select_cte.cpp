@@ -0,0 +1,52 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/clause/with.h>
+#include <sqlpp17/cte.h>
+#include <sqlpp17/name_tag.h>
+#include <sqlpp17/operator.h>
+
+#include "instantiate.h"
+#include "tables.h"
+
+SQLPP_CREATE_NAME_TAG(preferred);
+
+template <int I>
+struct select_cte
+{
+  static auto make()
+  {
+    constexpr auto c = bench::tabCustomer<I>;
+    const auto p = cte(preferred).as(sqlpp::select(all_of(c)).from(c).where(c.isPreferredCustomer));
+    return sqlpp::with(p) << sqlpp::select(p.id, p.customerName, p.billingAddressFirstLine).from(p).unconditionally();
+  }
+};
+
+int main()
+{
+  bench::instantiate<select_cte>();
+}
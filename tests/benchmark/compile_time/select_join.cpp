@@ -0,0 +1,52 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/join.h>
+#include <sqlpp17/operator.h>
+
+#include "instantiate.h"
+#include "tables.h"
+
+template <int I>
+struct select_join
+{
+  static auto make()
+  {
+    constexpr auto c = bench::tabCustomer<I>;
+    constexpr auto o = bench::tabOrder<I>;
+    return sqlpp::select(c.id, c.customerName, c.billingAddressFirstLine, o.totalAmountInCents, o.shippingInstructions)
+        .from(c.join(o).on(c.id == o.customerId))
+        .where(c.isPreferredCustomer and o.totalAmountInCents > 10000 and c.customerName.like("A%"))
+        .order_by(asc(c.customerName), desc(o.totalAmountInCents))
+        .limit(100);
+  }
+};
+
+int main()
+{
+  bench::instantiate<select_join>();
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <string_view>
+
+#include <sqlpp17/data_types.h>
+#include <sqlpp17/name_tag.h>
+#include <sqlpp17/table.h>
+
+// Tables for compile time measurements.
+// Each index yields a distinct set of types, so that each statement is instantiated from scratch.
+namespace bench
+{
+  template <int Index>
+  struct TabCustomer : public ::sqlpp::spec_base
+  {
+    struct Id : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(id, id);
+      using value_type = std::int64_t;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = ::sqlpp::auto_increment_t{};
+    };
+
+    struct CustomerName : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(customer_name, customerName);
+      using value_type = ::sqlpp::varchar<255>;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = ::sqlpp::none_t{};
+    };
+
+    struct BillingAddressFirstLine : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(billing_address_first_line, billingAddressFirstLine);
+      using value_type = ::sqlpp::varchar<255>;
+      static constexpr auto can_be_null = true;
+      static constexpr auto default_value = ::sqlpp::none_t{};
+    };
+
+    struct IsPreferredCustomer : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(is_preferred_customer, isPreferredCustomer);
+      using value_type = bool;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = false;
+    };
+
+    using _columns = ::sqlpp::type_vector<Id, CustomerName, BillingAddressFirstLine, IsPreferredCustomer>;
+
+    SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(tab_customer, tabCustomer);
+    using primary_key = Id;
+  };
+
+  template <int Index>
+  struct TabOrder : public ::sqlpp::spec_base
+  {
+    struct Id : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(id, id);
+      using value_type = std::int64_t;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = ::sqlpp::auto_increment_t{};
+    };
+
+    struct CustomerId : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(customer_id, customerId);
+      using value_type = std::int64_t;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = ::sqlpp::none_t{};
+    };
+
+    struct TotalAmountInCents : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(total_amount_in_cents, totalAmountInCents);
+      using value_type = std::int64_t;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = 0;
+    };
+
+    struct ShippingInstructions : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(shipping_instructions, shippingInstructions);
+      using value_type = ::sqlpp::varchar<255>;
+      static constexpr auto can_be_null = true;
+      static constexpr auto default_value = ::sqlpp::none_t{};
+    };
+
+    using _columns = ::sqlpp::type_vector<Id, CustomerId, TotalAmountInCents, ShippingInstructions>;
+
+    SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(tab_order, tabOrder);
+    using primary_key = Id;
+  };
+
+  template <int Index>
+  inline constexpr auto tabCustomer = sqlpp::table_t<TabCustomer<Index>>{};
+
+  template <int Index>
+  inline constexpr auto tabOrder = sqlpp::table_t<TabOrder<Index>>{};
+}  // namespace bench
@@ -0,0 +1,144 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sqlpp::test::benchmark
+{
+  // Updated by the replacement operator new in sqlpp17_test/benchmark/allocation_counter.h
+  inline std::atomic<std::size_t> allocation_count = 0;
+  inline std::atomic<std::size_t> allocated_bytes = 0;
+
+  struct measurement
+  {
+    std::string name;
+    std::size_t iterations = 0;
+    double ns_per_statement = 0;
+    double allocations_per_statement = 0;
+    double bytes_allocated_per_statement = 0;
+    std::size_t sql_size = 0;
+  };
+
+  struct options
+  {
+    std::size_t iterations = 10000;
+    bool json = false;
+  };
+
+  inline auto parse_options(int argc, char** argv) -> options
+  {
+    auto opts = options{};
+    for (auto i = 1; i < argc; ++i)
+    {
+      const auto arg = std::string_view{argv[i]};
+      if (arg.compare("--json") == 0)
+      {
+        opts.json = true;
+      }
+      else if (arg.compare("--iterations") == 0 and i + 1 < argc)
+      {
+        opts.iterations = std::strtoull(argv[++i], nullptr, 10);
+      }
+      else
+      {
+        std::cerr << "Usage: " << argv[0] << " [--iterations N] [--json]\n";
+        std::exit(1);
+      }
+    }
+    return opts;
+  }
+
+  // Serializes the statement `iterations` times with a fresh Context each time.
+  template <typename Context, typename Statement>
+  auto measure_serialization(std::string name, const Statement& statement, std::size_t iterations) -> measurement
+  {
+    // Warm-up, also yields the size of the statement
+    const auto sql_size = to_sql_string_c(Context{}, statement).size();
+
+    auto checksum = std::size_t{};
+    const auto allocations_before = allocation_count.load();
+    const auto bytes_before = allocated_bytes.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = std::size_t{}; i < iterations; ++i)
+    {
+      checksum += to_sql_string_c(Context{}, statement).size();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const auto allocations = allocation_count.load() - allocations_before;
+    const auto bytes = allocated_bytes.load() - bytes_before;
+
+    if (checksum != sql_size * iterations)
+    {
+      throw std::logic_error("Serialization of " + name + " is not deterministic");
+    }
+
+    const auto n = static_cast<double>(iterations ? iterations : 1);
+    return {std::move(name),
+            iterations,
+            std::chrono::duration<double, std::nano>(end - start).count() / n,
+            allocations / n,
+            bytes / n,
+            sql_size};
+  }
+
+  inline auto report(std::ostream& os, std::string_view suite, const options& opts, const std::vector<measurement>& ms)
+      -> void
+  {
+    if (opts.json)
+    {
+      os << "{\"suite\": \"" << suite << "\", \"iterations\": " << opts.iterations << ", \"benchmarks\": [";
+      auto separator = "";
+      for (const auto& m : ms)
+      {
+        os << separator << "\n  {\"name\": \"" << m.name << "\", \"ns_per_statement\": " << m.ns_per_statement
+           << ", \"allocations_per_statement\": " << m.allocations_per_statement
+           << ", \"bytes_allocated_per_statement\": " << m.bytes_allocated_per_statement
+           << ", \"sql_size\": " << m.sql_size << "}";
+        separator = ",";
+      }
+      os << "\n]}\n";
+    }
+    else
+    {
+      os << suite << " (" << opts.iterations << " iterations)\n";
+      for (const auto& m : ms)
+      {
+        os << "  " << m.name << ": " << m.ns_per_statement << " ns/statement, " << m.allocations_per_statement
+           << " allocations/statement, " << m.bytes_allocated_per_statement << " bytes/statement, " << m.sql_size
+           << " bytes of SQL\n";
+      }
+    }
+  }
+}  // namespace sqlpp::test::benchmark
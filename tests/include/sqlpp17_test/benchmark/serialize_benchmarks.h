@@ -0,0 +1,132 @@
+#pragma once
+
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/clause/with.h>
+#include <sqlpp17/cte.h>
+#include <sqlpp17/join.h>
+#include <sqlpp17/name_tag.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17_test/benchmark/harness.h>
+#include <sqlpp17_test/tables/TabDepartment.h>
+#include <sqlpp17_test/tables/TabFloat.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+namespace sqlpp::test::benchmark
+{
+  SQLPP_CREATE_NAME_TAG(managers);
+
+  // Representative statements, serialized with the given Context
+  template <typename Context>
+  auto serialize_benchmarks(const options& opts) -> std::vector<measurement>
+  {
+    using ::test::tabDepartment;
+    using ::test::tabFloat;
+    using ::test::tabPerson;
+
+    auto ms = std::vector<measurement>{};
+
+    ms.push_back(measure_serialization<Context>(
+        "select_join",
+        select(tabPerson.id, tabPerson.name, tabPerson.address, tabDepartment.division)
+            .from(tabPerson.join(tabDepartment).on(tabPerson.id == tabDepartment.id))
+            .where(tabPerson.isManager and tabPerson.name.like("A%") and tabDepartment.division != "sales")
+            .order_by(asc(tabPerson.name))
+            .limit(100),
+        opts.iterations));
+
+    {
+      const auto cte_managers = cte(managers).as(select(all_of(tabPerson)).from(tabPerson).where(tabPerson.isManager));
+      ms.push_back(measure_serialization<Context>(
+          "select_cte",
+          with(cte_managers) << select(cte_managers.id, cte_managers.name).from(cte_managers).unconditionally(),
+          opts.iterations));
+    }
+
+    ms.push_back(measure_serialization<Context>(
+        "select_in_list",
+        select(tabPerson.id, tabPerson.name)
+            .from(tabPerson)
+            .where(in(tabPerson.id, 1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144, 233, 377, 610, 987, 1597)),
+        opts.iterations));
+
+    {
+      auto rows = std::vector<std::tuple<decltype(tabPerson.isManager = true), decltype(tabPerson.name = ""),
+                                         decltype(tabPerson.address = "")>>{};
+      for (auto i = 0; i < 100; ++i)
+      {
+        rows.emplace_back(tabPerson.isManager = (i % 7 == 0), tabPerson.name = "Mr. C++",
+                          tabPerson.address = "Sample Address");
+      }
+      ms.push_back(
+          measure_serialization<Context>("insert_multi_row_100", insert_into(tabPerson).multiset(rows), opts.iterations));
+    }
+
+    {
+      auto rows = std::vector<std::tuple<decltype(tabFloat.valueFloat = 0.f), decltype(tabFloat.valueDouble = 0.)>>{};
+      for (auto i = 0; i < 100; ++i)
+      {
+        rows.emplace_back(tabFloat.valueFloat = 1.f / (i + 3), tabFloat.valueDouble = 1. / (i + 3));
+      }
+      ms.push_back(measure_serialization<Context>("insert_multi_row_float_100", insert_into(tabFloat).multiset(rows),
+                                                  opts.iterations));
+    }
+
+    {
+      // KB-sized text values, with and without characters that need escaping
+      const auto plain = std::string(4096, 'x');
+      auto quoted = plain;
+      for (auto i = std::size_t{}; i < quoted.size(); i += 512)
+      {
+        quoted[i] = '\'';
+      }
+      ms.push_back(measure_serialization<Context>(
+          "insert_text_4k",
+          insert_into(tabPerson).set(tabPerson.isManager = false, tabPerson.name = std::string_view{plain}),
+          opts.iterations));
+      ms.push_back(measure_serialization<Context>(
+          "insert_text_4k_quoted",
+          insert_into(tabPerson).set(tabPerson.isManager = false, tabPerson.name = std::string_view{quoted}),
+          opts.iterations));
+    }
+
+    ms.push_back(measure_serialization<Context>(
+        "update",
+        update(tabPerson).set(tabPerson.name = "Mr. CEO", tabPerson.isManager = true).where(tabPerson.id == 17),
+        opts.iterations));
+
+    return ms;
+  }
+}  // namespace sqlpp::test::benchmark
@@ -27,6 +27,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <cfloat>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -176,7 +176,7 @@ namespace sqlpp::test
       }
     }
 
-    auto start_transaction() -> void
+    auto start_transaction([[maybe_unused]] const ::sqlpp::transaction_options& options = {}) -> void
     {
     }
 
@@ -0,0 +1,70 @@
+/*
+Copyright (c) 2016 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <sqlpp17/clause/bulk_update.h>
+
+#include <sqlpp17_test/mock_db.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+#include "assert_equality.h"
+
+using ::sqlpp::test::assert_equality;
+using ::sqlpp::test::mock_context_t;
+using ::test::tabPerson;
+
+int main()
+{
+  const auto bulk = bulk_update(tabPerson, tabPerson.id, tabPerson.name, tabPerson.address)
+                        .rows(std::vector{std::tuple{1, std::string("Ada"), std::optional<std::string>{"London"}},
+                                          std::tuple{2, std::string("Bjarne"), std::optional<std::string>{}}});
+
+  // one CASE expression per column
+  assert_equality("UPDATE tab_person SET "
+                  "name = CASE tab_person.id WHEN 1 THEN 'Ada' WHEN 2 THEN 'Bjarne' ELSE tab_person.name END, "
+                  "address = CASE tab_person.id WHEN 1 THEN 'London' WHEN 2 THEN NULL ELSE tab_person.address END "
+                  "WHERE tab_person.id IN (1, 2)",
+                  to_sql_string_c(mock_context_t{}, bulk));
+
+  // chunks
+  const auto chunks = bulk.chunks(1);
+  assert_equality("2", std::to_string(chunks.size()));
+  assert_equality("UPDATE tab_person SET "
+                  "name = CASE tab_person.id WHEN 2 THEN 'Bjarne' ELSE tab_person.name END, "
+                  "address = CASE tab_person.id WHEN 2 THEN NULL ELSE tab_person.address END "
+                  "WHERE tab_person.id IN (2)",
+                  to_sql_string_c(mock_context_t{}, chunks.back()));
+  assert_equality("1", std::to_string(bulk.chunks(1000).size()));
+
+  // without rows
+  assert_equality("UPDATE tab_person SET id = id WHERE 1 = 0",
+                  to_sql_string_c(mock_context_t{}, bulk_update(tabPerson, tabPerson.id, tabPerson.isManager)
+                                                        .rows(std::vector<std::tuple<int, bool>>{})));
+}
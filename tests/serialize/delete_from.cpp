@@ -48,6 +48,9 @@ int main()
                     to_sql_string_c(mock_context_t{}, delete_from(tabPerson).where(tabPerson.name.like("%bar"))));
     assert_equality("DELETE FROM tab_person WHERE tab_person.name LIKE '%bar'",
                     to_sql_string_c(mock_context_t{}, delete_from(tabPerson) << where(tabPerson.name.like("%bar"))));
+    assert_equality("DELETE FROM tab_person WHERE tab_person.id = 7 RETURNING tab_person.name",
+                    to_sql_string_c(mock_context_t{},
+                                    delete_from(tabPerson).where(tabPerson.id == 7).returning(tabPerson.name)));
   }
   catch (const std::exception& e)
   {
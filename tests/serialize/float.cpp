@@ -35,6 +35,22 @@ using ::sqlpp::test::mock_context_t;
 
 namespace
 {
+  template <typename T>
+  auto test_round_trip(const T& t)
+  {
+    const auto s = to_sql_string_c(mock_context_t{}, t);
+    const auto parsed = [&s]() {
+      if constexpr (std::is_same_v<T, float>)
+        return std::strtof(s.c_str(), nullptr);
+      else
+        return std::strtod(s.c_str(), nullptr);
+    }();
+    if (parsed != t)
+    {
+      throw std::logic_error("round trip failed for " + s);
+    }
+  }
+
   template <typename T>
   auto test_nan(const T& t)
   {
@@ -71,6 +87,27 @@ int main()
     assert_equality("0.1234567", to_sql_string_c(mock_context_t{}, 0.1234567890123456789f).substr(0, 9));
     assert_equality("0.123456789012345", to_sql_string_c(mock_context_t{}, 0.1234567890123456789).substr(0, 17));
 
+    // shortest representation
+    assert_equality("0.1", to_sql_string_c(mock_context_t{}, 0.1f));
+    assert_equality("0.1", to_sql_string_c(mock_context_t{}, 0.1));
+    assert_equality("0", to_sql_string_c(mock_context_t{}, 0.0));
+    assert_equality("-1.5", to_sql_string_c(mock_context_t{}, -1.5));
+    assert_equality("1e+23", to_sql_string_c(mock_context_t{}, 1e23));
+
+    // exact round trip
+    for (const auto f : {0.1f, 1.f / 3.f, 16777217.f, std::numeric_limits<float>::min(),
+                         std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min()})
+    {
+      test_round_trip(f);
+      test_round_trip(-f);
+    }
+    for (const auto d : {0.1, 1. / 3., 9007199254740993., 5e-324, std::numeric_limits<double>::min(),
+                         std::numeric_limits<double>::max(), 0.1234567890123456789})
+    {
+      test_round_trip(d);
+      test_round_trip(-d);
+    }
+
     if constexpr (std::numeric_limits<float>::is_iec559)
     {
       test_nan(std::nanf(""));
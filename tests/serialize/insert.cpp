@@ -31,6 +31,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sqlpp17_test/tables/TabDepartment.h>
 #include <sqlpp17_test/tables/TabEmpty.h>
 #include <sqlpp17_test/tables/TabPerson.h>
+#include <sqlpp17_test/tables/TabSetting.h>
 
 #include "assert_equality.h"
 
@@ -38,6 +39,7 @@ using ::sqlpp::test::assert_equality;
 using ::sqlpp::test::mock_context_t;
 using test::tabDepartment;
 using test::tabPerson;
+using test::tabSetting;
 
 static_assert(::sqlpp::required_insert_columns_of_f(tabDepartment) == ::sqlpp::type_set());
 static_assert(::sqlpp::required_insert_columns_of_f(tabPerson) ==
@@ -114,4 +116,48 @@ int main()
                           std::tuple{tabPerson.isManager = true, tabPerson.name = "Mr. CEO",
                                      true ? std::make_optional(tabPerson.address = "Sample Address") : std::nullopt,
                                      true ? std::make_optional(tabPerson.language = "Python") : std::nullopt}})));
+
+  // RETURNING turns the insert into a statement with a result
+  assert_equality("INSERT INTO tab_department (name) VALUES ('Engineering') RETURNING tab_department.id",
+                  to_sql_string_c(mock_context_t{}, insert_into(tabDepartment)
+                                                        .set(tabDepartment.name = "Engineering")
+                                                        .returning(tabDepartment.id)));
+  static_assert(std::is_same_v<::sqlpp::result_type_of_t<decltype(
+                                   insert_into(tabDepartment).default_values().returning(tabDepartment.id))>,
+                               ::sqlpp::select_result>);
+
+  // Upserts
+  assert_equality("INSERT INTO tab_setting (name, value) VALUES ('theme', 'dark') ON CONFLICT (name) DO NOTHING",
+                  to_sql_string_c(mock_context_t{}, insert_into(tabSetting)
+                                                        .set(tabSetting.name = "theme", tabSetting.value = "dark")
+                                                        .on_conflict(tabSetting.name)
+                                                        .do_nothing()));
+  assert_equality("INSERT INTO tab_setting (name) VALUES ('theme') ON CONFLICT DO NOTHING",
+                  to_sql_string_c(mock_context_t{},
+                                  insert_into(tabSetting).set(tabSetting.name = "theme").on_conflict().do_nothing()));
+  assert_equality("INSERT INTO tab_setting (name, value) VALUES ('theme', 'dark') ON CONFLICT (name) "
+                  "DO UPDATE SET value = excluded.value, revision = 7",
+                  to_sql_string_c(mock_context_t{},
+                                  insert_into(tabSetting)
+                                      .set(tabSetting.name = "theme", tabSetting.value = "dark")
+                                      .on_conflict(tabSetting.name)
+                                      .do_update(tabSetting.value = ::sqlpp::excluded(tabSetting.value),
+                                                 tabSetting.revision = 7)));
+  assert_equality("INSERT INTO tab_setting (name, value) VALUES ('theme', 'dark'), ('font', 'mono') "
+                  "ON CONFLICT (name) DO UPDATE SET value = excluded.value RETURNING tab_setting.revision",
+                  to_sql_string_c(mock_context_t{},
+                                  insert_into(tabSetting)
+                                      .multiset(std::vector{
+                                          std::tuple{tabSetting.name = "theme", tabSetting.value = "dark"},
+                                          std::tuple{tabSetting.name = "font", tabSetting.value = "mono"}})
+                                      .on_conflict(tabSetting.name)
+                                      .do_update(tabSetting.value = ::sqlpp::excluded(tabSetting.value))
+                                      .returning(tabSetting.revision)));
+  assert_equality("INSERT INTO tab_setting (name, value) VALUES ('theme', 'dark') "
+                  "ON DUPLICATE KEY UPDATE value = excluded.value",
+                  to_sql_string_c(mock_context_t{},
+                                  insert_into(tabSetting)
+                                      .set(tabSetting.name = "theme", tabSetting.value = "dark")
+                                      .on_duplicate_key_update(
+                                          tabSetting.value = ::sqlpp::excluded(tabSetting.value))));
 }
@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2016 - 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/clause/select.h>
+#include <sqlpp17/clause/update.h>
+#include <sqlpp17/literal_parameters.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17_test/mock_db.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+
+#include "assert_equality.h"
+
+using ::sqlpp::test::assert_equality;
+using ::sqlpp::test::mock_context_t;
+using ::test::tabPerson;
+
+namespace test
+{
+  struct count_context_t : public ::sqlpp::context_base
+  {
+    int parameter_index = 0;
+  };
+}  // namespace test
+
+namespace sqlpp
+{
+  template <typename ValueType, typename NameTag>
+  [[nodiscard]] auto to_sql_string(::test::count_context_t& context, const parameter_t<ValueType, NameTag>&)
+  {
+    return "$" + std::to_string(++context.parameter_index);
+  }
+}  // namespace sqlpp
+
+namespace
+{
+  auto assert_literals(const std::vector<::sqlpp::literal_value>& expected,
+                       const std::vector<::sqlpp::literal_value>& received) -> void
+  {
+    if (expected.size() != received.size())
+    {
+      throw std::runtime_error("Unexpected number of literals: " + std::to_string(received.size()));
+    }
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      if (not(expected[i] == received[i]))
+      {
+        throw std::runtime_error("Unexpected literal at " + std::to_string(i));
+      }
+    }
+  }
+}  // namespace
+
+int main()
+{
+  try
+  {
+    {
+      const auto parameterized = ::sqlpp::parameterize<mock_context_t>(
+          update(tabPerson).set(tabPerson.isManager = true).where(tabPerson.name == "it's"));
+      assert_equality("UPDATE tab_person SET is_manager = ? WHERE tab_person.name = ?", parameterized.sql);
+      assert_literals({true, std::string("it's")}, parameterized.literals);
+    }
+
+    // The SQL text depends on the shape of the statement only
+    {
+      const auto parameterized = ::sqlpp::parameterize<::test::count_context_t>(insert_into(tabPerson).set(
+          tabPerson.isManager = false, tabPerson.name = "a", tabPerson.address = std::nullopt));
+      assert_equality("INSERT INTO tab_person (is_manager, name, address) VALUES ($1, $2, NULL)", parameterized.sql);
+      assert_literals({false, std::string("a")}, parameterized.literals);
+    }
+
+    {
+      const auto parameterized = ::sqlpp::parameterize<::test::count_context_t>(
+          select(tabPerson.id).from(tabPerson).where(tabPerson.id > 7u and tabPerson.id < 2.5));
+      assert_equality("SELECT tab_person.id FROM tab_person WHERE (tab_person.id > $1) AND (tab_person.id < $2)",
+                      parameterized.sql);
+      assert_literals({std::int64_t{7}, 2.5}, parameterized.literals);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+}
@@ -24,6 +24,10 @@ ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
+#include <list>
+#include <string>
+#include <vector>
+
 #include <sqlpp17/operator.h>
 #include <sqlpp17/value.h>
 
@@ -76,6 +80,30 @@ int main()
     assert_equality("'Herb' != tab_person.name", "Herb" != tabPerson.name);
     assert_equality("'Herb' LIKE tab_person.name", like("Herb", tabPerson.name));
 
+    assert_equality("tab_person.id IN(17)", in(tabPerson.id, 17));
+    assert_equality("tab_person.id IN(17, 18, 19)", in(tabPerson.id, 17, 18, 19));
+    assert_equality("tab_person.id NOT IN(17)", not_in(tabPerson.id, 17));
+    assert_equality("tab_person.id NOT IN(17, 18, 19)", not_in(tabPerson.id, 17, 18, 19));
+
+    // Runtime sized lists are padded to bucket sizes by repeating their last value
+    assert_equality("tab_person.id IN(17)", tabPerson.id.in(std::vector<int>{17}));
+    assert_equality("tab_person.id IN(17, 18, 19, 19)", tabPerson.id.in(std::vector<int>{17, 18, 19}));
+    assert_equality("tab_person.id NOT IN(17, 18)", tabPerson.id.not_in(std::list<int>{17, 18}));
+    assert_equality("tab_person.name IN('a', 'b')", in(tabPerson.name, std::vector<std::string>{"a", "b"}));
+    assert_equality("1 = 0", tabPerson.id.in(std::vector<int>{}));
+    assert_equality("1 = 1", tabPerson.id.not_in(std::vector<int>{}));
+    {
+      auto ids = std::vector<int>(1025, 17);
+      ids.back() = 18;
+      auto expected = std::string{"tab_person.id IN("};
+      for (auto i = 0; i < 1024; ++i)
+      {
+        expected += i ? ", 17" : "17";
+      }
+      expected += ") OR tab_person.id IN(18)";
+      assert_equality(expected, tabPerson.id.in(ids));
+    }
+
     // Arithmetic
     assert_equality("tab_person.id / 17", tabPerson.id / 17);
     assert_equality("tab_person.id - 17", tabPerson.id - 17);
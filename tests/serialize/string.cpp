@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sqlpp17/value.h>
+
+#include "assert_equality.h"
+
+using ::sqlpp::test::assert_equality;
+
+int main()
+{
+  try
+  {
+    assert_equality("''", sqlpp::value(""));
+    assert_equality("'Herb'", sqlpp::value("Herb"));
+    assert_equality("'Herb''s'", sqlpp::value("Herb's"));
+    assert_equality("''''''", sqlpp::value("''"));
+    assert_equality("'back\\slash \"double\"'", sqlpp::value("back\\slash \"double\""));
+
+    // Quotes at and around the block boundaries of the vectorized search
+    for (const auto length : {15, 16, 17, 31, 32, 33, 1000})
+    {
+      for (const auto position : {0, 1, length / 2, length - 1})
+      {
+        auto text = std::string(length, 'x');
+        text[position] = '\'';
+        auto expected = std::string(length + 1, 'x');
+        expected[position] = '\'';
+        expected[position + 1] = '\'';
+        assert_equality("'" + expected + "'", sqlpp::value(text));
+      }
+    }
+
+    // No quotes at all
+    const auto text = std::string(4096, 'x');
+    assert_equality("'" + text + "'", sqlpp::value(text));
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+  }
+}
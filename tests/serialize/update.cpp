@@ -71,4 +71,16 @@ int main()
                   "WHERE tab_person.is_manager = 0",
                   to_sql_string_c(mock_context_t{}, update(tabPerson) << update_set(tabPerson.isManager = true)
                                                                       << where(tabPerson.isManager == false)));
+
+  // returning
+  assert_equality("UPDATE tab_person SET is_manager = 1 WHERE tab_person.id = 7 "
+                  "RETURNING tab_person.id, tab_person.name",
+                  to_sql_string_c(mock_context_t{}, update(tabPerson)
+                                                        .set(tabPerson.isManager = true)
+                                                        .where(tabPerson.id == 7)
+                                                        .returning(tabPerson.id, tabPerson.name)));
+  assert_equality("UPDATE tab_person SET is_manager = 1 RETURNING tab_person.id",
+                  to_sql_string_c(mock_context_t{}, update(tabPerson) << update_set(tabPerson.isManager = true)
+                                                                      << sqlpp::unconditionally()
+                                                                      << returning(tabPerson.id)));
 }
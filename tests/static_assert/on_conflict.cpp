@@ -0,0 +1,104 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <sqlpp17/clause/insert_into.h>
+#include <sqlpp17/operator.h>
+
+#include <sqlpp17_test/mock_db.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+#include <sqlpp17_test/tables/TabSetting.h>
+
+#include "assert_bad_expression.h"
+
+using ::sqlpp::test::assert_bad_expression;
+using ::sqlpp::test::assert_good_expression;
+
+// Turning off static_assert for on_conflict()
+namespace sqlpp
+{
+  template <typename... T>
+  constexpr auto wrong<assert_on_conflict_args_are_columns, T...> = true;
+
+  template <typename... T>
+  constexpr auto wrong<assert_on_conflict_args_contain_no_duplicates, T...> = true;
+
+  template <typename... T>
+  constexpr auto wrong<assert_on_conflict_do_update_has_target, T...> = true;
+
+  template <typename... T>
+  constexpr auto wrong<assert_on_conflict_update_args_are_assignments, T...> = true;
+
+  template <typename... T>
+  constexpr auto wrong<assert_on_conflict_update_assignments_are_allowed, T...> = true;
+
+  template <typename... T>
+  constexpr auto wrong<assert_on_conflict_has_action, T...> = true;
+
+  template <typename... T>
+  constexpr auto wrong<assert_on_conflict_target_is_primary_key, T...> = true;
+}  // namespace sqlpp
+
+int main()
+{
+  auto db = ::sqlpp::test::mock_db{};
+
+  const auto insert = insert_into(test::tabSetting).set(test::tabSetting.name = "theme");
+
+  // bad: conflict target is not a list of unique columns
+  assert_bad_expression(sqlpp::assert_on_conflict_args_are_columns{}, insert.on_conflict(1));
+  assert_bad_expression(sqlpp::assert_on_conflict_args_contain_no_duplicates{},
+                        insert.on_conflict(test::tabSetting.name, test::tabSetting.name));
+
+  // bad: do_update() requires a conflict target and assignments
+  assert_bad_expression(sqlpp::assert_on_conflict_do_update_has_target{},
+                        insert.on_conflict().do_update(test::tabSetting.revision = 1));
+  assert_bad_expression(sqlpp::assert_on_conflict_update_args_are_assignments{},
+                        insert.on_conflict(test::tabSetting.name).do_update(test::tabSetting.revision));
+  assert_bad_expression(sqlpp::assert_on_conflict_update_assignments_are_allowed{},
+                        insert_into(test::tabPerson)
+                            .set(test::tabPerson.isManager = true, test::tabPerson.name = "Sample Name")
+                            .on_duplicate_key_update(test::tabPerson.id = 1));
+
+  // bad: incomplete clause
+  assert_bad_expression(sqlpp::assert_on_conflict_has_action{},
+                        db.prepare(insert.on_conflict(test::tabSetting.name)));
+
+  // bad: conflict target is not the primary key
+  assert_bad_expression(sqlpp::assert_on_conflict_target_is_primary_key{},
+                        db.prepare(insert.on_conflict(test::tabSetting.value).do_nothing()));
+  assert_bad_expression(sqlpp::assert_on_conflict_target_is_primary_key{},
+                        db.prepare(insert.on_conflict(test::tabSetting.name, test::tabSetting.value)
+                                       .do_update(test::tabSetting.revision = 1)));
+
+  // good: conflict on the primary key
+  assert_good_expression(db.prepare(insert.on_conflict().do_nothing()));
+  assert_good_expression(db.prepare(insert.on_conflict(test::tabSetting.name).do_nothing()));
+  assert_good_expression(
+      db.prepare(insert.on_conflict(test::tabSetting.name)
+                     .do_update(test::tabSetting.value = ::sqlpp::excluded(test::tabSetting.value))));
+  assert_good_expression(
+      db.prepare(insert.on_duplicate_key_update(test::tabSetting.value = ::sqlpp::excluded(test::tabSetting.value))));
+}
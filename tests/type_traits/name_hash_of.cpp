@@ -0,0 +1,120 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <type_traits>
+
+#include <sqlpp17_test/tables/TabDepartment.h>
+#include <sqlpp17_test/tables/TabPerson.h>
+#include <sqlpp17/name_tag.h>
+
+SQLPP_CREATE_NAME_TAG(foo);
+SQLPP_CREATE_NAME_TAG(id);
+
+// djb2_hash("hetairas") == djb2_hash("mentioner")
+SQLPP_CREATE_NAME_TAG(hetairas);
+SQLPP_CREATE_NAME_TAG(mentioner);
+
+namespace test
+{
+  struct Hetairas : public ::sqlpp::spec_base
+  {
+    struct Id : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(id, id);
+      using value_type = std::int64_t;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = ::sqlpp::none_t{};
+    };
+
+    using _columns = ::sqlpp::type_vector<Id>;
+
+    SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(hetairas, hetairas);
+    using primary_key = ::sqlpp::none_t;
+  };
+
+  struct Mentioner : public ::sqlpp::spec_base
+  {
+    struct Id : public ::sqlpp::spec_base
+    {
+      SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(id, id);
+      using value_type = std::int64_t;
+      static constexpr auto can_be_null = false;
+      static constexpr auto default_value = ::sqlpp::none_t{};
+    };
+
+    using _columns = ::sqlpp::type_vector<Id>;
+
+    SQLPP_NAME_TAGS_FOR_SQL_AND_CPP(mentioner, mentioner);
+    using primary_key = ::sqlpp::none_t;
+  };
+
+  constexpr auto tabHetairas = ::sqlpp::table_t<Hetairas>{};
+  constexpr auto tabMentioner = ::sqlpp::table_t<Mentioner>{};
+}  // namespace test
+
+template <typename T>
+using name_hash_of_t = ::sqlpp::name_hash_of_t<T>;
+
+template <typename... Ts>
+constexpr auto names_are_unique(const Ts&...)
+{
+  return ::sqlpp::names_are_unique<Ts...>();
+}
+
+template <typename L, typename R>
+constexpr auto have_same_name(const L&, const R&)
+{
+  return ::sqlpp::have_same_name<L, R>();
+}
+
+// Names are identified by their text, not by their tag type
+static_assert(have_same_name(test::tabPerson.id, test::tabDepartment.id));
+static_assert(have_same_name(test::tabPerson.id, id));
+static_assert(have_same_name(test::tabPerson.name.as(foo), test::tabDepartment.id.as(foo)));
+static_assert(have_same_name(test::tabPerson.as(foo), foo));
+static_assert(!have_same_name(test::tabPerson.id, test::tabPerson.name));
+static_assert(!have_same_name(test::tabPerson, test::tabDepartment));
+static_assert(std::is_same_v<name_hash_of_t<decltype(test::tabPerson.id)>, name_hash_of_t<decltype(id)>>);
+
+// Uniqueness
+static_assert(names_are_unique());
+static_assert(names_are_unique(test::tabPerson.id));
+static_assert(names_are_unique(test::tabPerson.id, test::tabPerson.name, test::tabDepartment.division));
+static_assert(!names_are_unique(test::tabPerson.id, test::tabPerson.name, test::tabDepartment.id));
+static_assert(names_are_unique(test::tabPerson.id, test::tabDepartment.id.as(foo)));
+
+// Hash collisions are not mistaken for equal names
+static_assert(std::is_same_v<name_hash_of_t<decltype(hetairas)>, name_hash_of_t<decltype(mentioner)>>);
+static_assert(!have_same_name(hetairas, mentioner));
+static_assert(names_are_unique(hetairas, mentioner));
+static_assert(::sqlpp::names_are_disjoint(::sqlpp::table_names_of(test::tabHetairas),
+                                          ::sqlpp::table_names_of(test::tabMentioner)));
+static_assert(::sqlpp::detail::check_conditionless_join(test::tabHetairas, test::tabMentioner));
+static_assert(!::sqlpp::detail::check_conditionless_join(test::tabHetairas, test::tabHetairas));
+
+int main()
+{
+}
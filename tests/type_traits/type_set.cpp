@@ -0,0 +1,68 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <type_traits>
+
+#include <sqlpp17/type_set.h>
+
+template <typename...>
+struct X;
+
+using sqlpp::type_set;
+using sqlpp::type_set_t;
+
+// construction removes duplicates and keeps the order of first occurrence
+static_assert(type_set<>().empty());
+static_assert(std::is_same_v<type_set_t<int, char, int, long, char>, type_set_t<int, char, long>>);
+static_assert(std::is_same_v<decltype(type_set(1, 'c', 2, 3l)), type_set_t<int, char, long>>);
+static_assert(type_set<int, char, int>().size() == 2);
+
+// union, intersection, difference, and symmetric difference
+constexpr auto a = type_set<int, char, long>();
+constexpr auto b = type_set<long, float, X<>, int>();
+static_assert(std::is_same_v<decltype(a | b), type_set_t<int, char, long, float, X<>>>);
+static_assert(std::is_same_v<decltype(a & b), type_set_t<long, int>>);
+static_assert(std::is_same_v<decltype(a - b), type_set_t<char>>);
+static_assert(std::is_same_v<decltype(b - a), type_set_t<float, X<>>>);
+static_assert((a ^ b) == type_set<char, float, X<>>());
+static_assert((a | type_set<>()) == a);
+static_assert((a & type_set<>()).empty());
+
+// comparison
+static_assert(a == type_set<long, int, char>());
+static_assert(a != b);
+static_assert(a != type_set<int, char>());
+static_assert(type_set<int, char>() <= a);
+static_assert(a >= type_set<char>());
+static_assert(!(a <= b));
+
+// conditional construction
+static_assert(std::is_same_v<decltype(sqlpp::type_set_if<std::is_integral, int, float, char, double>()),
+                             type_set_t<int, char>>);
+
+int main()
+{
+}
@@ -0,0 +1,169 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sqlpp17/metrics.h>
+#include <sqlpp17_test/assert_true.h>
+
+using ::sqlpp::test::assert_true;
+
+int main()
+{
+  using namespace std::chrono_literals;
+
+  // Literals are replaced, identifiers and parameters are kept
+  assert_true(::sqlpp::normalize_sql("SELECT tab.id FROM tab WHERE tab.id = 17 AND tab.name = 'it''s'")
+                      .compare("SELECT tab.id FROM tab WHERE tab.id = ? AND tab.name = ?") == 0,
+              "normalize literals");
+  assert_true(::sqlpp::normalize_sql("SELECT \"col1\", t2.x FROM t2 WHERE t2.x > $1 AND t2.y < 1.5e3")
+                      .compare("SELECT \"col1\", t2.x FROM t2 WHERE t2.x > $1 AND t2.y < ?") == 0,
+              "normalize identifiers and parameters");
+
+  // Backslashes escape the next character only if the connector says so (mysql)
+  assert_true(::sqlpp::normalize_sql(R"(SELECT 'it\'s', 1 FROM t)", ::sqlpp::string_escapes::backslashes)
+                      .compare("SELECT ?, ? FROM t") == 0,
+              "normalize backslash escapes");
+  assert_true(::sqlpp::normalize_sql(R"(SELECT 'a\\', 'b''c' FROM t)", ::sqlpp::string_escapes::backslashes)
+                      .compare("SELECT ?, ? FROM t") == 0,
+              "normalize escaped backslash");
+  assert_true(::sqlpp::normalize_sql(R"(SELECT 'C:\', 2 FROM t)").compare("SELECT ?, ? FROM t") == 0,
+              "normalize literal backslash");
+
+  // Buckets have a relative error below 12.5%
+  for (auto value : {0ull, 7ull, 8ull, 9ull, 15ull, 16ull, 100ull, 1000ull, 123456789ull})
+  {
+    const auto index = ::sqlpp::latency_histogram::bucket_index(value);
+    const auto upper_bound = ::sqlpp::latency_histogram::bucket_upper_bound(index);
+    assert_true(upper_bound >= value and upper_bound - value <= value / 8, "bucket bounds");
+    assert_true(index == 0 or ::sqlpp::latency_histogram::bucket_upper_bound(index - 1) < value, "bucket order");
+  }
+
+  auto histogram = ::sqlpp::latency_histogram{};
+  for (auto i = 1; i <= 100; ++i)
+  {
+    histogram.record(std::chrono::microseconds{i});
+  }
+  const auto h = histogram.snapshot();
+  assert_true(h.count == 100, "histogram count");
+  assert_true(h.max_nanoseconds == 100'000, "histogram max");
+  assert_true(h.mean() == 50'500ns, "histogram mean");
+  assert_true(h.percentile(0.5) >= 50us and h.percentile(0.5) <= 57us, "histogram p50");
+  assert_true(h.percentile(1.0) == 100us, "histogram p100");
+
+  // The instrumentation policy pairs start and end events per statement hash
+  auto registry = ::sqlpp::metrics_registry{4};
+  auto instrumentation = ::sqlpp::metrics_instrumentation{registry};
+  const auto start = ::sqlpp::instrumentation_clock::time_point{};
+  for (auto i = 0; i < 3; ++i)
+  {
+    instrumentation(::sqlpp::execute_start_event{42, "SELECT a FROM t WHERE a = 1", 100ns, start});
+    instrumentation(::sqlpp::execute_end_event{42, {}, start + 2us});
+    instrumentation(::sqlpp::fetch_end_event{42, 5, 3us, start + 5us});
+  }
+  instrumentation(::sqlpp::prepare_start_event{7, "DELETE FROM t", 100ns, start});
+  instrumentation(::sqlpp::error_event{7, "no such table: t", start + 1us});
+
+  auto metrics = registry.snapshot();
+  assert_true(metrics.size() == 2, "statement count");
+  for (const auto& s : metrics)
+  {
+    if (s.statement_hash == 42)
+    {
+      assert_true(s.sql.compare("SELECT a FROM t WHERE a = ?") == 0, "sql");
+      assert_true(s.calls == 3 and s.errors == 0 and s.rows == 15, "counters");
+      assert_true(s.execute.count == 3 and s.execute.max_nanoseconds == 2000, "execute latency");
+      assert_true(s.fetch.count == 3 and s.fetch.max_nanoseconds == 3000, "fetch latency");
+    }
+    else
+    {
+      assert_true(s.statement_hash == 7 and s.calls == 0 and s.errors == 1, "error");
+    }
+  }
+
+  auto os = std::ostringstream{};
+  write_metrics(os, metrics);
+  assert_true(os.str().find("statement 0x0000002a calls=3 errors=0 rows=15") != std::string::npos, "dump");
+
+  // Reset keeps the statements, updates beyond the capacity are dropped
+  registry.reset();
+  metrics = registry.snapshot();
+  assert_true(metrics.size() == 2 and metrics.front().calls + metrics.back().calls == 0, "reset");
+  for (auto hash = 100u; hash < 104u; ++hash)
+  {
+    registry.record_call(hash);
+  }
+  assert_true(registry.snapshot().size() == 4 and registry.dropped() == 2, "dropped");
+
+  // Concurrent updates claim each statement once and lose no counts
+  {
+    constexpr auto thread_count = 8;
+    constexpr auto statement_count = 32u;
+    constexpr auto iterations = 1000;
+    auto shared_registry = ::sqlpp::metrics_registry{64};
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < thread_count; ++t)
+    {
+      threads.emplace_back([&shared_registry, t] {
+        auto shared_instrumentation = ::sqlpp::metrics_instrumentation{shared_registry};
+        const auto time = ::sqlpp::instrumentation_clock::time_point{};
+        for (auto i = 0; i < iterations; ++i)
+        {
+          const auto hash = 1000u + static_cast<unsigned>(i + t) % statement_count;
+          const auto sql = "SELECT a FROM t WHERE a = " + std::to_string(i);
+          shared_instrumentation(::sqlpp::execute_start_event{hash, sql, 100ns, time});
+          shared_instrumentation(::sqlpp::execute_end_event{hash, {}, time + 1us});
+          shared_instrumentation(::sqlpp::fetch_end_event{hash, 2, 1us, time + 2us});
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    const auto shared_metrics = shared_registry.snapshot();
+    assert_true(shared_metrics.size() == statement_count and shared_registry.dropped() == 0, "concurrent statements");
+    auto calls = std::uint64_t{};
+    auto rows = std::uint64_t{};
+    auto executions = std::uint64_t{};
+    for (const auto& s : shared_metrics)
+    {
+      assert_true(s.sql.compare("SELECT a FROM t WHERE a = ?") == 0, "concurrent sql");
+      calls += s.calls;
+      rows += s.rows;
+      executions += s.execute.count;
+    }
+    const auto expected = static_cast<std::uint64_t>(thread_count * iterations);
+    assert_true(calls == expected and executions == expected and rows == 2 * expected, "concurrent counters");
+  }
+}
@@ -0,0 +1,105 @@
+/*
+Copyright (c) 2018, Roland Bock
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this
+   list of conditions and the following disclaimer in the documentation and/or
+   other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <unistd.h>
+
+#include <sqlpp17/reactor.h>
+#include <sqlpp17_test/assert_true.h>
+
+using ::sqlpp::test::assert_true;
+
+namespace
+{
+  class pipe_reader : public ::sqlpp::reactor_watcher
+  {
+    ::sqlpp::reactor_t& _reactor;
+    int _fd;
+
+  public:
+    std::string received;
+
+    pipe_reader(::sqlpp::reactor_t& reactor, int fd) : _reactor{reactor}, _fd{fd}
+    {
+    }
+
+    auto on_ready(std::uint32_t events) -> void override
+    {
+      char buffer[64];
+      const auto size = ::read(_fd, buffer, sizeof(buffer));
+      if (size > 0)
+      {
+        received.append(buffer, static_cast<std::size_t>(size));
+      }
+      if (size == 0 or (events & EPOLLHUP))
+      {
+        _reactor.unwatch(_fd);
+      }
+    }
+  };
+}  // namespace
+
+int main()
+{
+  using namespace std::chrono_literals;
+
+  auto reactor = ::sqlpp::reactor_t{};
+
+  // Nothing happens
+  assert_true(reactor.run_once(0ms) == 0, "idle");
+
+  // Posted functions run on the next iteration, in order
+  auto posted = std::string{};
+  reactor.post([&posted] { posted += "a"; });
+  reactor.post([&posted] { posted += "b"; });
+  assert_true(reactor.run_once(0ms) == 2 and posted.compare("ab") == 0, "posted functions");
+
+  // Watchers are notified while their file descriptor is ready
+  int fds[2];
+  assert_true(::pipe(fds) == 0, "pipe");
+  auto reader = pipe_reader{reactor, fds[0]};
+  reactor.watch(fds[0], ::sqlpp::reactor_t::readable, reader);
+  assert_true(reactor.watched() == 1, "watched");
+  assert_true(reactor.run_once(0ms) == 0, "nothing to read");
+
+  assert_true(::write(fds[1], "hello", 5) == 5, "write");
+  assert_true(reactor.run_once(100ms) == 1 and reader.received.compare("hello") == 0, "read");
+
+  // Closing the writing end makes the reader unwatch itself
+  ::close(fds[1]);
+  assert_true(reactor.run_once(100ms) == 1 and reactor.watched() == 0, "unwatched");
+  ::close(fds[0]);
+
+  // stop() ends run(), also when called by a posted function
+  reactor.post([&reactor] { reactor.stop(); });
+  reactor.run();
+
+  return 0;
+}